@@ -0,0 +1,271 @@
+// Throughput benchmarks of the readers and writers. Every result is printed
+// as one JSON object per line so runs can be diffed between commits, run
+// with `zig build bench -Doptimize=ReleaseFast [-- filter]` where `filter`
+// only runs benchmarks whose name contains it.
+const std = @import("std");
+const builtin = @import("builtin");
+const gci = @import("gci");
+const clib = @cImport({
+    @cInclude("stdio.h");
+});
+
+const data_size = 16 << 20;
+const call_limit = 1 << 20;
+const min_ns = 100 * std.time.ns_per_ms;
+const sizes = [_]usize{ 1, 16, 256, 4096, 65536, 1 << 20 };
+const buffer_sizes = [_]usize{ 4096, 65536, 1 << 20 };
+const file_name = "gci-bench.tmp";
+
+const ReaderKind = enum { string, buffer, double, async, fail, file, fd, mmap };
+const WriterKind = enum { string, buffer, async, file, fd };
+
+const Stat = struct {
+    bytes: u64 = 0,
+    calls: u64 = 0,
+    ns: u64 = 0,
+
+    fn add(self: *Stat, other: Stat) void {
+        self.bytes += other.bytes;
+        self.calls += other.calls;
+        self.ns += other.ns;
+    }
+};
+
+const Env = struct {
+    data: []u8,
+    chunk: []u8,
+    inner: []u8,
+    file: std.fs.File,
+    c_file: [*c]clib.FILE,
+};
+
+pub fn main() !void {
+    const allocator = std.heap.page_allocator;
+
+    const args = try std.process.argsAlloc(allocator);
+    defer std.process.argsFree(allocator, args);
+    const filter: []const u8 = if (args.len > 1) args[1] else "";
+
+    const data = try allocator.alloc(u8, data_size);
+    defer allocator.free(data);
+    for (data, 0..) |*byte, index| {
+        byte.* = @truncate(index *% 31 +% 7);
+    }
+
+    const chunk = try allocator.alloc(u8, sizes[sizes.len - 1]);
+    defer allocator.free(chunk);
+    const inner = try allocator.alloc(u8, buffer_sizes[buffer_sizes.len - 1]);
+    defer allocator.free(inner);
+
+    const file = try std.fs.cwd().createFile(file_name, .{ .read = true });
+    defer {
+        file.close();
+        std.fs.cwd().deleteFile(file_name) catch {};
+    }
+    try file.writeAll(data);
+
+    const c_file = clib.fopen(file_name, "r+b");
+    if (c_file == null) {
+        return error.Io;
+    }
+    defer _ = clib.fclose(c_file);
+
+    var env = Env{ .data = data, .chunk = chunk, .inner = inner, .file = file, .c_file = c_file };
+
+    var stdout = std.io.bufferedWriter(std.io.getStdOut().writer());
+    const out = stdout.writer();
+
+    inline for (std.meta.fields(ReaderKind)) |field| {
+        const kind: ReaderKind = @enumFromInt(field.value);
+        const name = "reader_" ++ field.name;
+        if (std.mem.indexOf(u8, name, filter) != null) {
+            for (sizes) |size| {
+                for (bufferSizes(usesBuffer(kind))) |buffer_size| {
+                    const stat = try measure(readPass, kind, &env, size, buffer_size);
+                    try report(out, name, "read", size, buffer_size, stat);
+                    try stdout.flush();
+                }
+            }
+        }
+    }
+
+    inline for (std.meta.fields(WriterKind)) |field| {
+        const kind: WriterKind = @enumFromInt(field.value);
+        const name = "writer_" ++ field.name;
+        if (std.mem.indexOf(u8, name, filter) != null) {
+            for (sizes) |size| {
+                for (bufferSizes(kind == .buffer or kind == .async)) |buffer_size| {
+                    const stat = try measure(writePass, kind, &env, size, buffer_size);
+                    try report(out, name, "write", size, buffer_size, stat);
+                    try stdout.flush();
+                }
+            }
+        }
+    }
+}
+
+fn usesBuffer(kind: ReaderKind) bool {
+    return switch (kind) {
+        .buffer, .double, .async, .mmap => true,
+        else => false,
+    };
+}
+
+fn bufferSizes(uses_buffer: bool) []const usize {
+    return if (uses_buffer) &buffer_sizes else &.{0};
+}
+
+// Repeats a pass until enough time has passed to give a stable result.
+fn measure(pass: anytype, kind: anytype, env: *Env, size: usize, buffer_size: usize) !Stat {
+    var total = Stat{};
+    while (total.ns < min_ns) {
+        total.add(try pass(kind, env, size, buffer_size));
+    }
+    return total;
+}
+
+fn budget(size: usize) usize {
+    return @min(data_size, size * call_limit);
+}
+
+fn readPass(kind: ReaderKind, env: *Env, size: usize, buffer_size: usize) !Stat {
+    try env.file.seekTo(0);
+    clib.rewind(env.c_file);
+
+    var string = try gci.ReaderString.init(env.data);
+    switch (kind) {
+        .string => {
+            return readLoop(string.interface(), env.chunk[0..size]);
+        },
+        .buffer => {
+            var context = try gci.ReaderBuffer.init(string.interface(), env.inner[0..buffer_size]);
+            return readLoop(context.interface(), env.chunk[0..size]);
+        },
+        .double => {
+            var context = try gci.ReaderBuffer.double(string.interface(), env.inner[0..buffer_size]);
+            return readLoop(context.interface(), env.chunk[0..size]);
+        },
+        .async => {
+            var context: gci.ReaderAsync = undefined;
+            try context.init(string.interface(), env.inner[0..buffer_size]);
+            defer context.deinit();
+            return readLoop(context.interface(), env.chunk[0..size]);
+        },
+        .fail => {
+            var context = try gci.ReaderFail.init(string.interface(), std.math.maxInt(usize));
+            return readLoop(context.interface(), env.chunk[0..size]);
+        },
+        .file => {
+            var context = try gci.ReaderFile.init(@ptrCast(env.c_file));
+            return readLoop(context.interface(), env.chunk[0..size]);
+        },
+        .fd => {
+            var context = try gci.ReaderFd.init(env.file.handle);
+            return readLoop(context.interface(), env.chunk[0..size]);
+        },
+        .mmap => {
+            var context = try gci.ReaderMmap.init(env.file.handle, buffer_size, .sequential);
+            defer context.deinit();
+            return readLoop(context.interface(), env.chunk[0..size]);
+        },
+    }
+}
+
+fn readLoop(reader: gci.InterfaceReader, chunk: []u8) !Stat {
+    const limit = budget(chunk.len);
+    var stat = Stat{};
+
+    var timer = try std.time.Timer.start();
+    while (stat.bytes < limit) {
+        const result = try reader.read(chunk);
+        std.mem.doNotOptimizeAway(result.ptr);
+        stat.bytes += result.len;
+        stat.calls += 1;
+    }
+    stat.ns = timer.read();
+
+    return stat;
+}
+
+fn writePass(kind: WriterKind, env: *Env, size: usize, buffer_size: usize) !Stat {
+    try env.file.seekTo(0);
+    clib.rewind(env.c_file);
+
+    var string = try gci.WriterString.init(env.data);
+    switch (kind) {
+        .string => {
+            return writeLoop(string.interface(), env.chunk[0..size], null);
+        },
+        .buffer => {
+            var context = try gci.WriterBuffer.init(string.interface(), env.inner[0..buffer_size]);
+            return writeLoop(context.interface(), env.chunk[0..size], &context);
+        },
+        .async => {
+            var context: gci.WriterAsync = undefined;
+            try context.init(string.interface(), env.inner[0..buffer_size], 4);
+            defer context.deinit();
+            return writeLoop(context.interface(), env.chunk[0..size], &context);
+        },
+        .file => {
+            var context = try gci.WriterFile.init(@ptrCast(env.c_file));
+            const stat = try writeLoop(context.interface(), env.chunk[0..size], null);
+            _ = clib.fflush(env.c_file);
+            return stat;
+        },
+        .fd => {
+            var context = try gci.WriterFd.init(env.file.handle);
+            return writeLoop(context.interface(), env.chunk[0..size], null);
+        },
+    }
+}
+
+// Buffering writers are flushed inside the measurement so that the time
+// spent writing what is left in their buffers is included.
+fn writeLoop(writer: gci.InterfaceWriter, chunk: []const u8, flushable: anytype) !Stat {
+    const limit = budget(chunk.len);
+    var stat = Stat{};
+
+    var timer = try std.time.Timer.start();
+    while (stat.bytes < limit) {
+        try writer.write(chunk);
+        stat.bytes += chunk.len;
+        stat.calls += 1;
+    }
+    if (@TypeOf(flushable) != @TypeOf(null)) {
+        try flushable.flush();
+    }
+    stat.ns = timer.read();
+
+    return stat;
+}
+
+fn report(
+    out: anytype,
+    name: []const u8,
+    op: []const u8,
+    size: usize,
+    buffer_size: usize,
+    stat: Stat,
+) !void {
+    const ns: f64 = @floatFromInt(@max(stat.ns, 1));
+    const bytes: f64 = @floatFromInt(stat.bytes);
+    const calls: f64 = @floatFromInt(@max(stat.calls, 1));
+
+    try out.print(
+        "{{\"name\":\"{s}\",\"op\":\"{s}\",\"size\":{d},\"buffer_size\":{d}," ++
+            "\"bytes\":{d},\"calls\":{d},\"ns\":{d},\"mb_per_s\":{d:.2},\"ns_per_call\":{d:.2}," ++
+            "\"mode\":\"{s}\"}}\n",
+        .{
+            name,
+            op,
+            size,
+            buffer_size,
+            stat.bytes,
+            stat.calls,
+            stat.ns,
+            bytes / 1e6 / (ns / 1e9),
+            ns / calls,
+            @tagName(builtin.mode),
+        },
+    );
+}
@@ -29,12 +29,46 @@ pub fn build(b: *std.Build) void {
 
     lib.addCSourceFiles(.{
         .root = b.path("src/implementation"),
-        .files = &.{ "reader/reader.c", "writer/writer.c" },
+        .files = &.{
+            "reader/reader.c",
+            "writer/writer.c",
+            "fd/fd.c",
+            "async/async.c",
+            "shared/shared.c",
+            "uring/uring.c",
+            "copy/copy.c",
+            "stats/stats.c",
+            "allocator/allocator.c",
+            "simd/simd.c",
+            "checksum/checksum.c",
+            "compress/compress.c",
+            "cache/cache.c",
+            "format/format.c",
+            "pool/pool.c",
+            "direct/direct.c",
+            "encode/encode.c",
+        },
     });
+    lib.installHeader(b.path("src/interface/gci_interface_allocator.h"), "gci_interface_allocator.h");
+    lib.installHeader(b.path("src/implementation/gci_allocator.h"), "gci_allocator.h");
     lib.installHeader(b.path("src/interface/gci_interface_reader.h"), "gci_interface_reader.h");
     lib.installHeader(b.path("src/implementation/gci_reader.h"), "gci_reader.h");
     lib.installHeader(b.path("src/interface/gci_interface_writer.h"), "gci_interface_writer.h");
     lib.installHeader(b.path("src/implementation/gci_writer.h"), "gci_writer.h");
+    lib.installHeader(b.path("src/implementation/gci_fd.h"), "gci_fd.h");
+    lib.installHeader(b.path("src/implementation/gci_async.h"), "gci_async.h");
+    lib.installHeader(b.path("src/implementation/gci_shared.h"), "gci_shared.h");
+    lib.installHeader(b.path("src/implementation/gci_uring.h"), "gci_uring.h");
+    lib.installHeader(b.path("src/implementation/gci_copy.h"), "gci_copy.h");
+    lib.installHeader(b.path("src/implementation/gci_stats.h"), "gci_stats.h");
+    lib.installHeader(b.path("src/implementation/gci_simd.h"), "gci_simd.h");
+    lib.installHeader(b.path("src/implementation/gci_checksum.h"), "gci_checksum.h");
+    lib.installHeader(b.path("src/implementation/gci_compress.h"), "gci_compress.h");
+    lib.installHeader(b.path("src/implementation/gci_cache.h"), "gci_cache.h");
+    lib.installHeader(b.path("src/implementation/gci_format.h"), "gci_format.h");
+    lib.installHeader(b.path("src/implementation/gci_pool.h"), "gci_pool.h");
+    lib.installHeader(b.path("src/implementation/gci_direct.h"), "gci_direct.h");
+    lib.installHeader(b.path("src/implementation/gci_encode.h"), "gci_encode.h");
     lib.installHeader(b.path("src/gci_common.h"), "gci_common.h");
 
     const lib_unit_tests = b.addTest(.{
@@ -50,4 +84,20 @@ pub fn build(b: *std.Build) void {
 
     const test_step = b.step("test", "Run unit tests");
     test_step.dependOn(&run_lib_unit_tests.step);
+
+    const bench = b.addExecutable(.{
+        .name = "bench",
+        .root_source_file = b.path("bench/bench.zig"),
+        .target = target,
+        .optimize = optimize,
+        .link_libc = true,
+    });
+    bench.root_module.addImport("gci", mod);
+    const run_bench = b.addRunArtifact(bench);
+    if (b.args) |args| {
+        run_bench.addArgs(args);
+    }
+
+    const bench_step = b.step("bench", "Run benchmarks, use with -Doptimize=ReleaseFast");
+    bench_step.dependOn(&run_bench.step);
 }
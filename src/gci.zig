@@ -1,5 +1,27 @@
+const builtin = @import("builtin");
+const allocator = @import("implementation/allocator/allocator.zig");
 const reader = @import("implementation/reader/reader.zig");
 const writer = @import("implementation/writer/writer.zig");
+const fd = if (builtin.os.tag != .windows) @import("implementation/fd/fd.zig") else struct {};
+const async_impl = @import("implementation/async/async.zig");
+const shared = @import("implementation/shared/shared.zig");
+const uring = if (builtin.os.tag == .linux) @import("implementation/uring/uring.zig") else struct {};
+const copy_impl = @import("implementation/copy/copy.zig");
+const stats = @import("implementation/stats/stats.zig");
+const simd = @import("implementation/simd/simd.zig");
+const checksum = @import("implementation/checksum/checksum.zig");
+const compress = @import("implementation/compress/compress.zig");
+const cache = @import("implementation/cache/cache.zig");
+const format = @import("implementation/format/format.zig");
+const chain = @import("implementation/chain/chain.zig");
+const pool = @import("implementation/pool/pool.zig");
+const direct = @import("implementation/direct/direct.zig");
+const encode = @import("implementation/encode/encode.zig");
+
+pub const InterfaceAllocator = allocator.InterfaceAllocator;
+pub const Allocator = allocator.Allocator;
+pub const AllocatorArena = allocator.Arena;
+pub const allocatorLibc = allocator.libc;
 
 pub const InterfaceReader = reader.InterfaceReader;
 pub const Reader = reader.Reader;
@@ -7,13 +29,98 @@ pub const ReaderFile = reader.File;
 pub const ReaderString = reader.String;
 pub const ReaderBuffer = reader.Buffer;
 pub const ReaderFail = reader.Fail;
+pub const ReaderLines = reader.Lines;
+pub const ReaderRange = reader.Range;
+pub const splitRanges = reader.splitRanges;
 
 pub const InterfaceWriter = writer.InterfaceWriter;
 pub const Writer = writer.Writer;
 pub const WriterFile = writer.File;
 pub const WriterString = writer.String;
+pub const WriterGrowable = writer.Growable;
+pub const WriterRope = writer.Rope;
+pub const WriterTee = writer.Tee;
 pub const WriterBuffer = writer.Buffer;
 
+// File descriptors are POSIX only
+pub usingnamespace if (builtin.os.tag != .windows) struct {
+    pub const ReaderFd = fd.Reader;
+    pub const ReaderMmap = fd.Mmap;
+    pub const WriterFd = fd.Writer;
+} else struct {};
+
+pub const ReaderAsync = async_impl.Reader;
+pub const WriterAsync = async_impl.Writer;
+
+pub const WriterShared = shared.Writer;
+pub const WriterSharedBuffer = shared.Buffer;
+
+// io_uring is Linux only
+pub usingnamespace if (builtin.os.tag == .linux) struct {
+    pub const ReaderUring = uring.Reader;
+    pub const WriterUring = uring.Writer;
+} else struct {};
+
+pub const Stats = stats.Stats;
+pub const ReaderStats = stats.Reader;
+pub const WriterStats = stats.Writer;
+
+pub const copy = copy_impl.copy;
+
+pub const Simd = simd.Simd;
+pub const simdSupported = simd.supported;
+pub const findByte = simd.findByte;
+
+pub const crc32c = checksum.crc32c;
+pub const Xxh64 = checksum.Xxh64;
+pub const ReaderChecksum = checksum.Reader;
+pub const WriterChecksum = checksum.Writer;
+
+pub const WriterCompress = compress.Writer;
+pub const WriterCompressParallel = compress.Parallel;
+pub const ReaderDecompress = compress.Reader;
+
+pub const ReaderCached = cache.Cached;
+pub const ReaderCachedCursor = cache.Cursor;
+pub const CacheCounters = cache.Counters;
+
+pub const formatMax = format.max;
+pub const formatU64 = format.formatU64;
+pub const formatI64 = format.formatI64;
+pub const formatHex = format.formatHex;
+pub const formatF64 = format.formatF64;
+pub const writeU64 = format.writeU64;
+pub const writeI64 = format.writeI64;
+pub const writeHex = format.writeHex;
+pub const writeF64 = format.writeF64;
+
+pub const ChainSource = chain.Source;
+pub const ChainSink = chain.Sink;
+pub const ChainReaderBuffer = chain.ReaderBuffer;
+pub const ChainWriterBuffer = chain.WriterBuffer;
+pub const BufferedReader = chain.BufferedReader;
+pub const BufferedWriter = chain.BufferedWriter;
+
+pub const Pool = pool.Pool;
+pub const PoolPages = pool.Pages;
+pub const ReaderPooled = pool.Reader;
+pub const WriterPooled = pool.Writer;
+
+pub const WriterDirect = direct.Writer;
+
+pub const Encoding = encode.Encoding;
+pub const base64EncodedSize = encode.base64EncodedSize;
+pub const base64Encode = encode.base64Encode;
+pub const base64Decode = encode.base64Decode;
+pub const hexEncode = encode.hexEncode;
+pub const hexDecode = encode.hexDecode;
+pub const Utf8Prefix = encode.Utf8Prefix;
+pub const utf8Validate = encode.utf8Validate;
+pub const isUtf8 = encode.isUtf8;
+pub const WriterEncode = encode.Writer;
+pub const ReaderDecode = encode.Reader;
+pub const ReaderUtf8 = encode.ReaderUtf8;
+
 test {
     @import("std").testing.refAllDecls(@This());
 }
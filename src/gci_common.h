@@ -5,6 +5,7 @@ enum GciError {
     GCI_ERROR_OK        = 0,
     GCI_ERROR_NULL      = 1,
     GCI_ERROR_BUFFER    = 2,
+    GCI_ERROR_IO        = 3,
 };
 
 #endif
@@ -0,0 +1,109 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <gci_allocator.h>
+
+void *gci_allocator_libc_alloc(void const *context, size_t size);
+void *gci_allocator_libc_resize(void const *context, void *memory, size_t old_size, size_t new_size);
+void gci_allocator_libc_free(void const *context, void *memory, size_t size);
+void *gci_allocator_arena_alloc(void const *context, size_t size);
+void *gci_allocator_arena_resize(void const *context, void *memory, size_t old_size, size_t new_size);
+void gci_allocator_arena_free(void const *context, void *memory, size_t size);
+
+struct GciInterfaceAllocator gci_allocator_libc_interface(void) {
+    return (struct GciInterfaceAllocator) {
+        .context = NULL,
+        .alloc = gci_allocator_libc_alloc,
+        .resize = gci_allocator_libc_resize,
+        .free = gci_allocator_libc_free,
+    };
+}
+
+void *gci_allocator_libc_alloc(void const *context, size_t size) {
+    (void) context;
+    return malloc(size > 0 ? size : 1);
+}
+
+void *gci_allocator_libc_resize(void const *context, void *memory, size_t old_size, size_t new_size) {
+    (void) context;
+    (void) old_size;
+    return realloc(memory, new_size > 0 ? new_size : 1);
+}
+
+void gci_allocator_libc_free(void const *context, void *memory, size_t size) {
+    (void) context;
+    (void) size;
+    free(memory);
+}
+
+enum GciError gci_allocator_arena_init(struct GciAllocatorArena *context, char *buffer, size_t buffer_size) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    context->buffer = buffer;
+    if (buffer == NULL) { return GCI_ERROR_NULL; }
+
+    context->buffer_size = buffer_size;
+    context->current = 0;
+    context->last = 0;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceAllocator gci_allocator_arena_interface(struct GciAllocatorArena *context) {
+    return (struct GciInterfaceAllocator) {
+        .context = context,
+        .alloc = gci_allocator_arena_alloc,
+        .resize = gci_allocator_arena_resize,
+        .free = gci_allocator_arena_free,
+    };
+}
+
+void gci_allocator_arena_reset(struct GciAllocatorArena *context) {
+    assert(context != NULL);
+    context->current = 0;
+    context->last = 0;
+}
+
+void *gci_allocator_arena_alloc(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciAllocatorArena *context = (struct GciAllocatorArena*) void_context;
+    assert(context->current <= context->buffer_size);
+
+    uintptr_t address = (uintptr_t) (context->buffer + context->current);
+    size_t padding = (size_t) (-address & (GCI_ALLOCATOR_ALIGNMENT - 1));
+
+    size_t left = context->buffer_size - context->current;
+    if (padding > left || size > left - padding) { return NULL; }
+
+    context->last = context->current + padding;
+    context->current = context->last + size;
+    return context->buffer + context->last;
+}
+
+void *gci_allocator_arena_resize(void const *void_context, void *memory, size_t old_size, size_t new_size) {
+    assert(void_context != NULL);
+    struct GciAllocatorArena *context = (struct GciAllocatorArena*) void_context;
+    assert(memory != NULL);
+
+    char *last = context->buffer + context->last;
+    if (memory == last) {
+        if (new_size > context->buffer_size - context->last) { return NULL; }
+        context->current = context->last + new_size;
+        return memory;
+    }
+
+    if (new_size <= old_size) { return memory; }
+
+    char *new_memory = gci_allocator_arena_alloc(context, new_size);
+    if (new_memory == NULL) { return NULL; }
+    memcpy(new_memory, memory, old_size);
+    return new_memory;
+}
+
+void gci_allocator_arena_free(void const *void_context, void *memory, size_t size) {
+    assert(void_context != NULL);
+    struct GciAllocatorArena *context = (struct GciAllocatorArena*) void_context;
+    (void) size;
+
+    if ((char*) memory == context->buffer + context->last) {
+        context->current = context->last;
+    }
+}
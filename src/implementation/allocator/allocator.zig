@@ -0,0 +1,153 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+
+const alignment: u29 = lib.GCI_ALLOCATOR_ALIGNMENT;
+
+pub const InterfaceAllocator = struct {
+    allocator: lib.GciInterfaceAllocator,
+
+    pub fn alloc(allocator: InterfaceAllocator, size: usize) ![]u8 {
+        const memory = lib.gci_allocator_alloc(allocator.allocator, size);
+        if (memory == null) {
+            return error.OutOfMemory;
+        }
+        return @as([*]u8, @ptrCast(memory.?))[0..size];
+    }
+
+    pub fn free(allocator: InterfaceAllocator, memory: []u8) void {
+        lib.gci_allocator_free(allocator.allocator, memory.ptr, memory.len);
+    }
+};
+
+// Exposes a zig allocator as an allocator interface.
+pub const Allocator = struct {
+    allocator: std.mem.Allocator,
+
+    pub fn init(allocator: std.mem.Allocator) Allocator {
+        return .{ .allocator = allocator };
+    }
+
+    pub fn interface(self: *Allocator) InterfaceAllocator {
+        const allocator = lib.GciInterfaceAllocator{
+            .context = self,
+            .alloc = allocCallback,
+            .resize = resizeCallback,
+            .free = freeCallback,
+        };
+        return .{ .allocator = allocator };
+    }
+
+    fn slice(memory: ?*anyopaque, size: usize) []align(alignment) u8 {
+        const ptr: [*]align(alignment) u8 = @alignCast(@ptrCast(memory.?));
+        return ptr[0..@max(size, 1)];
+    }
+
+    fn allocCallback(context: ?*const anyopaque, size: usize) callconv(.C) ?*anyopaque {
+        std.debug.assert(null != context);
+        const self: *const Allocator = @alignCast(@ptrCast(context));
+
+        const memory = self.allocator.alignedAlloc(u8, alignment, @max(size, 1)) catch return null;
+        return memory.ptr;
+    }
+
+    fn resizeCallback(context: ?*const anyopaque, memory: ?*anyopaque, old_size: usize, new_size: usize) callconv(.C) ?*anyopaque {
+        std.debug.assert(null != context);
+        std.debug.assert(null != memory);
+        const self: *const Allocator = @alignCast(@ptrCast(context));
+
+        const old_memory = slice(memory, old_size);
+        if (self.allocator.resize(old_memory, @max(new_size, 1))) {
+            return memory;
+        }
+
+        const new_memory = self.allocator.alignedAlloc(u8, alignment, @max(new_size, 1)) catch return null;
+        const length = @min(old_size, new_size);
+        @memcpy(new_memory[0..length], old_memory[0..length]);
+        self.allocator.free(old_memory);
+        return new_memory.ptr;
+    }
+
+    fn freeCallback(context: ?*const anyopaque, memory: ?*anyopaque, size: usize) callconv(.C) void {
+        std.debug.assert(null != context);
+        std.debug.assert(null != memory);
+        const self: *const Allocator = @alignCast(@ptrCast(context));
+        self.allocator.free(slice(memory, size));
+    }
+};
+
+pub fn libc() InterfaceAllocator {
+    return .{ .allocator = lib.gci_allocator_libc_interface() };
+}
+
+pub const Arena = struct {
+    inner: lib.GciAllocatorArena,
+
+    pub fn init(buffer: []u8) !Arena {
+        var self: Arena = undefined;
+        const err = lib.gci_allocator_arena_init(&self.inner, buffer.ptr, buffer.len);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Arena) InterfaceAllocator {
+        return .{ .allocator = lib.gci_allocator_arena_interface(&self.inner) };
+    }
+
+    pub fn reset(self: *Arena) void {
+        lib.gci_allocator_arena_reset(&self.inner);
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_allocator.zig");
+}
+
+test "zig allocator" {
+    var context = Allocator.init(testing.allocator);
+    const allocator = context.interface();
+
+    const memory = try allocator.alloc(3);
+    defer allocator.free(memory);
+    try testing.expectEqual(0, @intFromPtr(memory.ptr) % alignment);
+}
+
+test "zig allocator resize" {
+    var context = Allocator.init(testing.allocator);
+    const allocator = context.interface();
+
+    const memory = try allocator.alloc(3);
+    @memcpy(memory, "123");
+
+    const resized = lib.gci_allocator_resize(allocator.allocator, memory.ptr, 3, 100);
+    try testing.expect(resized != null);
+    const new_memory = @as([*]u8, @ptrCast(resized.?))[0..100];
+    defer allocator.free(new_memory);
+    try testing.expectEqualStrings("123", new_memory[0..3]);
+}
+
+test "libc allocator" {
+    const allocator = libc();
+    const memory = try allocator.alloc(3);
+    allocator.free(memory);
+}
+
+test "arena" {
+    var buffer: [64]u8 align(alignment) = undefined;
+    var context = try Arena.init(&buffer);
+    const allocator = context.interface();
+
+    const memory1 = try allocator.alloc(3);
+    try testing.expectEqual(@as([*]u8, &buffer), memory1.ptr);
+
+    const memory2 = try allocator.alloc(3);
+    try testing.expectEqual(@as([*]u8, buffer[alignment..].ptr), memory2.ptr);
+
+    try testing.expectError(error.OutOfMemory, allocator.alloc(64));
+
+    context.reset();
+    const memory3 = try allocator.alloc(64);
+    try testing.expectEqual(@as([*]u8, &buffer), memory3.ptr);
+}
@@ -0,0 +1,90 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+const alignment: usize = lib.GCI_ALLOCATOR_ALIGNMENT;
+
+test "libc alloc" {
+    const allocator = lib.gci_allocator_libc_interface();
+
+    const memory = lib.gci_allocator_alloc(allocator, 3);
+    try testing.expect(memory != null);
+    @as([*]u8, @ptrCast(memory.?))[0] = 1;
+
+    const resized = lib.gci_allocator_resize(allocator, memory, 3, 4096);
+    try testing.expect(resized != null);
+    try testing.expectEqual(1, @as([*]u8, @ptrCast(resized.?))[0]);
+
+    lib.gci_allocator_free(allocator, resized, 4096);
+}
+
+test "arena init null" {
+    var buffer: [8]u8 = undefined;
+    const init_err1 = lib.gci_allocator_arena_init(null, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err1);
+
+    var context: lib.GciAllocatorArena = undefined;
+    const init_err2 = lib.gci_allocator_arena_init(&context, null, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err2);
+}
+
+test "arena alloc" {
+    var buffer: [48]u8 align(alignment) = undefined;
+    var context: lib.GciAllocatorArena = undefined;
+    const init_err = lib.gci_allocator_arena_init(&context, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const allocator = lib.gci_allocator_arena_interface(&context);
+
+    const memory1 = lib.gci_allocator_alloc(allocator, 1);
+    try testing.expectEqual(@intFromPtr(&buffer), @intFromPtr(memory1.?));
+
+    // Allocations are aligned
+    const memory2 = lib.gci_allocator_alloc(allocator, 1);
+    try testing.expectEqual(@intFromPtr(&buffer) + alignment, @intFromPtr(memory2.?));
+
+    const memory3 = lib.gci_allocator_alloc(allocator, 17);
+    try testing.expect(memory3 == null);
+
+    lib.gci_allocator_arena_reset(&context);
+    const memory4 = lib.gci_allocator_alloc(allocator, 48);
+    try testing.expectEqual(@intFromPtr(&buffer), @intFromPtr(memory4.?));
+}
+
+test "arena unaligned buffer" {
+    var buffer: [48]u8 align(alignment) = undefined;
+    var context: lib.GciAllocatorArena = undefined;
+    const init_err = lib.gci_allocator_arena_init(&context, buffer[1..].ptr, buffer.len - 1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const allocator = lib.gci_allocator_arena_interface(&context);
+
+    const memory = lib.gci_allocator_alloc(allocator, 32);
+    try testing.expectEqual(@intFromPtr(&buffer) + alignment, @intFromPtr(memory.?));
+}
+
+test "arena resize last" {
+    var buffer: [48]u8 align(alignment) = undefined;
+    var context: lib.GciAllocatorArena = undefined;
+    const init_err = lib.gci_allocator_arena_init(&context, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const allocator = lib.gci_allocator_arena_interface(&context);
+
+    const memory1 = lib.gci_allocator_alloc(allocator, 1);
+    const memory2 = lib.gci_allocator_alloc(allocator, 1);
+
+    // The last allocation grows in place
+    const resized1 = lib.gci_allocator_resize(allocator, memory2, 1, 32);
+    try testing.expectEqual(memory2, resized1);
+
+    const resized2 = lib.gci_allocator_resize(allocator, memory2, 32, 33);
+    try testing.expect(resized2 == null);
+
+    // Other allocations are copied
+    @as([*]u8, @ptrCast(memory1.?))[0] = 7;
+    lib.gci_allocator_free(allocator, memory2, 32);
+    const resized3 = lib.gci_allocator_resize(allocator, memory1, 1, 2);
+    try testing.expectEqual(@intFromPtr(memory2.?), @intFromPtr(resized3.?));
+    try testing.expectEqual(7, @as([*]u8, @ptrCast(resized3.?))[0]);
+}
@@ -0,0 +1,362 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <errno.h>
+#include <string.h>
+#include <gci_async.h>
+
+size_t gci_reader_async_read(void const *context, char *buffer, size_t buffer_size);
+bool gci_reader_async_eof(void const *context);
+size_t gci_reader_async_peek(void const *context, char const **data);
+void gci_reader_async_consume(void const *context, size_t amount);
+void *gci_reader_async_run(void *context);
+bool gci_reader_async_swap(struct GciReaderAsync *context);
+size_t gci_writer_async_write(void const *void_context, char const *data, size_t data_size);
+void *gci_writer_async_run(void *void_context);
+void gci_writer_async_publish(struct GciWriterAsync *context);
+void gci_writer_async_wait(sem_t *semaphore);
+
+enum GciError gci_reader_async_init(
+    struct GciReaderAsync *context,
+    struct GciInterfaceReader reader,
+    char *buffer,
+    size_t buffer_size
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (buffer == NULL) { return GCI_ERROR_NULL; }
+
+    size_t half_size = buffer_size / 2;
+    if (half_size <= 1 || buffer_size % 2 != 0) { return GCI_ERROR_BUFFER; }
+
+    context->reader = reader;
+    context->buffer = buffer;
+    context->next_read = buffer + half_size;
+    context->buffer_size = half_size;
+    context->current = 0;
+    context->length_read = 0;
+    context->fill_length = 0;
+    context->fill_requested = true;
+    context->fill_done = false;
+    context->fill_eof = false;
+    context->stop = false;
+    context->eof = false;
+
+    if (pthread_mutex_init(&context->lock, NULL) != 0) {
+        return GCI_ERROR_IO;
+    }
+    if (pthread_cond_init(&context->signal, NULL) != 0) {
+        pthread_mutex_destroy(&context->lock);
+        return GCI_ERROR_IO;
+    }
+    if (pthread_create(&context->thread, NULL, gci_reader_async_run, context) != 0) {
+        pthread_cond_destroy(&context->signal);
+        pthread_mutex_destroy(&context->lock);
+        return GCI_ERROR_IO;
+    }
+
+    return GCI_ERROR_OK;
+}
+
+void gci_reader_async_deinit(struct GciReaderAsync *context) {
+    assert(context != NULL);
+
+    pthread_mutex_lock(&context->lock);
+    context->stop = true;
+    pthread_cond_broadcast(&context->signal);
+    pthread_mutex_unlock(&context->lock);
+
+    pthread_join(context->thread, NULL);
+    pthread_cond_destroy(&context->signal);
+    pthread_mutex_destroy(&context->lock);
+}
+
+struct GciInterfaceReader gci_reader_async_interface(struct GciReaderAsync *context) {
+    return (struct GciInterfaceReader) {
+        .context = context,
+        .read = gci_reader_async_read,
+        .eof = gci_reader_async_eof,
+        .peek = gci_reader_async_peek,
+        .consume = gci_reader_async_consume,
+    };
+}
+
+// Background thread, fills `next_read` whenever a fill is requested.
+void *gci_reader_async_run(void *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderAsync *context = (struct GciReaderAsync*) void_context;
+
+    pthread_mutex_lock(&context->lock);
+    while (true) {
+        while (!context->fill_requested && !context->stop) {
+            pthread_cond_wait(&context->signal, &context->lock);
+        }
+        if (context->stop) { break; }
+
+        char *buffer = context->next_read;
+        size_t buffer_size = context->buffer_size;
+        pthread_mutex_unlock(&context->lock);
+
+        size_t length = gci_reader_read(context->reader, buffer, buffer_size);
+        bool eof = gci_reader_eof(context->reader);
+
+        pthread_mutex_lock(&context->lock);
+        context->fill_length = length;
+        context->fill_eof = eof;
+        context->fill_requested = false;
+        context->fill_done = true;
+        pthread_cond_broadcast(&context->signal);
+    }
+    pthread_mutex_unlock(&context->lock);
+
+    return NULL;
+}
+
+// Waits for the background fill and makes it the active half, then requests
+// the next fill. Returns false on eof or if the internal reader failed, a
+// failed fill is retried on the next call.
+bool gci_reader_async_swap(struct GciReaderAsync *context) {
+    assert(context != NULL);
+    assert(context->current >= context->length_read);
+
+    if (context->eof) {
+        return false;
+    }
+
+    pthread_mutex_lock(&context->lock);
+    if (!context->fill_requested && !context->fill_done) {
+        context->fill_requested = true;
+        pthread_cond_broadcast(&context->signal);
+    }
+    while (!context->fill_done) {
+        pthread_cond_wait(&context->signal, &context->lock);
+    }
+
+    size_t length = context->fill_length;
+    bool eof = context->fill_eof;
+    context->fill_done = false;
+
+    if (length > 0) {
+        char *temp = context->buffer;
+        context->buffer = context->next_read;
+        context->next_read = temp;
+
+        context->length_read = length;
+        context->current = 0;
+
+        if (!eof) {
+            context->fill_requested = true;
+            pthread_cond_broadcast(&context->signal);
+        }
+    }
+    pthread_mutex_unlock(&context->lock);
+
+    if (length == 0 && eof) {
+        context->eof = true;
+    }
+    return length > 0;
+}
+
+size_t gci_reader_async_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    struct GciReaderAsync *context = (struct GciReaderAsync*) void_context;
+
+    assert(buffer != NULL);
+    size_t read_length = 0;
+    while (read_length < buffer_size) {
+        if (context->current >= context->length_read) {
+            if (!gci_reader_async_swap(context)) { break; }
+        }
+
+        size_t length = context->length_read - context->current;
+        length = length > buffer_size - read_length ? buffer_size - read_length : length;
+
+        memcpy(buffer + read_length, context->buffer + context->current, length);
+        context->current += length;
+        read_length += length;
+    }
+
+    assert(read_length <= buffer_size);
+    return read_length;
+}
+
+bool gci_reader_async_eof(void const *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderAsync *context = (struct GciReaderAsync*) void_context;
+    return context->eof;
+}
+
+size_t gci_reader_async_peek(void const *void_context, char const **data) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciReaderAsync *context = (struct GciReaderAsync*) void_context;
+
+    if (context->current >= context->length_read) {
+        if (!gci_reader_async_swap(context)) { return 0; }
+    }
+
+    *data = context->buffer + context->current;
+    return context->length_read - context->current;
+}
+
+void gci_reader_async_consume(void const *void_context, size_t amount) {
+    assert(void_context != NULL);
+    struct GciReaderAsync *context = (struct GciReaderAsync*) void_context;
+
+    assert(context->current <= context->length_read);
+    assert(amount <= context->length_read - context->current);
+    context->current += amount;
+}
+
+enum GciError gci_writer_async_init(
+    struct GciWriterAsync *context,
+    struct GciInterfaceWriter writer,
+    char *buffer,
+    size_t buffer_size,
+    size_t slot_count
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    context->buffer = buffer;
+    if (buffer == NULL) { return GCI_ERROR_NULL; }
+    if (slot_count < 2 || slot_count > GCI_WRITER_ASYNC_SLOTS_MAX) { return GCI_ERROR_BUFFER; }
+    if (buffer_size < slot_count || buffer_size % slot_count != 0) { return GCI_ERROR_BUFFER; }
+
+    context->writer = writer;
+    context->slot_size = buffer_size / slot_count;
+    context->slot_count = slot_count;
+    context->producer_slot = 0;
+    context->consumer_slot = 0;
+    context->current = 0;
+    context->holding = false;
+    context->closing = false;
+    context->error = false;
+
+    if (sem_init(&context->filled, 0, 0) != 0) {
+        return GCI_ERROR_IO;
+    }
+    if (sem_init(&context->free, 0, (unsigned int) slot_count) != 0) {
+        sem_destroy(&context->filled);
+        return GCI_ERROR_IO;
+    }
+    if (pthread_create(&context->thread, NULL, gci_writer_async_run, context) != 0) {
+        sem_destroy(&context->free);
+        sem_destroy(&context->filled);
+        return GCI_ERROR_IO;
+    }
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceWriter gci_writer_async_interface(struct GciWriterAsync *context) {
+    return (struct GciInterfaceWriter) { .context = context, .write = gci_writer_async_write };
+}
+
+void gci_writer_async_wait(sem_t *semaphore) {
+    while (sem_wait(semaphore) != 0) {
+        assert(errno == EINTR);
+    }
+}
+
+// Background thread, writes filled slots in order until closed.
+void *gci_writer_async_run(void *void_context) {
+    assert(void_context != NULL);
+    struct GciWriterAsync *context = (struct GciWriterAsync*) void_context;
+
+    while (true) {
+        gci_writer_async_wait(&context->filled);
+        if (__atomic_load_n(&context->closing, __ATOMIC_ACQUIRE)) { break; }
+
+        char *slot = context->buffer + context->consumer_slot * context->slot_size;
+        size_t length = context->lengths[context->consumer_slot];
+
+        if (!__atomic_load_n(&context->error, __ATOMIC_ACQUIRE)) {
+            size_t result = gci_writer_write(context->writer, slot, length);
+            if (result != length) {
+                __atomic_store_n(&context->error, true, __ATOMIC_RELEASE);
+            }
+        }
+
+        context->consumer_slot = (context->consumer_slot + 1) % context->slot_count;
+        sem_post(&context->free);
+    }
+
+    return NULL;
+}
+
+void gci_writer_async_publish(struct GciWriterAsync *context) {
+    assert(context != NULL);
+    assert(context->holding);
+
+    context->lengths[context->producer_slot] = context->current;
+    context->producer_slot = (context->producer_slot + 1) % context->slot_count;
+    context->current = 0;
+    context->holding = false;
+    sem_post(&context->filled);
+}
+
+size_t gci_writer_async_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciWriterAsync *context = (struct GciWriterAsync*) void_context;
+
+    if (__atomic_load_n(&context->error, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+
+    size_t write_length = 0;
+    while (write_length < data_size) {
+        if (!context->holding) {
+            gci_writer_async_wait(&context->free);
+            context->holding = true;
+            context->current = 0;
+        }
+
+        char *slot = context->buffer + context->producer_slot * context->slot_size;
+        size_t length = context->slot_size - context->current;
+        length = length > data_size - write_length ? data_size - write_length : length;
+
+        memcpy(slot + context->current, data + write_length, length);
+        context->current += length;
+        write_length += length;
+
+        if (context->current >= context->slot_size) {
+            gci_writer_async_publish(context);
+        }
+    }
+
+    return write_length;
+}
+
+bool gci_writer_async_flush(struct GciWriterAsync *context) {
+    assert(context != NULL);
+
+    if (context->holding && context->current > 0) {
+        gci_writer_async_publish(context);
+    } else if (context->holding) {
+        context->holding = false;
+        sem_post(&context->free);
+    }
+
+    // Every slot is free once the background thread has caught up
+    for (size_t i = 0; i < context->slot_count; i++) {
+        gci_writer_async_wait(&context->free);
+    }
+    for (size_t i = 0; i < context->slot_count; i++) {
+        sem_post(&context->free);
+    }
+
+    return !__atomic_load_n(&context->error, __ATOMIC_ACQUIRE);
+}
+
+bool gci_writer_async_deinit(struct GciWriterAsync *context) {
+    assert(context != NULL);
+
+    bool result = gci_writer_async_flush(context);
+
+    __atomic_store_n(&context->closing, true, __ATOMIC_RELEASE);
+    sem_post(&context->filled);
+    pthread_join(context->thread, NULL);
+
+    sem_destroy(&context->free);
+    sem_destroy(&context->filled);
+    return result;
+}
@@ -0,0 +1,142 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const reader = @import("../reader/reader.zig");
+const writer = @import("../writer/writer.zig");
+const InterfaceReader = reader.InterfaceReader;
+const InterfaceWriter = writer.InterfaceWriter;
+
+pub const Reader = struct {
+    inner: lib.GciReaderAsync,
+
+    // Starts a background thread which refers to `self`, so unlike the other
+    // readers it is initialized in place and must not move until `deinit`.
+    pub fn init(self: *Reader, r: InterfaceReader, buffer: []u8) !void {
+        const err = lib.gci_reader_async_init(
+            &self.inner,
+            r.reader,
+            buffer.ptr,
+            buffer.len,
+        );
+        try internal.enumToError(err);
+    }
+
+    pub fn deinit(self: *Reader) void {
+        lib.gci_reader_async_deinit(&self.inner);
+    }
+
+    pub fn interface(self: *Reader) InterfaceReader {
+        return .{ .reader = lib.gci_reader_async_interface(&self.inner) };
+    }
+};
+
+pub const Writer = struct {
+    inner: lib.GciWriterAsync,
+
+    // Starts a background thread which refers to `self`, so unlike the other
+    // writers it is initialized in place and must not move until `deinit`.
+    pub fn init(self: *Writer, w: InterfaceWriter, buffer: []u8, slot_count: usize) !void {
+        const err = lib.gci_writer_async_init(
+            &self.inner,
+            w.writer,
+            buffer.ptr,
+            buffer.len,
+            slot_count,
+        );
+        try internal.enumToError(err);
+    }
+
+    // Any failure to write is reported by `flush`, call it before `deinit`
+    // to observe errors.
+    pub fn deinit(self: *Writer) void {
+        _ = lib.gci_writer_async_deinit(&self.inner);
+    }
+
+    pub fn interface(self: *Writer) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_async_interface(&self.inner) };
+    }
+
+    pub fn flush(self: *Writer) !void {
+        const result = lib.gci_writer_async_flush(&self.inner);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_async.zig");
+}
+
+test "reader init odd" {
+    var c = try reader.String.init("");
+
+    var buffer: [5]u8 = undefined;
+    var context: Reader = undefined;
+    const err = context.init(c.interface(), &buffer);
+    try testing.expectError(error.Buffer, err);
+}
+
+test "reader read" {
+    var c = try reader.String.init("data");
+
+    var buffer: [4]u8 = undefined;
+    var context: Reader = undefined;
+    try context.init(c.interface(), &buffer);
+    defer context.deinit();
+    const r = context.interface();
+    try testing.expect(!r.eof());
+
+    var result_buffer: [5]u8 = undefined;
+    const result = try r.read(&result_buffer);
+    try testing.expectEqualStrings("data", result);
+    try testing.expect(r.eof());
+}
+
+test "writer init slots" {
+    var b: [4]u8 = undefined;
+    var c = try writer.String.init(&b);
+
+    var buffer: [5]u8 = undefined;
+    var context: Writer = undefined;
+    const err = context.init(c.interface(), &buffer, 2);
+    try testing.expectError(error.Buffer, err);
+}
+
+test "writer write" {
+    var b: [5]u8 = undefined;
+    var c = try writer.String.init(&b);
+
+    var buffer: [4]u8 = undefined;
+    var context: Writer = undefined;
+    try context.init(c.interface(), &buffer, 2);
+    defer context.deinit();
+    const w = context.interface();
+
+    try w.write("123");
+    try w.write("45");
+
+    try context.flush();
+    try testing.expectEqualStrings("12345", &b);
+}
+
+test "writer write fail" {
+    var b: [1]u8 = undefined;
+    var c = try writer.String.init(&b);
+
+    var buffer: [4]u8 = undefined;
+    var context: Writer = undefined;
+    try context.init(c.interface(), &buffer, 2);
+    defer context.deinit();
+    const w = context.interface();
+
+    try w.write("12");
+
+    const err1 = context.flush();
+    try testing.expectError(error.Writer, err1);
+
+    const err2 = w.write("3");
+    try testing.expectError(error.Writer, err2);
+}
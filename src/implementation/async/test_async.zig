@@ -0,0 +1,238 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "reader init" {
+    const data = "";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciReaderAsync = undefined;
+    const init_err = lib.gci_reader_async_init(
+        &context,
+        lib.gci_reader_string_interface(&c),
+        &buffer,
+        buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_reader_async_deinit(&context);
+    _ = lib.gci_reader_async_interface(&context);
+}
+
+test "reader init small" {
+    const data = "";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [2]u8 = undefined;
+    var context: lib.GciReaderAsync = undefined;
+    const init_err = lib.gci_reader_async_init(
+        &context,
+        lib.gci_reader_string_interface(&c),
+        &buffer,
+        buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err);
+}
+
+test "reader read" {
+    const data = "12345";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciReaderAsync = undefined;
+    const init_err = lib.gci_reader_async_init(
+        &context,
+        lib.gci_reader_string_interface(&c),
+        &buffer,
+        buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_reader_async_deinit(&context);
+
+    const reader = lib.gci_reader_async_interface(&context);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    var buffer1: [3]u8 = undefined;
+    const length1 = lib.gci_reader_read(reader, &buffer1, buffer1.len);
+    try testing.expectEqual(3, length1);
+    try testing.expectEqualStrings("123", &buffer1);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    var view: [*c]const u8 = undefined;
+    const length2 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(1, length2);
+    try testing.expectEqualStrings("4", view[0..1]);
+    lib.gci_reader_consume(reader, length2, 1);
+
+    const length3 = lib.gci_reader_read(reader, &buffer1, buffer1.len);
+    try testing.expectEqual(1, length3);
+    try testing.expectEqualStrings("5", buffer1[0..1]);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "reader clear error" {
+    const data = "122";
+    var c1: lib.GciReaderString = undefined;
+    const i1_err = lib.gci_reader_string_init(&c1, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i1_err);
+
+    var c2: lib.GciReaderFail = undefined;
+    const i2_err = lib.gci_reader_fail_init(&c2, lib.gci_reader_string_interface(&c1), 1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i2_err);
+
+    var b: [4]u8 = undefined;
+    var context: lib.GciReaderAsync = undefined;
+    const init_err = lib.gci_reader_async_init(&context, lib.gci_reader_fail_interface(&c2), &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_reader_async_deinit(&context);
+
+    const reader = lib.gci_reader_async_interface(&context);
+
+    var buffer1: [1]u8 = undefined;
+    const length1 = lib.gci_reader_read(reader, &buffer1, buffer1.len);
+    try testing.expectEqual(1, length1);
+    try testing.expectEqualStrings("1", &buffer1);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    // The read ahead failed in the background, only the buffered byte is returned
+    var buffer2: [2]u8 = undefined;
+    const length2 = lib.gci_reader_read(reader, &buffer2, buffer2.len);
+    try testing.expectEqual(1, length2);
+    try testing.expectEqualStrings("2", buffer2[0..1]);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    // The background thread is idle after a failed fill
+    c2.amount_of_reads = 0; // Clear error
+
+    const length3 = lib.gci_reader_read(reader, &buffer2, buffer2.len);
+    try testing.expectEqual(1, length3);
+    try testing.expectEqualStrings("2", buffer2[0..1]);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "writer init" {
+    var c: lib.GciWriterString = undefined;
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciWriterAsync = undefined;
+    const init_err = lib.gci_writer_async_init(
+        &context,
+        lib.gci_writer_string_interface(&c),
+        &buffer,
+        buffer.len,
+        2,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer _ = lib.gci_writer_async_deinit(&context);
+
+    _ = lib.gci_writer_async_interface(&context);
+}
+
+test "writer init null" {
+    var c: lib.GciWriterString = undefined;
+    var context: lib.GciWriterAsync = undefined;
+    const init_err = lib.gci_writer_async_init(
+        &context,
+        lib.gci_writer_string_interface(&c),
+        null,
+        4,
+        2,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "writer init slots" {
+    var c: lib.GciWriterString = undefined;
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciWriterAsync = undefined;
+
+    const init_err1 = lib.gci_writer_async_init(
+        &context,
+        lib.gci_writer_string_interface(&c),
+        &buffer,
+        buffer.len,
+        1,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err1);
+
+    const init_err2 = lib.gci_writer_async_init(
+        &context,
+        lib.gci_writer_string_interface(&c),
+        &buffer,
+        buffer.len,
+        3,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err2);
+}
+
+test "writer write" {
+    var b: [5]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciWriterAsync = undefined;
+    const init_err = lib.gci_writer_async_init(
+        &context,
+        lib.gci_writer_string_interface(&c),
+        &buffer,
+        buffer.len,
+        2,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_async_interface(&context);
+
+    const res1 = lib.gci_writer_write(writer, "123", 3);
+    try testing.expectEqual(3, res1);
+
+    const res2 = lib.gci_writer_write(writer, "45", 2);
+    try testing.expectEqual(2, res2);
+
+    const flush_res = lib.gci_writer_async_flush(&context);
+    try testing.expect(flush_res);
+    try testing.expectEqual(5, c.current);
+    try testing.expectEqualStrings("12345", &b);
+
+    const deinit_res = lib.gci_writer_async_deinit(&context);
+    try testing.expect(deinit_res);
+}
+
+test "writer internal writer fail" {
+    var b: [1]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciWriterAsync = undefined;
+    const init_err = lib.gci_writer_async_init(
+        &context,
+        lib.gci_writer_string_interface(&c),
+        &buffer,
+        buffer.len,
+        2,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_async_interface(&context);
+
+    // Accepted into the buffer, the failure is reported by the next flush
+    const res1 = lib.gci_writer_write(writer, "12", 2);
+    try testing.expectEqual(2, res1);
+
+    const flush_res = lib.gci_writer_async_flush(&context);
+    try testing.expect(!flush_res);
+
+    const res2 = lib.gci_writer_write(writer, "3", 1);
+    try testing.expectEqual(0, res2);
+
+    const deinit_res = lib.gci_writer_async_deinit(&context);
+    try testing.expect(!deinit_res);
+}
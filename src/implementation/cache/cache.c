@@ -0,0 +1,408 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <assert.h>
+#include <string.h>
+#include <gci_cache.h>
+
+#define GCI_CACHE_NONE SIZE_MAX
+
+size_t gci_reader_cached_bucket(struct GciReaderCached const *context, uint64_t block);
+size_t gci_reader_cached_find(struct GciReaderCached const *context, uint64_t block);
+void gci_reader_cached_insert(struct GciReaderCached *context, size_t index);
+void gci_reader_cached_remove(struct GciReaderCached *context, size_t index);
+void gci_reader_cached_push(struct GciReaderCached *context, size_t index, bool newest);
+void gci_reader_cached_pop(struct GciReaderCached *context, size_t index);
+size_t gci_reader_cached_cursor_read(void const *context, char *buffer, size_t buffer_size);
+bool gci_reader_cached_cursor_eof(void const *context);
+size_t gci_reader_cached_cursor_peek(void const *context, char const **data);
+void gci_reader_cached_cursor_consume(void const *context, size_t amount);
+size_t gci_reader_cached_cursor_read_at(void const *context, char *buffer, size_t buffer_size, uint64_t offset);
+
+enum GciError gci_reader_cached_init(
+    struct GciReaderCached *context,
+    struct GciInterfaceReader reader,
+    struct GciInterfaceAllocator allocator,
+    size_t block_size,
+    size_t block_count
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (reader.read_at == NULL) { return GCI_ERROR_NULL; }
+    if (block_size == 0 || block_count == 0) { return GCI_ERROR_BUFFER; }
+    if (block_count > SIZE_MAX / block_size) { return GCI_ERROR_BUFFER; }
+    if (block_count > SIZE_MAX / 2 / sizeof(struct GciCacheBlock)) { return GCI_ERROR_BUFFER; }
+
+    unsigned bucket_bits = 1;
+    while (((size_t) 1 << bucket_bits) < block_count) {
+        bucket_bits += 1;
+    }
+    size_t bucket_count = (size_t) 1 << bucket_bits;
+
+    context->reader = reader;
+    context->allocator = allocator;
+    context->block_size = block_size;
+    context->block_count = block_count;
+    context->bucket_bits = bucket_bits;
+    context->oldest = GCI_CACHE_NONE;
+    context->newest = GCI_CACHE_NONE;
+    context->waiting = 0;
+    context->hits = 0;
+    context->misses = 0;
+
+    if (pthread_mutex_init(&context->mutex, NULL) != 0) {
+        return GCI_ERROR_IO;
+    }
+    if (pthread_cond_init(&context->changed, NULL) != 0) {
+        pthread_mutex_destroy(&context->mutex);
+        return GCI_ERROR_IO;
+    }
+
+    context->data = gci_allocator_alloc(allocator, block_size * block_count);
+    context->blocks = gci_allocator_alloc(allocator, sizeof(struct GciCacheBlock) * block_count);
+    context->buckets = gci_allocator_alloc(allocator, sizeof(size_t) * bucket_count);
+    if (context->data == NULL || context->blocks == NULL || context->buckets == NULL) {
+        gci_allocator_free(allocator, context->data, block_size * block_count);
+        gci_allocator_free(allocator, context->blocks, sizeof(struct GciCacheBlock) * block_count);
+        gci_allocator_free(allocator, context->buckets, sizeof(size_t) * bucket_count);
+        pthread_cond_destroy(&context->changed);
+        pthread_mutex_destroy(&context->mutex);
+        return GCI_ERROR_BUFFER;
+    }
+
+    for (size_t i = 0; i < bucket_count; i++) {
+        context->buckets[i] = GCI_CACHE_NONE;
+    }
+    for (size_t i = 0; i < block_count; i++) {
+        context->blocks[i] = (struct GciCacheBlock) {
+            .index = 0,
+            .length = 0,
+            .pins = 0,
+            .state = GCI_CACHE_BLOCK_EMPTY,
+            .older = GCI_CACHE_NONE,
+            .newer = GCI_CACHE_NONE,
+            .chain = GCI_CACHE_NONE,
+        };
+        gci_reader_cached_push(context, i, true);
+    }
+
+    return GCI_ERROR_OK;
+}
+
+void gci_reader_cached_deinit(struct GciReaderCached *context) {
+    assert(context != NULL);
+    pthread_cond_destroy(&context->changed);
+    pthread_mutex_destroy(&context->mutex);
+
+    size_t bucket_count = (size_t) 1 << context->bucket_bits;
+    gci_allocator_free(context->allocator, context->data, context->block_size * context->block_count);
+    gci_allocator_free(context->allocator, context->blocks, sizeof(struct GciCacheBlock) * context->block_count);
+    gci_allocator_free(context->allocator, context->buckets, sizeof(size_t) * bucket_count);
+
+    context->data = NULL;
+    context->blocks = NULL;
+    context->buckets = NULL;
+}
+
+size_t gci_reader_cached_read_at(struct GciReaderCached *context, char *buffer, size_t buffer_size, uint64_t offset) {
+    assert(context != NULL);
+    assert(buffer != NULL || buffer_size == 0);
+
+    size_t read_length = 0;
+    while (read_length < buffer_size) {
+        if (offset > UINT64_MAX - read_length) { break; }
+        uint64_t position = offset + read_length;
+        size_t within = (size_t) (position % context->block_size);
+
+        size_t length;
+        char const *data = gci_reader_cached_pin(context, position / context->block_size, &length);
+
+        size_t available = length > within ? length - within : 0;
+        available = available > buffer_size - read_length ? buffer_size - read_length : available;
+        memcpy(buffer + read_length, data + within, available);
+        gci_reader_cached_unpin(context, data);
+
+        read_length += available;
+        if (length < context->block_size) { break; }
+    }
+
+    assert(read_length <= buffer_size);
+    return read_length;
+}
+
+char const *gci_reader_cached_pin(struct GciReaderCached *context, uint64_t block, size_t *length) {
+    assert(context != NULL);
+    assert(length != NULL);
+
+    pthread_mutex_lock(&context->mutex);
+    for (;;) {
+        size_t index = gci_reader_cached_find(context, block);
+        if (index != GCI_CACHE_NONE && context->blocks[index].state == GCI_CACHE_BLOCK_READY) {
+            struct GciCacheBlock *found = &context->blocks[index];
+            if (found->pins == 0) {
+                gci_reader_cached_pop(context, index);
+            }
+            found->pins += 1;
+            context->hits += 1;
+            *length = found->length;
+
+            pthread_mutex_unlock(&context->mutex);
+            return context->data + index * context->block_size;
+        }
+
+        // Either another thread is loading the block or every block is in use
+        if (index != GCI_CACHE_NONE || context->oldest == GCI_CACHE_NONE) {
+            context->waiting += 1;
+            pthread_cond_wait(&context->changed, &context->mutex);
+            context->waiting -= 1;
+            continue;
+        }
+
+        index = context->oldest;
+        gci_reader_cached_pop(context, index);
+        if (context->blocks[index].state == GCI_CACHE_BLOCK_READY) {
+            gci_reader_cached_remove(context, index);
+        }
+
+        struct GciCacheBlock *victim = &context->blocks[index];
+        victim->index = block;
+        victim->length = 0;
+        victim->pins = 1;
+        victim->state = GCI_CACHE_BLOCK_LOADING;
+        gci_reader_cached_insert(context, index);
+        context->misses += 1;
+        pthread_mutex_unlock(&context->mutex);
+
+        char *data = context->data + index * context->block_size;
+        size_t read_length = 0;
+        if (block <= UINT64_MAX / context->block_size) {
+            read_length = gci_reader_read_at(context->reader, data, context->block_size, block * context->block_size);
+        }
+
+        pthread_mutex_lock(&context->mutex);
+        victim->length = read_length;
+        victim->state = GCI_CACHE_BLOCK_READY;
+        if (context->waiting > 0) {
+            pthread_cond_broadcast(&context->changed);
+        }
+        pthread_mutex_unlock(&context->mutex);
+
+        *length = read_length;
+        return data;
+    }
+}
+
+void gci_reader_cached_unpin(struct GciReaderCached *context, char const *data) {
+    assert(context != NULL);
+    assert(data != NULL);
+    assert(context->data <= data);
+
+    size_t index = (size_t) (data - context->data) / context->block_size;
+    assert(index < context->block_count);
+
+    pthread_mutex_lock(&context->mutex);
+    struct GciCacheBlock *block = &context->blocks[index];
+    assert(block->pins > 0);
+    block->pins -= 1;
+
+    if (block->pins == 0) {
+        // An empty block is most likely a failed read, drop it so the next
+        // pin tries again
+        if (block->length == 0) {
+            gci_reader_cached_remove(context, index);
+            block->state = GCI_CACHE_BLOCK_EMPTY;
+            gci_reader_cached_push(context, index, false);
+        } else {
+            gci_reader_cached_push(context, index, true);
+        }
+
+        if (context->waiting > 0) {
+            pthread_cond_broadcast(&context->changed);
+        }
+    }
+    pthread_mutex_unlock(&context->mutex);
+}
+
+void gci_reader_cached_counters(struct GciReaderCached *context, uint64_t *hits, uint64_t *misses) {
+    assert(context != NULL);
+    pthread_mutex_lock(&context->mutex);
+    if (hits != NULL) { *hits = context->hits; }
+    if (misses != NULL) { *misses = context->misses; }
+    pthread_mutex_unlock(&context->mutex);
+}
+
+size_t gci_reader_cached_bucket(struct GciReaderCached const *context, uint64_t block) {
+    assert(context != NULL);
+    return (size_t) ((block * 0x9E3779B97F4A7C15ull) >> (64 - context->bucket_bits));
+}
+
+size_t gci_reader_cached_find(struct GciReaderCached const *context, uint64_t block) {
+    assert(context != NULL);
+    size_t index = context->buckets[gci_reader_cached_bucket(context, block)];
+    while (index != GCI_CACHE_NONE && context->blocks[index].index != block) {
+        index = context->blocks[index].chain;
+    }
+    return index;
+}
+
+void gci_reader_cached_insert(struct GciReaderCached *context, size_t index) {
+    assert(context != NULL);
+    size_t bucket = gci_reader_cached_bucket(context, context->blocks[index].index);
+    context->blocks[index].chain = context->buckets[bucket];
+    context->buckets[bucket] = index;
+}
+
+void gci_reader_cached_remove(struct GciReaderCached *context, size_t index) {
+    assert(context != NULL);
+    size_t *link = &context->buckets[gci_reader_cached_bucket(context, context->blocks[index].index)];
+    while (*link != index) {
+        assert(*link != GCI_CACHE_NONE);
+        link = &context->blocks[*link].chain;
+    }
+    *link = context->blocks[index].chain;
+    context->blocks[index].chain = GCI_CACHE_NONE;
+}
+
+void gci_reader_cached_push(struct GciReaderCached *context, size_t index, bool newest) {
+    assert(context != NULL);
+    struct GciCacheBlock *block = &context->blocks[index];
+
+    if (newest) {
+        block->older = context->newest;
+        block->newer = GCI_CACHE_NONE;
+        if (context->newest != GCI_CACHE_NONE) {
+            context->blocks[context->newest].newer = index;
+        } else {
+            context->oldest = index;
+        }
+        context->newest = index;
+    } else {
+        block->older = GCI_CACHE_NONE;
+        block->newer = context->oldest;
+        if (context->oldest != GCI_CACHE_NONE) {
+            context->blocks[context->oldest].older = index;
+        } else {
+            context->newest = index;
+        }
+        context->oldest = index;
+    }
+}
+
+void gci_reader_cached_pop(struct GciReaderCached *context, size_t index) {
+    assert(context != NULL);
+    struct GciCacheBlock *block = &context->blocks[index];
+
+    if (block->older != GCI_CACHE_NONE) {
+        context->blocks[block->older].newer = block->newer;
+    } else {
+        context->oldest = block->newer;
+    }
+    if (block->newer != GCI_CACHE_NONE) {
+        context->blocks[block->newer].older = block->older;
+    } else {
+        context->newest = block->older;
+    }
+
+    block->older = GCI_CACHE_NONE;
+    block->newer = GCI_CACHE_NONE;
+}
+
+enum GciError gci_reader_cached_cursor_init(struct GciReaderCachedCursor *context, struct GciReaderCached *cache, uint64_t offset) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->cache = cache;
+    context->offset = offset;
+    context->pinned = NULL;
+    context->pinned_block = 0;
+    context->pinned_length = 0;
+    context->eof = false;
+    if (cache == NULL) { return GCI_ERROR_NULL; }
+
+    return GCI_ERROR_OK;
+}
+
+void gci_reader_cached_cursor_deinit(struct GciReaderCachedCursor *context) {
+    assert(context != NULL);
+    if (context->pinned != NULL) {
+        gci_reader_cached_unpin(context->cache, context->pinned);
+    }
+    context->pinned = NULL;
+}
+
+struct GciInterfaceReader gci_reader_cached_cursor_interface(struct GciReaderCachedCursor *context) {
+    return (struct GciInterfaceReader) {
+        .context = context,
+        .read = gci_reader_cached_cursor_read,
+        .eof = gci_reader_cached_cursor_eof,
+        .peek = gci_reader_cached_cursor_peek,
+        .consume = gci_reader_cached_cursor_consume,
+        .read_at = gci_reader_cached_cursor_read_at,
+    };
+}
+
+size_t gci_reader_cached_cursor_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    assert(buffer != NULL);
+
+    size_t read_length = 0;
+    while (read_length < buffer_size) {
+        char const *data;
+        size_t length = gci_reader_cached_cursor_peek(void_context, &data);
+        if (length == 0) { break; }
+
+        length = length > buffer_size - read_length ? buffer_size - read_length : length;
+        memcpy(buffer + read_length, data, length);
+        gci_reader_cached_cursor_consume(void_context, length);
+        read_length += length;
+    }
+
+    assert(read_length <= buffer_size);
+    return read_length;
+}
+
+bool gci_reader_cached_cursor_eof(void const *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderCachedCursor *context = (struct GciReaderCachedCursor*) void_context;
+    return context->eof;
+}
+
+size_t gci_reader_cached_cursor_peek(void const *void_context, char const **data) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciReaderCachedCursor *context = (struct GciReaderCachedCursor*) void_context;
+
+    size_t block_size = context->cache->block_size;
+    uint64_t block = context->offset / block_size;
+    size_t within = (size_t) (context->offset % block_size);
+
+    if (context->pinned == NULL || context->pinned_block != block) {
+        // Unpin first so a cursor never holds two blocks while waiting for one
+        if (context->pinned != NULL) {
+            gci_reader_cached_unpin(context->cache, context->pinned);
+            context->pinned = NULL;
+        }
+        context->pinned = gci_reader_cached_pin(context->cache, block, &context->pinned_length);
+        context->pinned_block = block;
+    }
+
+    if (context->pinned_length <= within) {
+        context->eof = true;
+        return 0;
+    }
+
+    *data = context->pinned + within;
+    return context->pinned_length - within;
+}
+
+void gci_reader_cached_cursor_consume(void const *void_context, size_t amount) {
+    assert(void_context != NULL);
+    struct GciReaderCachedCursor *context = (struct GciReaderCachedCursor*) void_context;
+
+    assert(context->pinned != NULL || amount == 0);
+    context->offset += amount;
+}
+
+size_t gci_reader_cached_cursor_read_at(void const *void_context, char *buffer, size_t buffer_size, uint64_t offset) {
+    assert(void_context != NULL);
+    struct GciReaderCachedCursor *context = (struct GciReaderCachedCursor*) void_context;
+    return gci_reader_cached_read_at(context->cache, buffer, buffer_size, offset);
+}
@@ -0,0 +1,166 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const allocator = @import("../allocator/allocator.zig");
+const reader = @import("../reader/reader.zig");
+const fd = @import("../fd/fd.zig");
+const InterfaceAllocator = allocator.InterfaceAllocator;
+const InterfaceReader = reader.InterfaceReader;
+
+pub const Counters = struct {
+    hits: u64,
+    misses: u64,
+};
+
+pub const Cached = struct {
+    inner: lib.GciReaderCached,
+
+    // Holds a lock shared by every thread using the cache, so it is
+    // initialized in place and must not move until `deinit`.
+    pub fn init(self: *Cached, r: InterfaceReader, a: InterfaceAllocator, block_size: usize, block_count: usize) !void {
+        const err = lib.gci_reader_cached_init(
+            &self.inner,
+            r.reader,
+            a.allocator,
+            block_size,
+            block_count,
+        );
+        try internal.enumToError(err);
+    }
+
+    pub fn deinit(self: *Cached) void {
+        lib.gci_reader_cached_deinit(&self.inner);
+    }
+
+    // Safe to call from several threads at once, a short result means the
+    // source ended.
+    pub fn readAt(self: *Cached, buffer: []u8, offset: u64) []u8 {
+        const length = lib.gci_reader_cached_read_at(&self.inner, buffer.ptr, buffer.len, offset);
+        return buffer[0..length];
+    }
+
+    pub fn counters(self: *Cached) Counters {
+        var result: Counters = undefined;
+        lib.gci_reader_cached_counters(&self.inner, &result.hits, &result.misses);
+        return result;
+    }
+};
+
+pub const Cursor = struct {
+    inner: lib.GciReaderCachedCursor,
+
+    pub fn init(cache: *Cached, offset: u64) !Cursor {
+        var self: Cursor = undefined;
+        const err = lib.gci_reader_cached_cursor_init(&self.inner, &cache.inner, offset);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn deinit(self: *Cursor) void {
+        lib.gci_reader_cached_cursor_deinit(&self.inner);
+    }
+
+    pub fn interface(self: *Cursor) InterfaceReader {
+        return .{ .reader = lib.gci_reader_cached_cursor_interface(&self.inner) };
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_cache.zig");
+}
+
+test "init without read at" {
+    var source = try reader.String.init("12345");
+    var file = try reader.Fail.init(source.interface(), 1);
+
+    var cache: Cached = undefined;
+    const err = cache.init(file.interface(), allocator.libc(), 4, 2);
+    try testing.expectError(error.Null, err);
+}
+
+test "read at" {
+    var source = try reader.String.init("the quick brown fox");
+
+    var cache: Cached = undefined;
+    try cache.init(source.interface(), allocator.libc(), 4, 2);
+    defer cache.deinit();
+
+    var buffer: [9]u8 = undefined;
+    try testing.expectEqualStrings("quick bro", cache.readAt(&buffer, 4));
+    try testing.expectEqualStrings("fox", cache.readAt(&buffer, 16));
+    try testing.expectEqualStrings("", cache.readAt(&buffer, 19));
+
+    const before = cache.counters();
+    try testing.expectEqualStrings("fox", cache.readAt(&buffer, 16));
+    const after = cache.counters();
+    try testing.expectEqual(before.misses, after.misses);
+    try testing.expect(after.hits > before.hits);
+}
+
+test "cursor" {
+    var source = try reader.String.init("the quick brown fox");
+
+    var cache: Cached = undefined;
+    try cache.init(source.interface(), allocator.libc(), 4, 2);
+    defer cache.deinit();
+
+    var context = try Cursor.init(&cache, 4);
+    defer context.deinit();
+    const r = context.interface();
+
+    var scratch: [0]u8 = undefined;
+    const view = try r.peek(&scratch);
+    try testing.expectEqualStrings("quic", view);
+    r.consume(view, 2);
+
+    var buffer: [32]u8 = undefined;
+    try testing.expectEqualStrings("ick brown fox", try r.read(&buffer));
+    try testing.expect(r.eof());
+
+    try testing.expectEqualStrings("the", try r.readAt(buffer[0..3], 0));
+}
+
+test "shared between threads" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    var data: [64 * 1024 + 7]u8 = undefined;
+    for (&data, 0..) |*byte, i| {
+        byte.* = @truncate(i * 31 + i / 251);
+    }
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+    try file.writeAll(&data);
+
+    var source = try fd.Reader.init(file.handle);
+    var cache: Cached = undefined;
+    try cache.init(source.interface(), allocator.libc(), 1024, 4);
+    defer cache.deinit();
+
+    const Worker = struct {
+        fn run(c: *Cached, expected: []const u8, seed: u64) !void {
+            var prng = std.Random.DefaultPrng.init(seed);
+            const random = prng.random();
+
+            var buffer: [3000]u8 = undefined;
+            for (0..500) |_| {
+                const offset = random.uintLessThan(usize, expected.len);
+                const length = random.uintLessThan(usize, buffer.len);
+                const result = c.readAt(buffer[0..length], offset);
+                const end = @min(expected.len, offset + length);
+                try testing.expectEqualSlices(u8, expected[offset..end], result);
+            }
+        }
+    };
+
+    var threads: [4]std.Thread = undefined;
+    for (&threads, 0..) |*thread, i| {
+        thread.* = try std.Thread.spawn(.{}, Worker.run, .{ &cache, data[0..], i });
+    }
+    for (threads) |thread| {
+        thread.join();
+    }
+}
@@ -0,0 +1,201 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "cached init" {
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, "data", 4);
+
+    var context: lib.GciReaderCached = undefined;
+    const init_err = lib.gci_reader_cached_init(&context, lib.gci_reader_string_interface(&c), lib.gci_allocator_libc_interface(), 2, 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    lib.gci_reader_cached_deinit(&context);
+}
+
+test "cached init null" {
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, "data", 4);
+
+    const init_err1 = lib.gci_reader_cached_init(null, lib.gci_reader_string_interface(&c), lib.gci_allocator_libc_interface(), 2, 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err1);
+
+    var reader = lib.gci_reader_string_interface(&c);
+    reader.read_at = null;
+    var context: lib.GciReaderCached = undefined;
+    const init_err2 = lib.gci_reader_cached_init(&context, reader, lib.gci_allocator_libc_interface(), 2, 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err2);
+}
+
+test "cached init buffer" {
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, "data", 4);
+    var context: lib.GciReaderCached = undefined;
+
+    const init_err1 = lib.gci_reader_cached_init(&context, lib.gci_reader_string_interface(&c), lib.gci_allocator_libc_interface(), 0, 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err1);
+
+    const init_err2 = lib.gci_reader_cached_init(&context, lib.gci_reader_string_interface(&c), lib.gci_allocator_libc_interface(), 2, 0);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err2);
+}
+
+test "cached read at" {
+    const data = "0123456789";
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, data, data.len);
+
+    var context: lib.GciReaderCached = undefined;
+    const init_err = lib.gci_reader_cached_init(&context, lib.gci_reader_string_interface(&c), lib.gci_allocator_libc_interface(), 3, 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_reader_cached_deinit(&context);
+
+    var buffer: [5]u8 = undefined;
+    const length1 = lib.gci_reader_cached_read_at(&context, &buffer, buffer.len, 2);
+    try testing.expectEqual(5, length1);
+    try testing.expectEqualStrings("23456", &buffer);
+
+    const length2 = lib.gci_reader_cached_read_at(&context, &buffer, buffer.len, 8);
+    try testing.expectEqual(2, length2);
+    try testing.expectEqualStrings("89", buffer[0..2]);
+
+    var hits: u64 = undefined;
+    var misses: u64 = undefined;
+    lib.gci_reader_cached_counters(&context, &hits, &misses);
+    try testing.expectEqual(1, hits);
+    try testing.expectEqual(4, misses);
+}
+
+test "cached pin" {
+    const data = "0123456789";
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, data, data.len);
+
+    var context: lib.GciReaderCached = undefined;
+    const init_err = lib.gci_reader_cached_init(&context, lib.gci_reader_string_interface(&c), lib.gci_allocator_libc_interface(), 4, 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_reader_cached_deinit(&context);
+
+    var length1: usize = undefined;
+    const block1 = lib.gci_reader_cached_pin(&context, 1, &length1);
+    try testing.expectEqual(4, length1);
+    try testing.expectEqualStrings("4567", block1[0..4]);
+
+    var length2: usize = undefined;
+    const block2 = lib.gci_reader_cached_pin(&context, 1, &length2);
+    try testing.expectEqual(block1, block2);
+
+    var length3: usize = undefined;
+    const block3 = lib.gci_reader_cached_pin(&context, 2, &length3);
+    try testing.expectEqual(2, length3);
+    try testing.expectEqualStrings("89", block3[0..2]);
+
+    lib.gci_reader_cached_unpin(&context, block1);
+    lib.gci_reader_cached_unpin(&context, block2);
+    lib.gci_reader_cached_unpin(&context, block3);
+
+    var hits: u64 = undefined;
+    var misses: u64 = undefined;
+    lib.gci_reader_cached_counters(&context, &hits, &misses);
+    try testing.expectEqual(1, hits);
+    try testing.expectEqual(2, misses);
+}
+
+test "cursor read" {
+    const data = "0123456789";
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, data, data.len);
+
+    var cache: lib.GciReaderCached = undefined;
+    const init_err1 = lib.gci_reader_cached_init(&cache, lib.gci_reader_string_interface(&c), lib.gci_allocator_libc_interface(), 4, 1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err1);
+    defer lib.gci_reader_cached_deinit(&cache);
+
+    var context: lib.GciReaderCachedCursor = undefined;
+    const init_err2 = lib.gci_reader_cached_cursor_init(&context, &cache, 3);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err2);
+    defer lib.gci_reader_cached_cursor_deinit(&context);
+    const reader = lib.gci_reader_cached_cursor_interface(&context);
+
+    var buffer: [5]u8 = undefined;
+    const length1 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(5, length1);
+    try testing.expectEqualStrings("34567", &buffer);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    const length2 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(2, length2);
+    try testing.expectEqualStrings("89", buffer[0..2]);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "cached threads" {
+    const thread_count = 8;
+    const block_size = 16;
+
+    var data: [64 * block_size]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = @truncate(index *% 131 +% index / 256);
+    }
+
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, &data, data.len);
+
+    // Fewer blocks than threads, so threads wait for blocks being loaded
+    // and for every block being pinned
+    var context: lib.GciReaderCached = undefined;
+    const init_err = lib.gci_reader_cached_init(&context, lib.gci_reader_string_interface(&c), lib.gci_allocator_libc_interface(), block_size, 3);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_reader_cached_deinit(&context);
+
+    const Worker = struct {
+        // Errors returned from a thread are only logged, so they are kept
+        fn run(cache: *lib.GciReaderCached, source: []const u8, id: usize, pins: *u64, failed: *bool) void {
+            check(cache, source, id, pins) catch {
+                failed.* = true;
+            };
+        }
+
+        fn check(cache: *lib.GciReaderCached, source: []const u8, id: usize, pins: *u64) !void {
+            for (0..300) |i| {
+                var buffer: [40]u8 = undefined;
+                const size = 1 + (i * 13 + id) % buffer.len;
+                const offset = (i * 37 + id * 101) % (source.len - buffer.len);
+
+                const length = lib.gci_reader_cached_read_at(cache, &buffer, size, offset);
+                try testing.expectEqual(size, length);
+                try testing.expectEqualSlices(u8, source[offset .. offset + size], buffer[0..size]);
+                pins.* += (offset + size - 1) / block_size - offset / block_size + 1;
+
+                const block = (i + id) % 8;
+                var block_length: usize = undefined;
+                const pinned = lib.gci_reader_cached_pin(cache, block, &block_length);
+                try testing.expectEqual(block_size, block_length);
+                try testing.expectEqualSlices(u8, source[block * block_size .. (block + 1) * block_size], pinned[0..block_size]);
+                lib.gci_reader_cached_unpin(cache, pinned);
+                pins.* += 1;
+            }
+        }
+    };
+
+    var pins = [_]u64{0} ** thread_count;
+    var failed = [_]bool{false} ** thread_count;
+    var threads: [thread_count]std.Thread = undefined;
+    for (&threads, 0..) |*thread, i| {
+        thread.* = try std.Thread.spawn(.{}, Worker.run, .{ &context, data[0..], i, &pins[i], &failed[i] });
+    }
+    for (threads) |thread| {
+        thread.join();
+    }
+    for (failed) |thread_failed| {
+        try testing.expect(!thread_failed);
+    }
+
+    var expected: u64 = 0;
+    for (pins) |count| {
+        expected += count;
+    }
+
+    var hits: u64 = undefined;
+    var misses: u64 = undefined;
+    lib.gci_reader_cached_counters(&context, &hits, &misses);
+    try testing.expectEqual(expected, hits + misses);
+}
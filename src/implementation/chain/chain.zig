@@ -0,0 +1,560 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const reader = @import("../reader/reader.zig");
+const writer = @import("../writer/writer.zig");
+const fd = @import("../fd/fd.zig");
+const InterfaceReader = reader.InterfaceReader;
+const InterfaceWriter = writer.InterfaceWriter;
+
+// Statically dispatched chains of readers and writers. Every layer knows the
+// concrete type of the layer below it so calls between layers are direct and
+// the buffer fast paths inline into the caller, only the outermost layer is
+// turned into a `GciInterfaceReader` or `GciInterfaceWriter` when needed.
+//
+// A chain reader is any type with the methods
+//
+//  read(self: *T, buffer: []u8) usize
+//  eof(self: *T) bool
+//
+// and a chain writer any type with the methods
+//
+//  write(self: *T, data: []const u8) usize
+//  flush(self: *T) bool
+//
+// where a short read or write means the source ended or an error occured,
+// like their C counterparts.
+
+const c = struct {
+    const ReadFn = fn (?*const anyopaque, [*c]u8, usize) callconv(.C) usize;
+    const EofFn = fn (?*const anyopaque) callconv(.C) bool;
+    const WriteFn = fn (?*const anyopaque, [*c]const u8, usize) callconv(.C) usize;
+
+    extern fn gci_reader_file_read(context: ?*const anyopaque, buffer: [*c]u8, buffer_size: usize) usize;
+    extern fn gci_reader_file_eof(context: ?*const anyopaque) bool;
+    extern fn gci_reader_fd_read(context: ?*const anyopaque, buffer: [*c]u8, buffer_size: usize) usize;
+    extern fn gci_reader_fd_eof(context: ?*const anyopaque) bool;
+    extern fn gci_reader_mmap_read(context: ?*const anyopaque, buffer: [*c]u8, buffer_size: usize) usize;
+    extern fn gci_reader_mmap_eof(context: ?*const anyopaque) bool;
+    extern fn gci_reader_string_read(context: ?*const anyopaque, buffer: [*c]u8, buffer_size: usize) usize;
+    extern fn gci_reader_string_eof(context: ?*const anyopaque) bool;
+    extern fn gci_reader_range_read(context: ?*const anyopaque, buffer: [*c]u8, buffer_size: usize) usize;
+    extern fn gci_reader_range_eof(context: ?*const anyopaque) bool;
+
+    extern fn gci_writer_file_write(context: ?*const anyopaque, data: [*c]const u8, data_size: usize) usize;
+    extern fn gci_writer_fd_write(context: ?*const anyopaque, data: [*c]const u8, data_size: usize) usize;
+    extern fn gci_writer_string_write(context: ?*const anyopaque, data: [*c]const u8, data_size: usize) usize;
+    extern fn gci_writer_growable_write(context: ?*const anyopaque, data: [*c]const u8, data_size: usize) usize;
+    extern fn gci_writer_rope_write(context: ?*const anyopaque, data: [*c]const u8, data_size: usize) usize;
+};
+
+const SourceFunctions = struct {
+    read: *const c.ReadFn,
+    eof: *const c.EofFn,
+};
+
+fn sourceFunctions(comptime T: type) SourceFunctions {
+    return switch (T) {
+        reader.File => .{ .read = c.gci_reader_file_read, .eof = c.gci_reader_file_eof },
+        fd.Reader => .{ .read = c.gci_reader_fd_read, .eof = c.gci_reader_fd_eof },
+        fd.Mmap => .{ .read = c.gci_reader_mmap_read, .eof = c.gci_reader_mmap_eof },
+        reader.String => .{ .read = c.gci_reader_string_read, .eof = c.gci_reader_string_eof },
+        reader.Range => .{ .read = c.gci_reader_range_read, .eof = c.gci_reader_range_eof },
+        else => @compileError("no static read for " ++ @typeName(T)),
+    };
+}
+
+fn sinkFunction(comptime T: type) *const c.WriteFn {
+    return switch (T) {
+        writer.File => c.gci_writer_file_write,
+        fd.Writer => c.gci_writer_fd_write,
+        writer.String => c.gci_writer_string_write,
+        writer.Growable => c.gci_writer_growable_write,
+        writer.Rope => c.gci_writer_rope_write,
+        else => @compileError("no static write for " ++ @typeName(T)),
+    };
+}
+
+// The innermost layer of a reader chain, calls the read function of a
+// concrete reader such as `fd.Reader` directly. An `InterfaceReader` may be
+// used as a source as well, which keeps the one indirect call at the bottom.
+pub fn Source(comptime T: type) type {
+    if (T == InterfaceReader) {
+        return struct {
+            const Self = @This();
+
+            source: InterfaceReader,
+
+            pub fn init(source: InterfaceReader) Self {
+                return .{ .source = source };
+            }
+
+            pub inline fn read(self: *Self, buffer: []u8) usize {
+                return lib.gci_reader_read(self.source.reader, buffer.ptr, buffer.len);
+            }
+
+            pub inline fn eof(self: *Self) bool {
+                return lib.gci_reader_eof(self.source.reader);
+            }
+        };
+    }
+
+    const functions = comptime sourceFunctions(T);
+    return struct {
+        const Self = @This();
+
+        source: *T,
+
+        pub fn init(source: *T) Self {
+            return .{ .source = source };
+        }
+
+        pub inline fn read(self: *Self, buffer: []u8) usize {
+            return functions.read(&self.source.inner, buffer.ptr, buffer.len);
+        }
+
+        pub inline fn eof(self: *Self) bool {
+            return functions.eof(&self.source.inner);
+        }
+    };
+}
+
+// The innermost layer of a writer chain, see `Source`.
+pub fn Sink(comptime T: type) type {
+    if (T == InterfaceWriter) {
+        return struct {
+            const Self = @This();
+
+            sink: InterfaceWriter,
+
+            pub fn init(sink: InterfaceWriter) Self {
+                return .{ .sink = sink };
+            }
+
+            pub inline fn write(self: *Self, data: []const u8) usize {
+                return lib.gci_writer_write(self.sink.writer, data.ptr, data.len);
+            }
+
+            pub inline fn flush(_: *Self) bool {
+                return true;
+            }
+        };
+    }
+
+    const function = comptime sinkFunction(T);
+    return struct {
+        const Self = @This();
+
+        sink: *T,
+
+        pub fn init(sink: *T) Self {
+            return .{ .sink = sink };
+        }
+
+        pub inline fn write(self: *Self, data: []const u8) usize {
+            return function(&self.sink.inner, data.ptr, data.len);
+        }
+
+        pub inline fn flush(_: *Self) bool {
+            return true;
+        }
+    };
+}
+
+// Buffers `size` bytes read from the chain reader `Inner`. Reads which the
+// buffer can satisfy, including `readByte`, never leave the caller.
+//
+// Must not be moved after `interface` has been called.
+pub fn ReaderBuffer(comptime Inner: type, comptime size: usize) type {
+    if (size == 0) {
+        @compileError("buffer size must be positive");
+    }
+
+    return struct {
+        const Self = @This();
+
+        inner: Inner,
+        buffer: [size]u8 = undefined,
+        start: usize = 0,
+        end: usize = 0,
+
+        pub fn init(inner: Inner) Self {
+            return .{ .inner = inner };
+        }
+
+        pub inline fn readByte(self: *Self) ?u8 {
+            if (self.start < self.end) {
+                const byte = self.buffer[self.start];
+                self.start += 1;
+                return byte;
+            }
+            return self.readByteSlow();
+        }
+
+        pub inline fn read(self: *Self, buffer: []u8) usize {
+            if (buffer.len <= self.end - self.start) {
+                @memcpy(buffer, self.buffer[self.start .. self.start + buffer.len]);
+                self.start += buffer.len;
+                return buffer.len;
+            }
+            return self.readSlow(buffer);
+        }
+
+        // Returns the buffered bytes, refilling the buffer if it is empty.
+        // Empty on eof or if an error occured.
+        pub inline fn peek(self: *Self) []const u8 {
+            if (self.start == self.end) {
+                _ = self.fill();
+            }
+            return self.buffer[self.start..self.end];
+        }
+
+        pub inline fn consume(self: *Self, amount: usize) void {
+            std.debug.assert(amount <= self.end - self.start);
+            self.start += amount;
+        }
+
+        pub fn eof(self: *Self) bool {
+            return self.start == self.end and self.inner.eof();
+        }
+
+        pub fn interface(self: *Self) InterfaceReader {
+            const r = lib.GciInterfaceReader{
+                .context = self,
+                .read = readCallback,
+                .eof = eofCallback,
+                .peek = peekCallback,
+                .consume = consumeCallback,
+                .read_at = null,
+            };
+            return .{ .reader = r };
+        }
+
+        fn fill(self: *Self) bool {
+            std.debug.assert(self.start == self.end);
+            self.start = 0;
+            self.end = self.inner.read(&self.buffer);
+            return self.end > 0;
+        }
+
+        fn readByteSlow(self: *Self) ?u8 {
+            if (!self.fill()) {
+                return null;
+            }
+            self.start = 1;
+            return self.buffer[0];
+        }
+
+        fn readSlow(self: *Self, buffer: []u8) usize {
+            var length = self.end - self.start;
+            @memcpy(buffer[0..length], self.buffer[self.start..self.end]);
+            self.start = self.end;
+
+            while (length < buffer.len) {
+                const left = buffer.len - length;
+                if (left >= size) {
+                    const amount = self.inner.read(buffer[length..]);
+                    length += amount;
+                    if (amount < left) {
+                        break;
+                    }
+                } else {
+                    if (!self.fill()) {
+                        break;
+                    }
+                    const amount = @min(left, self.end);
+                    @memcpy(buffer[length .. length + amount], self.buffer[0..amount]);
+                    self.start = amount;
+                    length += amount;
+                }
+            }
+
+            return length;
+        }
+
+        fn readCallback(context: ?*const anyopaque, buffer: [*c]u8, buffer_size: usize) callconv(.C) usize {
+            std.debug.assert(null != context);
+            std.debug.assert(null != buffer);
+            const self: *Self = @constCast(@alignCast(@ptrCast(context)));
+            return self.read(buffer[0..buffer_size]);
+        }
+
+        fn eofCallback(context: ?*const anyopaque) callconv(.C) bool {
+            std.debug.assert(null != context);
+            const self: *Self = @constCast(@alignCast(@ptrCast(context)));
+            return self.eof();
+        }
+
+        fn peekCallback(context: ?*const anyopaque, data: [*c][*c]const u8) callconv(.C) usize {
+            std.debug.assert(null != context);
+            std.debug.assert(null != data);
+            const self: *Self = @constCast(@alignCast(@ptrCast(context)));
+            const available = self.peek();
+            data.* = available.ptr;
+            return available.len;
+        }
+
+        fn consumeCallback(context: ?*const anyopaque, amount: usize) callconv(.C) void {
+            std.debug.assert(null != context);
+            const self: *Self = @constCast(@alignCast(@ptrCast(context)));
+            self.consume(amount);
+        }
+    };
+}
+
+// Buffers up to `size` bytes before writing them to the chain writer
+// `Inner`. Writes which fit in the buffer, including `writeByte`, never leave
+// the caller. Buffered bytes are only written by `flush` or when the buffer
+// runs out of space, a failed flush keeps the bytes which were not written.
+//
+// Must not be moved after `interface` has been called.
+pub fn WriterBuffer(comptime Inner: type, comptime size: usize) type {
+    if (size == 0) {
+        @compileError("buffer size must be positive");
+    }
+
+    return struct {
+        const Self = @This();
+
+        inner: Inner,
+        buffer: [size]u8 = undefined,
+        end: usize = 0,
+
+        pub fn init(inner: Inner) Self {
+            return .{ .inner = inner };
+        }
+
+        pub inline fn writeByte(self: *Self, byte: u8) bool {
+            if (self.end < size) {
+                self.buffer[self.end] = byte;
+                self.end += 1;
+                return true;
+            }
+            const data = [1]u8{byte};
+            return self.writeSlow(&data) == 1;
+        }
+
+        pub inline fn write(self: *Self, data: []const u8) usize {
+            if (data.len <= size - self.end) {
+                @memcpy(self.buffer[self.end .. self.end + data.len], data);
+                self.end += data.len;
+                return data.len;
+            }
+            return self.writeSlow(data);
+        }
+
+        // Returns `amount` bytes of the buffer to write into, which are
+        // written once they are passed to `commit`. Null if `amount` exceeds
+        // the buffer or the buffered bytes could not be written.
+        pub inline fn reserve(self: *Self, amount: usize) ?[]u8 {
+            if (amount <= size - self.end) {
+                return self.buffer[self.end .. self.end + amount];
+            }
+            if (amount > size or !self.drain()) {
+                return null;
+            }
+            return self.buffer[0..amount];
+        }
+
+        pub inline fn commit(self: *Self, amount: usize) void {
+            std.debug.assert(amount <= size - self.end);
+            self.end += amount;
+        }
+
+        // Writes the buffered bytes and flushes the layers below.
+        pub fn flush(self: *Self) bool {
+            return self.drain() and self.inner.flush();
+        }
+
+        pub fn interface(self: *Self) InterfaceWriter {
+            const w = lib.GciInterfaceWriter{
+                .context = self,
+                .write = writeCallback,
+                .reserve = reserveCallback,
+                .commit = commitCallback,
+                .writev = null,
+            };
+            return .{ .writer = w };
+        }
+
+        fn drain(self: *Self) bool {
+            const length = self.inner.write(self.buffer[0..self.end]);
+            if (length < self.end) {
+                std.mem.copyForwards(u8, self.buffer[0 .. self.end - length], self.buffer[length..self.end]);
+                self.end -= length;
+                return false;
+            }
+            self.end = 0;
+            return true;
+        }
+
+        fn writeSlow(self: *Self, data: []const u8) usize {
+            if (!self.drain()) {
+                return 0;
+            }
+            if (data.len >= size) {
+                return self.inner.write(data);
+            }
+            @memcpy(self.buffer[0..data.len], data);
+            self.end = data.len;
+            return data.len;
+        }
+
+        fn writeCallback(context: ?*const anyopaque, data: [*c]const u8, data_size: usize) callconv(.C) usize {
+            std.debug.assert(null != context);
+            std.debug.assert(null != data);
+            const self: *Self = @constCast(@alignCast(@ptrCast(context)));
+            return self.write(data[0..data_size]);
+        }
+
+        fn reserveCallback(context: ?*const anyopaque, amount: usize) callconv(.C) [*c]u8 {
+            std.debug.assert(null != context);
+            const self: *Self = @constCast(@alignCast(@ptrCast(context)));
+            const reserved = self.reserve(amount) orelse return null;
+            return reserved.ptr;
+        }
+
+        fn commitCallback(context: ?*const anyopaque, amount: usize) callconv(.C) usize {
+            std.debug.assert(null != context);
+            const self: *Self = @constCast(@alignCast(@ptrCast(context)));
+            self.commit(amount);
+            return amount;
+        }
+    };
+}
+
+// A `ReaderBuffer` straight over a concrete reader, e.g.
+// `BufferedReader(fd.Reader, 4096)`.
+pub fn BufferedReader(comptime T: type, comptime size: usize) type {
+    return ReaderBuffer(Source(T), size);
+}
+
+// A `WriterBuffer` straight over a concrete writer, e.g.
+// `BufferedWriter(fd.Writer, 4096)`.
+pub fn BufferedWriter(comptime T: type, comptime size: usize) type {
+    return WriterBuffer(Sink(T), size);
+}
+
+const testing = std.testing;
+
+test "reader bytes" {
+    var s = try reader.String.init("abcdefg");
+    var r = BufferedReader(reader.String, 3).init(Source(reader.String).init(&s));
+
+    var result: [7]u8 = undefined;
+    for (&result) |*byte| {
+        byte.* = r.readByte().?;
+    }
+    try testing.expectEqualStrings("abcdefg", &result);
+    try testing.expect(r.readByte() == null);
+    try testing.expect(r.eof());
+}
+
+test "reader read across buffer" {
+    var s = try reader.String.init("abcdefghij");
+    var r = BufferedReader(reader.String, 4).init(Source(reader.String).init(&s));
+
+    var small: [2]u8 = undefined;
+    try testing.expectEqual(2, r.read(&small));
+    try testing.expectEqualStrings("ab", &small);
+
+    var large: [7]u8 = undefined;
+    try testing.expectEqual(7, r.read(&large));
+    try testing.expectEqualStrings("cdefghi", &large);
+
+    var rest: [4]u8 = undefined;
+    try testing.expectEqual(1, r.read(&rest));
+    try testing.expectEqualStrings("j", rest[0..1]);
+    try testing.expect(r.eof());
+}
+
+test "reader nested layers" {
+    var s = try reader.String.init("0123456789");
+    const Inner = BufferedReader(reader.String, 3);
+    var r = ReaderBuffer(Inner, 5).init(Inner.init(Source(reader.String).init(&s)));
+
+    try testing.expectEqualStrings("01234", r.peek());
+    r.consume(4);
+    try testing.expectEqual('4', r.readByte().?);
+
+    var rest: [8]u8 = undefined;
+    try testing.expectEqual(5, r.read(&rest));
+    try testing.expectEqualStrings("56789", rest[0..5]);
+    try testing.expect(r.eof());
+}
+
+test "reader interface" {
+    var s = try reader.String.init("one\ntwo\n");
+    var r = BufferedReader(reader.String, 4).init(Source(reader.String).init(&s));
+    const i = r.interface();
+
+    var spill: [8]u8 = undefined;
+    try testing.expectEqualStrings("one\n", (try i.readUntil('\n', &spill)).?);
+    try testing.expectEqualStrings("two\n", (try i.readUntil('\n', &spill)).?);
+    try testing.expect(try i.readUntil('\n', &spill) == null);
+    try testing.expect(i.eof());
+}
+
+test "reader source fails" {
+    var s = try reader.String.init("abcdef");
+    var f = try reader.Fail.init(s.interface(), 1);
+    var r = ReaderBuffer(Source(InterfaceReader), 4).init(Source(InterfaceReader).init(f.interface()));
+
+    var result: [3]u8 = undefined;
+    try testing.expectEqual(3, r.read(&result));
+    try testing.expectEqual('d', r.readByte().?);
+    try testing.expect(r.readByte() == null);
+    try testing.expect(!r.eof());
+}
+
+test "writer bytes" {
+    var b: [16]u8 = undefined;
+    var s = try writer.String.init(&b);
+    var w = BufferedWriter(writer.String, 4).init(Sink(writer.String).init(&s));
+
+    for ("abcdef") |byte| {
+        try testing.expect(w.writeByte(byte));
+    }
+    try testing.expectEqualStrings("abcd", b[0..s.inner.current]);
+
+    try testing.expect(w.flush());
+    try testing.expectEqualStrings("abcdef", b[0..s.inner.current]);
+}
+
+test "writer large write" {
+    var b: [16]u8 = undefined;
+    var s = try writer.String.init(&b);
+    var w = BufferedWriter(writer.String, 4).init(Sink(writer.String).init(&s));
+
+    try testing.expectEqual(2, w.write("ab"));
+    try testing.expectEqual(6, w.write("cdefgh"));
+    try testing.expectEqualStrings("abcdefgh", b[0..s.inner.current]);
+    try testing.expectEqual(1, w.write("i"));
+    try testing.expect(w.flush());
+    try testing.expectEqualStrings("abcdefghi", b[0..s.inner.current]);
+}
+
+test "writer interface reserve" {
+    var b: [32]u8 = undefined;
+    var s = try writer.String.init(&b);
+    var w = BufferedWriter(writer.String, 8).init(Sink(writer.String).init(&s));
+    const i = w.interface();
+
+    try testing.expect(lib.gci_write_u64(i.writer, 1234));
+    try i.write(",");
+    try testing.expect(lib.gci_write_u64(i.writer, 567890));
+    try testing.expect(w.flush());
+    try testing.expectEqualStrings("1234,567890", b[0..s.inner.current]);
+}
+
+test "writer flush fails" {
+    var b: [3]u8 = undefined;
+    var s = try writer.String.init(&b);
+    var w = BufferedWriter(writer.String, 4).init(Sink(writer.String).init(&s));
+
+    try testing.expectEqual(4, w.write("abcd"));
+    try testing.expect(!w.flush());
+    try testing.expectEqualStrings("abc", &b);
+    try testing.expectEqual(1, w.end);
+    try testing.expectEqual(0, w.write("efgh"));
+}
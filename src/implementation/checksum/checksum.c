@@ -0,0 +1,454 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <assert.h>
+#include <pthread.h>
+#include <string.h>
+#include <gci_checksum.h>
+
+#if defined(__x86_64__)
+#define GCI_CHECKSUM_X86_64
+#include <immintrin.h>
+#endif
+
+// Bytes each of the three interleaved crc32 streams covers per iteration
+#define GCI_CRC32C_STRIDE 256
+
+typedef uint32_t (GciCrc32c)(uint32_t crc, char const *data, size_t data_size);
+
+uint32_t gci_crc32c_scalar(uint32_t crc, char const *data, size_t data_size);
+#ifdef GCI_CHECKSUM_X86_64
+uint32_t gci_crc32c_sse42(uint32_t crc, char const *data, size_t data_size);
+#endif
+GciCrc32c *gci_crc32c_kernel(enum GciSimd simd);
+void gci_crc32c_tables_init(void);
+uint32_t gci_crc32c_shift(uint32_t state);
+uint64_t gci_checksum_load64(unsigned char const *data);
+uint32_t gci_checksum_load32(unsigned char const *data);
+uint64_t gci_xxh64_rotl(uint64_t value, unsigned amount);
+uint64_t gci_xxh64_round(uint64_t lane, uint64_t input);
+uint64_t gci_xxh64_merge(uint64_t hash, uint64_t lane);
+size_t gci_reader_checksum_read(void const *context, char *buffer, size_t buffer_size);
+bool gci_reader_checksum_eof(void const *context);
+size_t gci_reader_checksum_peek(void const *context, char const **data);
+void gci_reader_checksum_consume(void const *context, size_t amount);
+size_t gci_reader_checksum_read_at(void const *context, char *buffer, size_t buffer_size, uint64_t offset);
+size_t gci_writer_checksum_write(void const *context, char const *data, size_t data_size);
+char *gci_writer_checksum_reserve(void const *context, size_t size);
+size_t gci_writer_checksum_commit(void const *context, size_t size);
+size_t gci_writer_checksum_writev(void const *context, struct GciIovec const *vectors, size_t vector_count);
+
+// Resolved on first use, racing threads resolve it to the same value
+GciCrc32c *gci_crc32c_best = NULL;
+
+// Slicing-by-8 tables of the reflected Castagnoli polynomial, and the tables
+// advancing a crc state over `GCI_CRC32C_STRIDE` zero bytes
+pthread_once_t gci_crc32c_tables_once = PTHREAD_ONCE_INIT;
+uint32_t gci_crc32c_table[8][256];
+uint32_t gci_crc32c_shift_table[4][256];
+
+uint32_t gci_crc32c(uint32_t crc, char const *data, size_t data_size) {
+    GciCrc32c *kernel = __atomic_load_n(&gci_crc32c_best, __ATOMIC_RELAXED);
+    if (kernel == NULL) {
+        kernel = gci_crc32c_kernel(gci_simd_supported());
+        __atomic_store_n(&gci_crc32c_best, kernel, __ATOMIC_RELAXED);
+    }
+    return kernel(crc, data, data_size);
+}
+
+uint32_t gci_crc32c_simd(enum GciSimd simd, uint32_t crc, char const *data, size_t data_size) {
+    enum GciSimd supported = gci_simd_supported();
+    return gci_crc32c_kernel(simd < supported ? simd : supported)(crc, data, data_size);
+}
+
+GciCrc32c *gci_crc32c_kernel(enum GciSimd simd) {
+#ifdef GCI_CHECKSUM_X86_64
+    if (simd >= GCI_SIMD_SSE42) { return gci_crc32c_sse42; }
+#endif
+    (void) simd;
+    return gci_crc32c_scalar;
+}
+
+void gci_crc32c_tables_init(void) {
+    for (uint32_t index = 0; index < 256; index++) {
+        uint32_t crc = index;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) != 0 ? (crc >> 1) ^ 0x82f63b78u : crc >> 1;
+        }
+        gci_crc32c_table[0][index] = crc;
+    }
+    for (size_t slice = 1; slice < 8; slice++) {
+        for (size_t index = 0; index < 256; index++) {
+            uint32_t previous = gci_crc32c_table[slice - 1][index];
+            gci_crc32c_table[slice][index] = (previous >> 8) ^ gci_crc32c_table[0][previous & 0xff];
+        }
+    }
+
+    // Advancing a state over zero bytes is linear, so the image of every
+    // byte value is the xor of the images of its bits
+    uint32_t images[32];
+    for (unsigned bit = 0; bit < 32; bit++) {
+        uint32_t state = UINT32_C(1) << bit;
+        for (size_t index = 0; index < GCI_CRC32C_STRIDE; index++) {
+            state = gci_crc32c_table[0][state & 0xff] ^ (state >> 8);
+        }
+        images[bit] = state;
+    }
+    for (unsigned slice = 0; slice < 4; slice++) {
+        for (unsigned index = 0; index < 256; index++) {
+            uint32_t state = 0;
+            for (unsigned bit = 0; bit < 8; bit++) {
+                if ((index >> bit) & 1) { state ^= images[8 * slice + bit]; }
+            }
+            gci_crc32c_shift_table[slice][index] = state;
+        }
+    }
+}
+
+uint32_t gci_crc32c_shift(uint32_t state) {
+    return gci_crc32c_shift_table[0][state & 0xff]
+        ^ gci_crc32c_shift_table[1][(state >> 8) & 0xff]
+        ^ gci_crc32c_shift_table[2][(state >> 16) & 0xff]
+        ^ gci_crc32c_shift_table[3][state >> 24];
+}
+
+uint32_t gci_crc32c_scalar(uint32_t crc, char const *data, size_t data_size) {
+    assert(data != NULL || data_size == 0);
+    pthread_once(&gci_crc32c_tables_once, gci_crc32c_tables_init);
+
+    unsigned char const *bytes = (unsigned char const*) data;
+    uint32_t state = ~crc;
+    for (; data_size >= 8; data_size -= 8, bytes += 8) {
+        uint32_t low = state ^ gci_checksum_load32(bytes);
+        uint32_t high = gci_checksum_load32(bytes + 4);
+        state = gci_crc32c_table[7][low & 0xff]
+            ^ gci_crc32c_table[6][(low >> 8) & 0xff]
+            ^ gci_crc32c_table[5][(low >> 16) & 0xff]
+            ^ gci_crc32c_table[4][low >> 24]
+            ^ gci_crc32c_table[3][high & 0xff]
+            ^ gci_crc32c_table[2][(high >> 8) & 0xff]
+            ^ gci_crc32c_table[1][(high >> 16) & 0xff]
+            ^ gci_crc32c_table[0][high >> 24];
+    }
+    for (; data_size > 0; data_size--, bytes++) {
+        state = gci_crc32c_table[0][(state ^ *bytes) & 0xff] ^ (state >> 8);
+    }
+    return ~state;
+}
+
+#ifdef GCI_CHECKSUM_X86_64
+// The crc32 instruction has a latency of three cycles but a throughput of
+// one, so three independent streams are computed at once and combined by
+// advancing the earlier ones over the bytes of the later ones.
+__attribute__((target("sse4.2")))
+uint32_t gci_crc32c_sse42(uint32_t crc, char const *data, size_t data_size) {
+    assert(data != NULL || data_size == 0);
+
+    unsigned char const *bytes = (unsigned char const*) data;
+    uint64_t state = (uint32_t) ~crc;
+    if (data_size >= 3 * GCI_CRC32C_STRIDE) {
+        pthread_once(&gci_crc32c_tables_once, gci_crc32c_tables_init);
+    }
+    for (; data_size >= 3 * GCI_CRC32C_STRIDE; data_size -= 3 * GCI_CRC32C_STRIDE) {
+        uint64_t state1 = state;
+        uint64_t state2 = 0;
+        uint64_t state3 = 0;
+        for (size_t index = 0; index < GCI_CRC32C_STRIDE; index += 8) {
+            state1 = _mm_crc32_u64(state1, gci_checksum_load64(bytes + index));
+            state2 = _mm_crc32_u64(state2, gci_checksum_load64(bytes + GCI_CRC32C_STRIDE + index));
+            state3 = _mm_crc32_u64(state3, gci_checksum_load64(bytes + 2 * GCI_CRC32C_STRIDE + index));
+        }
+        state = gci_crc32c_shift(gci_crc32c_shift((uint32_t) state1) ^ (uint32_t) state2) ^ (uint32_t) state3;
+        bytes += 3 * GCI_CRC32C_STRIDE;
+    }
+
+    for (; data_size >= 8; data_size -= 8, bytes += 8) {
+        state = _mm_crc32_u64(state, gci_checksum_load64(bytes));
+    }
+    uint32_t state32 = (uint32_t) state;
+    for (; data_size > 0; data_size--, bytes++) {
+        state32 = _mm_crc32_u8(state32, *bytes);
+    }
+    return ~state32;
+}
+#endif
+
+#define GCI_XXH64_PRIME1 UINT64_C(0x9e3779b185ebca87)
+#define GCI_XXH64_PRIME2 UINT64_C(0xc2b2ae3d27d4eb4f)
+#define GCI_XXH64_PRIME3 UINT64_C(0x165667b19e3779f9)
+#define GCI_XXH64_PRIME4 UINT64_C(0x85ebca77c2b2ae63)
+#define GCI_XXH64_PRIME5 UINT64_C(0x27d4eb2f165667c5)
+
+void gci_xxh64_init(struct GciXxh64 *state, uint64_t seed) {
+    assert(state != NULL);
+    state->seed = seed;
+    state->total = 0;
+    state->lanes[0] = seed + GCI_XXH64_PRIME1 + GCI_XXH64_PRIME2;
+    state->lanes[1] = seed + GCI_XXH64_PRIME2;
+    state->lanes[2] = seed;
+    state->lanes[3] = seed - GCI_XXH64_PRIME1;
+    state->pending_size = 0;
+}
+
+void gci_xxh64_update(struct GciXxh64 *state, char const *data, size_t data_size) {
+    assert(state != NULL);
+    assert(data != NULL || data_size == 0);
+
+    unsigned char const *bytes = (unsigned char const*) data;
+    state->total += data_size;
+
+    if (state->pending_size > 0) {
+        size_t take = sizeof(state->pending) - state->pending_size;
+        take = take < data_size ? take : data_size;
+        memcpy(state->pending + state->pending_size, bytes, take);
+        state->pending_size += take;
+        bytes += take;
+        data_size -= take;
+
+        if (state->pending_size < sizeof(state->pending)) { return; }
+        for (size_t lane = 0; lane < 4; lane++) {
+            state->lanes[lane] = gci_xxh64_round(state->lanes[lane], gci_checksum_load64(state->pending + 8 * lane));
+        }
+        state->pending_size = 0;
+    }
+
+    uint64_t lanes[4] = { state->lanes[0], state->lanes[1], state->lanes[2], state->lanes[3] };
+    for (; data_size >= 32; data_size -= 32, bytes += 32) {
+        lanes[0] = gci_xxh64_round(lanes[0], gci_checksum_load64(bytes));
+        lanes[1] = gci_xxh64_round(lanes[1], gci_checksum_load64(bytes + 8));
+        lanes[2] = gci_xxh64_round(lanes[2], gci_checksum_load64(bytes + 16));
+        lanes[3] = gci_xxh64_round(lanes[3], gci_checksum_load64(bytes + 24));
+    }
+    memcpy(state->lanes, lanes, sizeof(lanes));
+
+    if (data_size > 0) {
+        memcpy(state->pending, bytes, data_size);
+        state->pending_size = data_size;
+    }
+}
+
+uint64_t gci_xxh64_digest(struct GciXxh64 const *state) {
+    assert(state != NULL);
+
+    uint64_t hash;
+    if (state->total >= 32) {
+        hash = gci_xxh64_rotl(state->lanes[0], 1) + gci_xxh64_rotl(state->lanes[1], 7)
+            + gci_xxh64_rotl(state->lanes[2], 12) + gci_xxh64_rotl(state->lanes[3], 18);
+        for (size_t lane = 0; lane < 4; lane++) {
+            hash = gci_xxh64_merge(hash, state->lanes[lane]);
+        }
+    } else {
+        hash = state->seed + GCI_XXH64_PRIME5;
+    }
+    hash += state->total;
+
+    unsigned char const *bytes = state->pending;
+    size_t size = state->pending_size;
+    for (; size >= 8; size -= 8, bytes += 8) {
+        hash ^= gci_xxh64_round(0, gci_checksum_load64(bytes));
+        hash = gci_xxh64_rotl(hash, 27) * GCI_XXH64_PRIME1 + GCI_XXH64_PRIME4;
+    }
+    if (size >= 4) {
+        hash ^= (uint64_t) gci_checksum_load32(bytes) * GCI_XXH64_PRIME1;
+        hash = gci_xxh64_rotl(hash, 23) * GCI_XXH64_PRIME2 + GCI_XXH64_PRIME3;
+        size -= 4;
+        bytes += 4;
+    }
+    for (; size > 0; size--, bytes++) {
+        hash ^= *bytes * GCI_XXH64_PRIME5;
+        hash = gci_xxh64_rotl(hash, 11) * GCI_XXH64_PRIME1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= GCI_XXH64_PRIME2;
+    hash ^= hash >> 29;
+    hash *= GCI_XXH64_PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t gci_checksum_load64(unsigned char const *data) {
+    return (uint64_t) gci_checksum_load32(data) | (uint64_t) gci_checksum_load32(data + 4) << 32;
+}
+
+uint32_t gci_checksum_load32(unsigned char const *data) {
+    return (uint32_t) data[0] | (uint32_t) data[1] << 8 | (uint32_t) data[2] << 16 | (uint32_t) data[3] << 24;
+}
+
+uint64_t gci_xxh64_rotl(uint64_t value, unsigned amount) {
+    return (value << amount) | (value >> (64 - amount));
+}
+
+uint64_t gci_xxh64_round(uint64_t lane, uint64_t input) {
+    lane += input * GCI_XXH64_PRIME2;
+    lane = gci_xxh64_rotl(lane, 31);
+    return lane * GCI_XXH64_PRIME1;
+}
+
+uint64_t gci_xxh64_merge(uint64_t hash, uint64_t lane) {
+    hash ^= gci_xxh64_round(0, lane);
+    return hash * GCI_XXH64_PRIME1 + GCI_XXH64_PRIME4;
+}
+
+void gci_checksum_init(struct GciChecksum *checksum, unsigned algorithms) {
+    assert(checksum != NULL);
+    checksum->algorithms = algorithms;
+    checksum->crc32c = 0;
+    gci_xxh64_init(&checksum->xxh64, 0);
+}
+
+void gci_checksum_update(struct GciChecksum *checksum, char const *data, size_t data_size) {
+    assert(checksum != NULL);
+    if (checksum->algorithms & GCI_CHECKSUM_CRC32C) {
+        checksum->crc32c = gci_crc32c(checksum->crc32c, data, data_size);
+    }
+    if (checksum->algorithms & GCI_CHECKSUM_XXH64) {
+        gci_xxh64_update(&checksum->xxh64, data, data_size);
+    }
+}
+
+uint32_t gci_checksum_crc32c(struct GciChecksum const *checksum) {
+    assert(checksum != NULL);
+    return checksum->crc32c;
+}
+
+uint64_t gci_checksum_xxh64(struct GciChecksum const *checksum) {
+    assert(checksum != NULL);
+    return gci_xxh64_digest(&checksum->xxh64);
+}
+
+enum GciError gci_reader_checksum_init(struct GciReaderChecksum *context, struct GciInterfaceReader reader, unsigned algorithms) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->reader = reader;
+    gci_checksum_init(&context->checksum, algorithms);
+    context->peeked = NULL;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceReader gci_reader_checksum_interface(struct GciReaderChecksum *context) {
+    assert(context != NULL);
+    bool peek = context->reader.peek != NULL;
+    return (struct GciInterfaceReader) {
+        .context = context,
+        .read = gci_reader_checksum_read,
+        .eof = gci_reader_checksum_eof,
+        .peek = peek ? gci_reader_checksum_peek : NULL,
+        .consume = peek ? gci_reader_checksum_consume : NULL,
+        .read_at = context->reader.read_at != NULL ? gci_reader_checksum_read_at : NULL,
+    };
+}
+
+size_t gci_reader_checksum_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    struct GciReaderChecksum *context = (struct GciReaderChecksum*) void_context;
+
+    size_t length = gci_reader_read(context->reader, buffer, buffer_size);
+    gci_checksum_update(&context->checksum, buffer, length);
+    return length;
+}
+
+bool gci_reader_checksum_eof(void const *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderChecksum *context = (struct GciReaderChecksum*) void_context;
+    return gci_reader_eof(context->reader);
+}
+
+size_t gci_reader_checksum_peek(void const *void_context, char const **data) {
+    assert(void_context != NULL);
+    struct GciReaderChecksum *context = (struct GciReaderChecksum*) void_context;
+
+    // Bytes are checksummed once consumed
+    size_t length = context->reader.peek(context->reader.context, data);
+    context->peeked = *data;
+    return length;
+}
+
+void gci_reader_checksum_consume(void const *void_context, size_t amount) {
+    assert(void_context != NULL);
+    struct GciReaderChecksum *context = (struct GciReaderChecksum*) void_context;
+    assert(context->peeked != NULL || amount == 0);
+
+    gci_checksum_update(&context->checksum, context->peeked, amount);
+    context->reader.consume(context->reader.context, amount);
+    if (amount > 0) {
+        context->peeked += amount;
+    }
+}
+
+size_t gci_reader_checksum_read_at(void const *void_context, char *buffer, size_t buffer_size, uint64_t offset) {
+    assert(void_context != NULL);
+    struct GciReaderChecksum *context = (struct GciReaderChecksum*) void_context;
+
+    // The checksum covers the bytes in the order they are read, bytes read
+    // from an offset are not part of that stream
+    return gci_reader_read_at(context->reader, buffer, buffer_size, offset);
+}
+
+enum GciError gci_writer_checksum_init(struct GciWriterChecksum *context, struct GciInterfaceWriter writer, unsigned algorithms) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->writer = writer;
+    gci_checksum_init(&context->checksum, algorithms);
+    context->reserved = NULL;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceWriter gci_writer_checksum_interface(struct GciWriterChecksum *context) {
+    assert(context != NULL);
+    bool reserve = context->writer.reserve != NULL;
+    bool writev = context->writer.writev != NULL;
+    return (struct GciInterfaceWriter) {
+        .context = context,
+        .write = gci_writer_checksum_write,
+        .reserve = reserve ? gci_writer_checksum_reserve : NULL,
+        .commit = reserve ? gci_writer_checksum_commit : NULL,
+        .writev = writev ? gci_writer_checksum_writev : NULL,
+    };
+}
+
+size_t gci_writer_checksum_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    struct GciWriterChecksum *context = (struct GciWriterChecksum*) void_context;
+
+    size_t length = gci_writer_write(context->writer, data, data_size);
+    gci_checksum_update(&context->checksum, data, length);
+    return length;
+}
+
+char *gci_writer_checksum_reserve(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterChecksum *context = (struct GciWriterChecksum*) void_context;
+
+    char *reserved = context->writer.reserve(context->writer.context, size);
+    context->reserved = reserved;
+    return reserved;
+}
+
+size_t gci_writer_checksum_commit(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterChecksum *context = (struct GciWriterChecksum*) void_context;
+    assert(context->reserved != NULL);
+
+    // The reservation may be reused once committed so it is checksummed first
+    gci_checksum_update(&context->checksum, context->reserved, size);
+    context->reserved = NULL;
+    return context->writer.commit(context->writer.context, size);
+}
+
+size_t gci_writer_checksum_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count) {
+    assert(void_context != NULL);
+    struct GciWriterChecksum *context = (struct GciWriterChecksum*) void_context;
+
+    size_t length = gci_writer_writev(context->writer, vectors, vector_count);
+
+    size_t remaining = length;
+    for (size_t index = 0; index < vector_count && remaining > 0; index++) {
+        size_t size = vectors[index].data_size < remaining ? vectors[index].data_size : remaining;
+        gci_checksum_update(&context->checksum, vectors[index].data, size);
+        remaining -= size;
+    }
+    return length;
+}
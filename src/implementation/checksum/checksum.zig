@@ -0,0 +1,135 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const reader = @import("../reader/reader.zig");
+const writer = @import("../writer/writer.zig");
+const InterfaceReader = reader.InterfaceReader;
+const InterfaceWriter = writer.InterfaceWriter;
+
+pub const crc32c_algorithm: c_uint = lib.GCI_CHECKSUM_CRC32C;
+pub const xxh64_algorithm: c_uint = lib.GCI_CHECKSUM_XXH64;
+
+pub fn crc32c(crc: u32, data: []const u8) u32 {
+    return lib.gci_crc32c(crc, data.ptr, data.len);
+}
+
+pub const Xxh64 = struct {
+    inner: lib.GciXxh64,
+
+    pub fn init(seed: u64) Xxh64 {
+        var self: Xxh64 = undefined;
+        lib.gci_xxh64_init(&self.inner, seed);
+        return self;
+    }
+
+    pub fn update(self: *Xxh64, data: []const u8) void {
+        lib.gci_xxh64_update(&self.inner, data.ptr, data.len);
+    }
+
+    pub fn digest(self: *const Xxh64) u64 {
+        return lib.gci_xxh64_digest(&self.inner);
+    }
+};
+
+pub const Reader = struct {
+    inner: lib.GciReaderChecksum,
+
+    pub fn init(r: InterfaceReader, algorithms: c_uint) !Reader {
+        var self: Reader = undefined;
+        const err = lib.gci_reader_checksum_init(&self.inner, r.reader, algorithms);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Reader) InterfaceReader {
+        return .{ .reader = lib.gci_reader_checksum_interface(&self.inner) };
+    }
+
+    pub fn digestCrc32c(self: *const Reader) u32 {
+        return lib.gci_checksum_crc32c(&self.inner.checksum);
+    }
+
+    pub fn digestXxh64(self: *const Reader) u64 {
+        return lib.gci_checksum_xxh64(&self.inner.checksum);
+    }
+};
+
+pub const Writer = struct {
+    inner: lib.GciWriterChecksum,
+
+    pub fn init(w: InterfaceWriter, algorithms: c_uint) !Writer {
+        var self: Writer = undefined;
+        const err = lib.gci_writer_checksum_init(&self.inner, w.writer, algorithms);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Writer) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_checksum_interface(&self.inner) };
+    }
+
+    pub fn digestCrc32c(self: *const Writer) u32 {
+        return lib.gci_checksum_crc32c(&self.inner.checksum);
+    }
+
+    pub fn digestXxh64(self: *const Writer) u64 {
+        return lib.gci_checksum_xxh64(&self.inner.checksum);
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_checksum.zig");
+}
+
+test "crc32c check value" {
+    try testing.expectEqual(0xe3069283, crc32c(0, "123456789"));
+}
+
+test "crc32c matches std" {
+    var data: [4000]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = @truncate(index *% 131 +% 7);
+    }
+
+    for ([_]usize{ 0, 1, 7, 8, 767, 768, 769, 2000, data.len }) |size| {
+        const expected = std.hash.crc.Crc32Iscsi.hash(data[0..size]);
+        try testing.expectEqual(expected, crc32c(0, data[0..size]));
+        try testing.expectEqual(expected, crc32c(crc32c(0, data[0 .. size / 3]), data[size / 3 .. size]));
+    }
+}
+
+test "xxh64 matches std" {
+    var data: [300]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = @truncate(index *% 31 +% 1);
+    }
+
+    for ([_]usize{ 0, 1, 3, 4, 8, 31, 32, 33, 100, data.len }) |size| {
+        var state = Xxh64.init(7);
+        var index: usize = 0;
+        while (index < size) : (index += 5) {
+            state.update(data[index..@min(index + 5, size)]);
+        }
+        try testing.expectEqual(std.hash.XxHash64.hash(7, data[0..size]), state.digest());
+    }
+}
+
+test "checksum writer and reader" {
+    var buffer: [9]u8 = undefined;
+    var string = try writer.String.init(&buffer);
+    var context = try Writer.init(string.interface(), crc32c_algorithm | xxh64_algorithm);
+    try context.interface().write("123456789");
+    try testing.expectEqual(0xe3069283, context.digestCrc32c());
+
+    var source = try reader.String.init(&buffer);
+    var checked = try Reader.init(source.interface(), crc32c_algorithm | xxh64_algorithm);
+    const r = checked.interface();
+
+    var scratch: [0]u8 = undefined;
+    const view = try r.peek(&scratch);
+    r.consume(view, view.len);
+    try testing.expectEqual(context.digestCrc32c(), checked.digestCrc32c());
+    try testing.expectEqual(context.digestXxh64(), checked.digestXxh64());
+}
@@ -0,0 +1,116 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "crc32c" {
+    const crc = lib.gci_crc32c(0, "123456789", 9);
+    try testing.expectEqual(0xe3069283, crc);
+}
+
+test "crc32c every level" {
+    var data: [2000]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = @truncate(index *% 131 +% 7);
+    }
+
+    const expected = lib.gci_crc32c_simd(lib.GCI_SIMD_SCALAR, 0, &data, data.len);
+    const crc = lib.gci_crc32c_simd(lib.GCI_SIMD_AVX2, 0, &data, data.len);
+    try testing.expectEqual(expected, crc);
+}
+
+test "xxh64" {
+    var state: lib.GciXxh64 = undefined;
+    lib.gci_xxh64_init(&state, 0);
+    try testing.expectEqual(0xef46db3751d8e999, lib.gci_xxh64_digest(&state));
+
+    lib.gci_xxh64_update(&state, "a", 1);
+    try testing.expectEqual(0xd24ec4f1a98c6e5b, lib.gci_xxh64_digest(&state));
+
+    lib.gci_xxh64_init(&state, 0);
+    lib.gci_xxh64_update(&state, "abc", 3);
+    try testing.expectEqual(0x44bc2cf5ad770999, lib.gci_xxh64_digest(&state));
+}
+
+test "reader init null" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "1", 1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    const init_err = lib.gci_reader_checksum_init(null, lib.gci_reader_string_interface(&c), lib.GCI_CHECKSUM_CRC32C);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "reader read" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "123456789", 9);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderChecksum = undefined;
+    const init_err = lib.gci_reader_checksum_init(&context, lib.gci_reader_string_interface(&c), lib.GCI_CHECKSUM_CRC32C);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_checksum_interface(&context);
+
+    var buffer: [4]u8 = undefined;
+    const length1 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(4, length1);
+
+    var view: [*c]const u8 = undefined;
+    const length2 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(5, length2);
+    lib.gci_reader_consume(reader, length2, 2);
+    lib.gci_reader_consume(reader, length2 - 2, 3);
+
+    try testing.expectEqual(0xe3069283, lib.gci_checksum_crc32c(&context.checksum));
+}
+
+test "reader read at" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "123456789", 9);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderChecksum = undefined;
+    const init_err = lib.gci_reader_checksum_init(&context, lib.gci_reader_string_interface(&c), lib.GCI_CHECKSUM_CRC32C);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_checksum_interface(&context);
+    try testing.expect(reader.read_at != null);
+
+    var buffer: [9]u8 = undefined;
+    const length1 = lib.gci_reader_read_at(reader, &buffer, 4, 5);
+    try testing.expectEqual(4, length1);
+    try testing.expectEqualStrings("6789", buffer[0..4]);
+    try testing.expectEqual(0, lib.gci_checksum_crc32c(&context.checksum));
+
+    const length2 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(9, length2);
+    try testing.expectEqual(0xe3069283, lib.gci_checksum_crc32c(&context.checksum));
+}
+
+test "writer init null" {
+    var c: lib.GciWriterString = undefined;
+    const init_err = lib.gci_writer_checksum_init(null, lib.gci_writer_string_interface(&c), lib.GCI_CHECKSUM_CRC32C);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "writer reserve commit" {
+    var b: [9]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const c_err = lib.gci_writer_string_init(&c, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), c_err);
+
+    var context: lib.GciWriterChecksum = undefined;
+    const init_err = lib.gci_writer_checksum_init(&context, lib.gci_writer_string_interface(&c), lib.GCI_CHECKSUM_CRC32C);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const writer = lib.gci_writer_checksum_interface(&context);
+
+    const res1 = lib.gci_writer_write(writer, "1234", 4);
+    try testing.expectEqual(4, res1);
+
+    const reserved = lib.gci_writer_reserve(writer, 5, null, 0);
+    try testing.expect(reserved != null);
+    @memcpy(reserved[0..5], "56789");
+    const res2 = lib.gci_writer_commit(writer, reserved, 5, null);
+    try testing.expectEqual(5, res2);
+
+    try testing.expectEqualStrings("123456789", &b);
+    try testing.expectEqual(0xe3069283, lib.gci_checksum_crc32c(&context.checksum));
+}
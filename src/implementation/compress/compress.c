@@ -0,0 +1,775 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <assert.h>
+#include <string.h>
+#include <gci_compress.h>
+
+#define GCI_COMPRESS_MAGIC "GCIZ"
+#define GCI_COMPRESS_RAW 0x80000000u
+#define GCI_COMPRESS_MATCH_MIN 4
+// Matches end this many bytes before the end of a block and the last one
+// starts at least `GCI_COMPRESS_MATCH_LIMIT` bytes before it
+#define GCI_COMPRESS_LAST_LITERALS 5
+#define GCI_COMPRESS_MATCH_LIMIT 12
+
+uint32_t gci_compress_load32(char const *data);
+uint32_t gci_compress_read32(char const *data);
+void gci_compress_write32(char *data, uint32_t value);
+uint32_t gci_compress_hash(uint32_t value);
+char *gci_compress_length(char *output, size_t length);
+size_t gci_writer_compress_write(void const *context, char const *data, size_t data_size);
+char *gci_writer_compress_reserve(void const *context, size_t size);
+size_t gci_writer_compress_commit(void const *context, size_t size);
+bool gci_writer_compress_block(struct GciWriterCompress *context, char const *data, size_t data_size);
+bool gci_compress_emit(
+    struct GciInterfaceWriter writer,
+    bool *started,
+    size_t block_size,
+    char const *data,
+    size_t data_size,
+    char const *compressed,
+    size_t compressed_size
+);
+bool gci_compress_end(struct GciInterfaceWriter writer, bool *started, size_t block_size);
+size_t gci_writer_compress_parallel_write(void const *context, char const *data, size_t data_size);
+void *gci_writer_compress_parallel_run(void *context);
+void gci_writer_compress_parallel_submit(struct GciWriterCompressParallel *context);
+void gci_writer_compress_parallel_collect(struct GciWriterCompressParallel *context, size_t keep);
+size_t gci_reader_decompress_read(void const *context, char *buffer, size_t buffer_size);
+bool gci_reader_decompress_eof(void const *context);
+size_t gci_reader_decompress_peek(void const *context, char const **data);
+void gci_reader_decompress_consume(void const *context, size_t amount);
+bool gci_reader_decompress_next(struct GciReaderDecompress *context);
+
+size_t gci_compress_block(
+        uint16_t *table,
+        char const *data,
+        size_t data_size,
+        char *output,
+        size_t output_size
+) {
+    assert(table != NULL);
+    assert(data != NULL || data_size == 0);
+    assert(output != NULL);
+    assert(data_size <= GCI_COMPRESS_BLOCK_MAX);
+
+    char *out = output;
+    char *const out_end = output + output_size;
+    size_t anchor = 0;
+
+    if (data_size > GCI_COMPRESS_MATCH_LIMIT) {
+        memset(table, 0, GCI_COMPRESS_TABLE_SIZE * sizeof(*table));
+
+        size_t const match_limit = data_size - GCI_COMPRESS_MATCH_LIMIT;
+        size_t const extend_limit = data_size - GCI_COMPRESS_LAST_LITERALS;
+        size_t position = 0;
+        size_t misses = 0;
+
+        while (position < match_limit) {
+            uint32_t value = gci_compress_load32(data + position);
+            uint32_t hash = gci_compress_hash(value);
+            size_t candidate = table[hash];
+            table[hash] = (uint16_t) position;
+
+            if (candidate >= position || gci_compress_load32(data + candidate) != value) {
+                // Skip faster through data which does not compress
+                position += 1 + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+
+            while (position > anchor && candidate > 0 && data[position - 1] == data[candidate - 1]) {
+                position--;
+                candidate--;
+            }
+            size_t match = GCI_COMPRESS_MATCH_MIN;
+            while (position + match < extend_limit && data[candidate + match] == data[position + match]) {
+                match++;
+            }
+
+            size_t literals = position - anchor;
+            if ((size_t) (out_end - out) < 1 + literals / 255 + 1 + literals + 2 + match / 255 + 1) {
+                return 0;
+            }
+
+            char *token = out++;
+            size_t match_code = match - GCI_COMPRESS_MATCH_MIN;
+            *token = (char) ((literals < 15 ? literals : 15) << 4 | (match_code < 15 ? match_code : 15));
+            if (literals >= 15) { out = gci_compress_length(out, literals - 15); }
+            memcpy(out, data + anchor, literals);
+            out += literals;
+
+            size_t offset = position - candidate;
+            *out++ = (char) (offset & 0xff);
+            *out++ = (char) (offset >> 8);
+            if (match_code >= 15) { out = gci_compress_length(out, match_code - 15); }
+
+            position += match;
+            anchor = position;
+            if (position < match_limit) {
+                table[gci_compress_hash(gci_compress_load32(data + position - 2))] = (uint16_t) (position - 2);
+            }
+        }
+    }
+
+    size_t literals = data_size - anchor;
+    if ((size_t) (out_end - out) < 1 + literals / 255 + 1 + literals) {
+        return 0;
+    }
+    *out++ = (char) ((literals < 15 ? literals : 15) << 4);
+    if (literals >= 15) { out = gci_compress_length(out, literals - 15); }
+    memcpy(out, data + anchor, literals);
+    out += literals;
+
+    return (size_t) (out - output);
+}
+
+bool gci_decompress_block(
+        char const *block,
+        size_t block_size,
+        char *output,
+        size_t output_size,
+        size_t *length
+) {
+    assert(block != NULL || block_size == 0);
+    assert(output != NULL || output_size == 0);
+    assert(length != NULL);
+
+    unsigned char const *in = (unsigned char const*) block;
+    unsigned char const *const in_end = in + block_size;
+    size_t out = 0;
+
+    while (in < in_end) {
+        unsigned token = *in++;
+
+        size_t literals = token >> 4;
+        if (literals == 15) {
+            unsigned byte;
+            do {
+                if (in >= in_end) { return false; }
+                byte = *in++;
+                literals += byte;
+            } while (byte == 255 && literals <= output_size);
+        }
+        if (literals > (size_t) (in_end - in) || literals > output_size - out) { return false; }
+        memcpy(output + out, in, literals);
+        in += literals;
+        out += literals;
+
+        // The last sequence has no match
+        if (in == in_end) { break; }
+
+        if (in_end - in < 2) { return false; }
+        size_t offset = (size_t) in[0] | (size_t) in[1] << 8;
+        in += 2;
+        if (offset == 0 || offset > out) { return false; }
+
+        size_t match = token & 15;
+        if (match == 15) {
+            unsigned byte;
+            do {
+                if (in >= in_end) { return false; }
+                byte = *in++;
+                match += byte;
+            } while (byte == 255 && match <= output_size);
+        }
+        match += GCI_COMPRESS_MATCH_MIN;
+        if (match > output_size - out) { return false; }
+
+        // Overlapping matches repeat the bytes just written
+        char *destination = output + out;
+        char const *source = destination - offset;
+        if (offset >= match) {
+            memcpy(destination, source, match);
+        } else {
+            for (size_t index = 0; index < match; index++) {
+                destination[index] = source[index];
+            }
+        }
+        out += match;
+    }
+
+    *length = out;
+    return true;
+}
+
+uint32_t gci_compress_load32(char const *data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint32_t gci_compress_read32(char const *data) {
+    unsigned char const *bytes = (unsigned char const*) data;
+    return (uint32_t) bytes[0] | (uint32_t) bytes[1] << 8 | (uint32_t) bytes[2] << 16 | (uint32_t) bytes[3] << 24;
+}
+
+void gci_compress_write32(char *data, uint32_t value) {
+    data[0] = (char) (value & 0xff);
+    data[1] = (char) ((value >> 8) & 0xff);
+    data[2] = (char) ((value >> 16) & 0xff);
+    data[3] = (char) (value >> 24);
+}
+
+uint32_t gci_compress_hash(uint32_t value) {
+    // Fibonacci hashing down to the 13 bits indexing the table
+    return (value * 2654435761u) >> (32 - 13);
+}
+
+char *gci_compress_length(char *output, size_t length) {
+    for (; length >= 255; length -= 255) {
+        *output++ = (char) 255;
+    }
+    *output++ = (char) length;
+    return output;
+}
+
+enum GciError gci_writer_compress_init(
+        struct GciWriterCompress *context,
+        struct GciInterfaceWriter writer,
+        char *buffer,
+        size_t buffer_size
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (buffer == NULL) { return GCI_ERROR_NULL; }
+    if (buffer_size < 2 * GCI_COMPRESS_BLOCK_MIN) { return GCI_ERROR_BUFFER; }
+
+    size_t block_size = buffer_size / 2;
+    block_size = block_size < GCI_COMPRESS_BLOCK_MAX ? block_size : GCI_COMPRESS_BLOCK_MAX;
+
+    context->writer = writer;
+    context->buffer = buffer;
+    context->block_size = block_size;
+    context->output = buffer + block_size;
+    context->output_size = buffer_size - block_size;
+    context->current = 0;
+    context->started = false;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceWriter gci_writer_compress_interface(struct GciWriterCompress *context) {
+    assert(context != NULL);
+    return (struct GciInterfaceWriter) {
+        .context = context,
+        .write = gci_writer_compress_write,
+        .reserve = gci_writer_compress_reserve,
+        .commit = gci_writer_compress_commit,
+    };
+}
+
+bool gci_writer_compress_flush(struct GciWriterCompress *context) {
+    assert(context != NULL);
+    if (context->current == 0) { return true; }
+
+    bool result = gci_writer_compress_block(context, context->buffer, context->current);
+    context->current = 0;
+    return result;
+}
+
+bool gci_writer_compress_finish(struct GciWriterCompress *context) {
+    assert(context != NULL);
+    if (!gci_writer_compress_flush(context)) { return false; }
+    return gci_compress_end(context->writer, &context->started, context->block_size);
+}
+
+size_t gci_writer_compress_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciWriterCompress *context = (struct GciWriterCompress*) void_context;
+    assert(context->current < context->block_size);
+
+    size_t write_length = 0;
+    while (write_length < data_size) {
+        size_t left = data_size - write_length;
+
+        // Whole blocks are compressed straight from `data`
+        if (context->current == 0 && left >= context->block_size) {
+            bool success = gci_writer_compress_block(context, data + write_length, context->block_size);
+            if (!success) { break; }
+            write_length += context->block_size;
+            continue;
+        }
+
+        size_t take = context->block_size - context->current;
+        take = take < left ? take : left;
+        memcpy(context->buffer + context->current, data + write_length, take);
+        context->current += take;
+
+        if (context->current >= context->block_size) {
+            bool success = gci_writer_compress_flush(context);
+            if (!success) { break; }
+        }
+        write_length += take;
+    }
+    return write_length;
+}
+
+char *gci_writer_compress_reserve(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterCompress *context = (struct GciWriterCompress*) void_context;
+    assert(context->current < context->block_size);
+
+    if (size > context->block_size) {
+        return NULL;
+    }
+
+    if (context->block_size - context->current < size) {
+        bool flush_success = gci_writer_compress_flush(context);
+        if (!flush_success) { return NULL; }
+    }
+    return context->buffer + context->current;
+}
+
+size_t gci_writer_compress_commit(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterCompress *context = (struct GciWriterCompress*) void_context;
+    assert(size <= context->block_size - context->current);
+
+    context->current += size;
+    if (context->current >= context->block_size) {
+        bool flush_success = gci_writer_compress_flush(context);
+        if (!flush_success) { return 0; }
+    }
+    return size;
+}
+
+bool gci_writer_compress_block(struct GciWriterCompress *context, char const *data, size_t data_size) {
+    assert(context != NULL);
+    assert(0 < data_size && data_size <= context->block_size);
+
+    // Only worth it if the block gets smaller
+    size_t limit = data_size - 1;
+    limit = limit < context->output_size ? limit : context->output_size;
+    size_t length = gci_compress_block(context->table, data, data_size, context->output, limit);
+
+    return gci_compress_emit(
+        context->writer,
+        &context->started,
+        context->block_size,
+        data,
+        data_size,
+        context->output,
+        length
+    );
+}
+
+// Writes a block of a stream, preceded by the stream header if `started` is
+// not yet set. The block is stored raw if `compressed_size` is zero.
+bool gci_compress_emit(
+        struct GciInterfaceWriter writer,
+        bool *started,
+        size_t block_size,
+        char const *data,
+        size_t data_size,
+        char const *compressed,
+        size_t compressed_size
+) {
+    assert(started != NULL);
+
+    char header[12];
+    size_t header_size = 0;
+    if (!*started) {
+        memcpy(header, GCI_COMPRESS_MAGIC, 4);
+        gci_compress_write32(header + 4, (uint32_t) block_size);
+        header_size = 8;
+        *started = true;
+    }
+
+    struct GciIovec vectors[2];
+    if (compressed_size == 0) {
+        gci_compress_write32(header + header_size, (uint32_t) data_size | GCI_COMPRESS_RAW);
+        vectors[1] = (struct GciIovec) { .data = data, .data_size = data_size };
+    } else {
+        gci_compress_write32(header + header_size, (uint32_t) compressed_size);
+        vectors[1] = (struct GciIovec) { .data = compressed, .data_size = compressed_size };
+    }
+    header_size += 4;
+    vectors[0] = (struct GciIovec) { .data = header, .data_size = header_size };
+
+    size_t total = header_size + vectors[1].data_size;
+    return gci_writer_writev(writer, vectors, 2) == total;
+}
+
+// Writes the end of a stream, preceded by the stream header if `started` is
+// not yet set.
+bool gci_compress_end(struct GciInterfaceWriter writer, bool *started, size_t block_size) {
+    assert(started != NULL);
+
+    char header[12];
+    size_t header_size = 0;
+    if (!*started) {
+        memcpy(header, GCI_COMPRESS_MAGIC, 4);
+        gci_compress_write32(header + 4, (uint32_t) block_size);
+        header_size = 8;
+        *started = true;
+    }
+    gci_compress_write32(header + header_size, 0);
+    header_size += 4;
+
+    return gci_writer_write(writer, header, header_size) == header_size;
+}
+
+enum GciError gci_writer_compress_parallel_init(
+        struct GciWriterCompressParallel *context,
+        struct GciInterfaceWriter writer,
+        char *buffer,
+        size_t buffer_size,
+        size_t slot_count,
+        size_t thread_count
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (buffer == NULL) { return GCI_ERROR_NULL; }
+    if (slot_count < 2 || slot_count > GCI_COMPRESS_SLOTS_MAX) { return GCI_ERROR_BUFFER; }
+    if (thread_count == 0 || thread_count > GCI_COMPRESS_THREADS_MAX) { return GCI_ERROR_BUFFER; }
+
+    size_t block_size = buffer_size / slot_count / 2;
+    block_size = block_size < GCI_COMPRESS_BLOCK_MAX ? block_size : GCI_COMPRESS_BLOCK_MAX;
+    if (block_size < GCI_COMPRESS_BLOCK_MIN) { return GCI_ERROR_BUFFER; }
+
+    context->writer = writer;
+    context->buffer = buffer;
+    context->block_size = block_size;
+    context->slot_count = slot_count;
+    context->thread_count = 0;
+    for (size_t slot = 0; slot < slot_count; slot++) {
+        context->states[slot] = GCI_COMPRESS_SLOT_FREE;
+    }
+    context->fill_slot = 0;
+    context->work_slot = 0;
+    context->write_slot = 0;
+    context->in_flight = 0;
+    context->current = 0;
+    context->started = false;
+    context->closing = false;
+    context->error = false;
+
+    if (pthread_mutex_init(&context->mutex, NULL) != 0) {
+        return GCI_ERROR_IO;
+    }
+    if (pthread_cond_init(&context->work, NULL) != 0) {
+        pthread_mutex_destroy(&context->mutex);
+        return GCI_ERROR_IO;
+    }
+    if (pthread_cond_init(&context->done, NULL) != 0) {
+        pthread_cond_destroy(&context->work);
+        pthread_mutex_destroy(&context->mutex);
+        return GCI_ERROR_IO;
+    }
+
+    for (; context->thread_count < thread_count; context->thread_count++) {
+        pthread_t *thread = &context->threads[context->thread_count];
+        if (pthread_create(thread, NULL, gci_writer_compress_parallel_run, context) != 0) {
+            gci_writer_compress_parallel_deinit(context);
+            return GCI_ERROR_IO;
+        }
+    }
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceWriter gci_writer_compress_parallel_interface(struct GciWriterCompressParallel *context) {
+    assert(context != NULL);
+    return (struct GciInterfaceWriter) {
+        .context = context,
+        .write = gci_writer_compress_parallel_write,
+    };
+}
+
+bool gci_writer_compress_parallel_flush(struct GciWriterCompressParallel *context) {
+    assert(context != NULL);
+    if (context->current > 0) {
+        gci_writer_compress_parallel_submit(context);
+    }
+    gci_writer_compress_parallel_collect(context, 0);
+    return !context->error;
+}
+
+bool gci_writer_compress_parallel_finish(struct GciWriterCompressParallel *context) {
+    assert(context != NULL);
+    if (!gci_writer_compress_parallel_flush(context)) { return false; }
+    return gci_compress_end(context->writer, &context->started, context->block_size);
+}
+
+bool gci_writer_compress_parallel_deinit(struct GciWriterCompressParallel *context) {
+    assert(context != NULL);
+
+    bool result = gci_writer_compress_parallel_flush(context);
+
+    pthread_mutex_lock(&context->mutex);
+    context->closing = true;
+    pthread_cond_broadcast(&context->work);
+    pthread_mutex_unlock(&context->mutex);
+    for (size_t thread = 0; thread < context->thread_count; thread++) {
+        pthread_join(context->threads[thread], NULL);
+    }
+
+    pthread_cond_destroy(&context->done);
+    pthread_cond_destroy(&context->work);
+    pthread_mutex_destroy(&context->mutex);
+    return result;
+}
+
+// Worker thread, compresses filled slots in order of submission until closed.
+void *gci_writer_compress_parallel_run(void *void_context) {
+    assert(void_context != NULL);
+    struct GciWriterCompressParallel *context = (struct GciWriterCompressParallel*) void_context;
+    uint16_t table[GCI_COMPRESS_TABLE_SIZE];
+
+    pthread_mutex_lock(&context->mutex);
+    while (true) {
+        while (!context->closing && context->states[context->work_slot] != GCI_COMPRESS_SLOT_FILLED) {
+            pthread_cond_wait(&context->work, &context->mutex);
+        }
+        if (context->states[context->work_slot] != GCI_COMPRESS_SLOT_FILLED) { break; }
+
+        size_t slot = context->work_slot;
+        context->states[slot] = GCI_COMPRESS_SLOT_BUSY;
+        context->work_slot = (slot + 1) % context->slot_count;
+        pthread_mutex_unlock(&context->mutex);
+
+        // Only worth it if the block gets smaller
+        char *block = context->buffer + slot * 2 * context->block_size;
+        size_t length = context->lengths[slot];
+        size_t compressed = gci_compress_block(table, block, length, block + context->block_size, length - 1);
+
+        pthread_mutex_lock(&context->mutex);
+        context->compressed[slot] = compressed;
+        context->states[slot] = GCI_COMPRESS_SLOT_DONE;
+        pthread_cond_signal(&context->done);
+    }
+    pthread_mutex_unlock(&context->mutex);
+
+    return NULL;
+}
+
+void gci_writer_compress_parallel_submit(struct GciWriterCompressParallel *context) {
+    assert(context != NULL);
+    assert(context->current > 0);
+    assert(context->in_flight < context->slot_count);
+
+    pthread_mutex_lock(&context->mutex);
+    context->lengths[context->fill_slot] = context->current;
+    context->states[context->fill_slot] = GCI_COMPRESS_SLOT_FILLED;
+    pthread_cond_signal(&context->work);
+    pthread_mutex_unlock(&context->mutex);
+
+    context->fill_slot = (context->fill_slot + 1) % context->slot_count;
+    context->in_flight += 1;
+    context->current = 0;
+
+    // The next slot to fill is free once fewer than every slot is in flight
+    gci_writer_compress_parallel_collect(context, context->slot_count - 1);
+}
+
+// Writes compressed slots in order, waiting for the oldest ones until at
+// most `keep` slots are in flight. Slots are still released after an error
+// but no longer written.
+void gci_writer_compress_parallel_collect(struct GciWriterCompressParallel *context, size_t keep) {
+    assert(context != NULL);
+
+    pthread_mutex_lock(&context->mutex);
+    while (context->in_flight > 0) {
+        size_t slot = context->write_slot;
+        if (context->states[slot] != GCI_COMPRESS_SLOT_DONE) {
+            if (context->in_flight <= keep) { break; }
+            pthread_cond_wait(&context->done, &context->mutex);
+            continue;
+        }
+        pthread_mutex_unlock(&context->mutex);
+
+        if (!context->error) {
+            char const *block = context->buffer + slot * 2 * context->block_size;
+            context->error = !gci_compress_emit(
+                context->writer,
+                &context->started,
+                context->block_size,
+                block,
+                context->lengths[slot],
+                block + context->block_size,
+                context->compressed[slot]
+            );
+        }
+
+        pthread_mutex_lock(&context->mutex);
+        context->states[slot] = GCI_COMPRESS_SLOT_FREE;
+        context->write_slot = (slot + 1) % context->slot_count;
+        context->in_flight -= 1;
+    }
+    pthread_mutex_unlock(&context->mutex);
+}
+
+size_t gci_writer_compress_parallel_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciWriterCompressParallel *context = (struct GciWriterCompressParallel*) void_context;
+
+    if (context->error) {
+        return 0;
+    }
+
+    size_t write_length = 0;
+    while (write_length < data_size) {
+        char *block = context->buffer + context->fill_slot * 2 * context->block_size;
+        size_t take = context->block_size - context->current;
+        take = take < data_size - write_length ? take : data_size - write_length;
+
+        memcpy(block + context->current, data + write_length, take);
+        context->current += take;
+        write_length += take;
+
+        if (context->current >= context->block_size) {
+            gci_writer_compress_parallel_submit(context);
+            if (context->error) { break; }
+        }
+    }
+    return write_length;
+}
+
+enum GciError gci_reader_decompress_init(
+        struct GciReaderDecompress *context,
+        struct GciInterfaceReader reader,
+        char *buffer,
+        size_t buffer_size
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (buffer == NULL) { return GCI_ERROR_NULL; }
+    if (buffer_size < 2 * GCI_COMPRESS_BLOCK_MIN) { return GCI_ERROR_BUFFER; }
+
+    context->reader = reader;
+    context->buffer = buffer;
+    context->buffer_size = buffer_size / 2;
+    context->input = buffer + context->buffer_size;
+    context->input_size = buffer_size - context->buffer_size;
+    context->block_size = 0;
+    context->current = 0;
+    context->length = 0;
+    context->started = false;
+    context->eof = false;
+    context->error = false;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceReader gci_reader_decompress_interface(struct GciReaderDecompress *context) {
+    assert(context != NULL);
+    return (struct GciInterfaceReader) {
+        .context = context,
+        .read = gci_reader_decompress_read,
+        .eof = gci_reader_decompress_eof,
+        .peek = gci_reader_decompress_peek,
+        .consume = gci_reader_decompress_consume,
+    };
+}
+
+size_t gci_reader_decompress_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    assert(buffer != NULL || buffer_size == 0);
+    struct GciReaderDecompress *context = (struct GciReaderDecompress*) void_context;
+
+    size_t read_length = 0;
+    while (read_length < buffer_size) {
+        if (context->current >= context->length && !gci_reader_decompress_next(context)) {
+            break;
+        }
+
+        size_t take = context->length - context->current;
+        take = take < buffer_size - read_length ? take : buffer_size - read_length;
+        memcpy(buffer + read_length, context->buffer + context->current, take);
+        context->current += take;
+        read_length += take;
+    }
+    return read_length;
+}
+
+bool gci_reader_decompress_eof(void const *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderDecompress *context = (struct GciReaderDecompress*) void_context;
+    return context->eof && context->current >= context->length;
+}
+
+size_t gci_reader_decompress_peek(void const *void_context, char const **data) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciReaderDecompress *context = (struct GciReaderDecompress*) void_context;
+
+    if (context->current >= context->length && !gci_reader_decompress_next(context)) {
+        return 0;
+    }
+    *data = context->buffer + context->current;
+    return context->length - context->current;
+}
+
+void gci_reader_decompress_consume(void const *void_context, size_t amount) {
+    assert(void_context != NULL);
+    struct GciReaderDecompress *context = (struct GciReaderDecompress*) void_context;
+    assert(amount <= context->length - context->current);
+    context->current += amount;
+}
+
+// Reads and decompresses the next block, returns false at the end of the
+// stream or if it is malformed.
+bool gci_reader_decompress_next(struct GciReaderDecompress *context) {
+    assert(context != NULL);
+    if (context->eof || context->error) { return false; }
+    context->current = 0;
+    context->length = 0;
+
+    char header[8];
+    if (!context->started) {
+        size_t length = gci_reader_read(context->reader, header, 8);
+        if (length < 8 || memcmp(header, GCI_COMPRESS_MAGIC, 4) != 0) {
+            context->error = true;
+            return false;
+        }
+
+        size_t block_size = gci_compress_read32(header + 4);
+        if (block_size == 0 || block_size > context->buffer_size) {
+            context->error = true;
+            return false;
+        }
+        context->block_size = block_size;
+        context->started = true;
+    }
+
+    size_t length = gci_reader_read(context->reader, header, 4);
+    if (length < 4) {
+        context->error = true;
+        return false;
+    }
+    uint32_t value = gci_compress_read32(header);
+    if (value == 0) {
+        context->eof = true;
+        return false;
+    }
+
+    size_t payload_size = value & ~GCI_COMPRESS_RAW;
+    if (payload_size > context->block_size) {
+        context->error = true;
+        return false;
+    }
+
+    if (value & GCI_COMPRESS_RAW) {
+        length = gci_reader_read(context->reader, context->buffer, payload_size);
+        context->error = length < payload_size;
+        context->length = context->error ? 0 : payload_size;
+        return !context->error;
+    }
+
+    if (payload_size > context->input_size) {
+        context->error = true;
+        return false;
+    }
+    length = gci_reader_read(context->reader, context->input, payload_size);
+    if (length < payload_size) {
+        context->error = true;
+        return false;
+    }
+
+    size_t block_length = 0;
+    bool success = gci_decompress_block(context->input, payload_size, context->buffer, context->block_size, &block_length);
+    context->error = !success || block_length == 0;
+    context->length = context->error ? 0 : block_length;
+    return !context->error;
+}
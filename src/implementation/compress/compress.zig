@@ -0,0 +1,176 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const reader = @import("../reader/reader.zig");
+const writer = @import("../writer/writer.zig");
+const InterfaceReader = reader.InterfaceReader;
+const InterfaceWriter = writer.InterfaceWriter;
+
+pub const block_max: usize = lib.GCI_COMPRESS_BLOCK_MAX;
+
+pub const Writer = struct {
+    inner: lib.GciWriterCompress,
+
+    pub fn init(w: InterfaceWriter, buffer: []u8) !Writer {
+        var self: Writer = undefined;
+        const err = lib.gci_writer_compress_init(&self.inner, w.writer, buffer.ptr, buffer.len);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Writer) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_compress_interface(&self.inner) };
+    }
+
+    pub fn flush(self: *Writer) !void {
+        const result = lib.gci_writer_compress_flush(&self.inner);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+
+    pub fn finish(self: *Writer) !void {
+        const result = lib.gci_writer_compress_finish(&self.inner);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+};
+
+pub const Parallel = struct {
+    inner: lib.GciWriterCompressParallel,
+
+    // Starts worker threads which refer to `self`, so it is initialized in
+    // place and must not move until `deinit`.
+    pub fn init(self: *Parallel, w: InterfaceWriter, buffer: []u8, slot_count: usize, thread_count: usize) !void {
+        const err = lib.gci_writer_compress_parallel_init(
+            &self.inner,
+            w.writer,
+            buffer.ptr,
+            buffer.len,
+            slot_count,
+            thread_count,
+        );
+        try internal.enumToError(err);
+    }
+
+    // Any failure to write is reported by `flush` and `finish`, call either
+    // before `deinit` to observe errors.
+    pub fn deinit(self: *Parallel) void {
+        _ = lib.gci_writer_compress_parallel_deinit(&self.inner);
+    }
+
+    pub fn interface(self: *Parallel) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_compress_parallel_interface(&self.inner) };
+    }
+
+    pub fn flush(self: *Parallel) !void {
+        const result = lib.gci_writer_compress_parallel_flush(&self.inner);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+
+    pub fn finish(self: *Parallel) !void {
+        const result = lib.gci_writer_compress_parallel_finish(&self.inner);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+};
+
+pub const Reader = struct {
+    inner: lib.GciReaderDecompress,
+
+    pub fn init(r: InterfaceReader, buffer: []u8) !Reader {
+        var self: Reader = undefined;
+        const err = lib.gci_reader_decompress_init(&self.inner, r.reader, buffer.ptr, buffer.len);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Reader) InterfaceReader {
+        return .{ .reader = lib.gci_reader_decompress_interface(&self.inner) };
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_compress.zig");
+}
+
+test "round trip" {
+    var data: [10000]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = "the quick brown fox jumps over the lazy dog\n"[index % 44];
+    }
+
+    var compressed: [12000]u8 = undefined;
+    var string = try writer.String.init(&compressed);
+    var buffer: [2048]u8 = undefined;
+    var context = try Writer.init(string.interface(), &buffer);
+    try context.interface().write(&data);
+    try context.finish();
+    try testing.expect(string.inner.current < data.len / 4);
+
+    var source = try reader.String.init(compressed[0..string.inner.current]);
+    var read_buffer: [2048]u8 = undefined;
+    var decompress = try Reader.init(source.interface(), &read_buffer);
+    const r = decompress.interface();
+
+    var result: [10000]u8 = undefined;
+    const length = (try r.read(&result)).len;
+    try testing.expectEqual(data.len, length);
+    try testing.expectEqualSlices(u8, &data, &result);
+
+    var rest: [1]u8 = undefined;
+    try testing.expectError(error.Reader, r.read(&rest));
+    try testing.expect(r.eof());
+}
+
+test "parallel matches serial" {
+    var data: [50000]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = "the quick brown fox jumps over the lazy dog\n"[(index * 7 / 5) % 44];
+    }
+
+    var serial_output: [20000]u8 = undefined;
+    var serial_string = try writer.String.init(&serial_output);
+    var serial_buffer: [2 * 1024]u8 = undefined;
+    var serial = try Writer.init(serial_string.interface(), &serial_buffer);
+    try serial.interface().write(&data);
+    try serial.finish();
+
+    var parallel_output: [20000]u8 = undefined;
+    var parallel_string = try writer.String.init(&parallel_output);
+    var parallel_buffer: [4 * 2 * 1024]u8 = undefined;
+    var parallel: Parallel = undefined;
+    try parallel.init(parallel_string.interface(), &parallel_buffer, 4, 3);
+    defer parallel.deinit();
+    try parallel.interface().write(&data);
+    try parallel.finish();
+
+    const serial_length = serial_string.inner.current;
+    const parallel_length = parallel_string.inner.current;
+    try testing.expectEqualSlices(u8, serial_output[0..serial_length], parallel_output[0..parallel_length]);
+}
+
+test "read truncated" {
+    var compressed: [64]u8 = undefined;
+    var string = try writer.String.init(&compressed);
+    var buffer: [64]u8 = undefined;
+    var context = try Writer.init(string.interface(), &buffer);
+    try context.interface().write("abcabcabcabcabcabc");
+    try context.flush();
+
+    var source = try reader.String.init(compressed[0..string.inner.current]);
+    var read_buffer: [64]u8 = undefined;
+    var decompress = try Reader.init(source.interface(), &read_buffer);
+    const r = decompress.interface();
+
+    var result: [32]u8 = undefined;
+    const data = try r.read(&result);
+    try testing.expectEqualStrings("abcabcabcabcabcabc", data);
+    try testing.expect(!r.eof());
+}
@@ -0,0 +1,181 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "block round trip" {
+    var table: [lib.GCI_COMPRESS_TABLE_SIZE]u16 = undefined;
+    const data = "abcdefgh" ** 16;
+
+    var block: [128]u8 = undefined;
+    const block_size = lib.gci_compress_block(&table, data, data.len, &block, block.len);
+    try testing.expect(0 < block_size and block_size < data.len);
+
+    var output: [data.len]u8 = undefined;
+    var length: usize = undefined;
+    const result = lib.gci_decompress_block(&block, block_size, &output, output.len, &length);
+    try testing.expect(result);
+    try testing.expectEqual(data.len, length);
+    try testing.expectEqualStrings(data, &output);
+}
+
+test "block output small" {
+    var table: [lib.GCI_COMPRESS_TABLE_SIZE]u16 = undefined;
+    const data = "0123456789abcdef";
+
+    var block: [8]u8 = undefined;
+    const block_size = lib.gci_compress_block(&table, data, data.len, &block, block.len);
+    try testing.expectEqual(0, block_size);
+}
+
+test "block malformed" {
+    // A match reaching back before the start of the block
+    const block = [_]u8{ 0x10, 'a', 0x05, 0x00 };
+
+    var output: [16]u8 = undefined;
+    var length: usize = undefined;
+    const result = lib.gci_decompress_block(&block, block.len, &output, output.len, &length);
+    try testing.expect(!result);
+}
+
+test "writer init" {
+    var c: lib.GciWriterString = undefined;
+    var buffer: [64]u8 = undefined;
+
+    var context: lib.GciWriterCompress = undefined;
+    const init_err = lib.gci_writer_compress_init(&context, lib.gci_writer_string_interface(&c), &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+}
+
+test "writer init null" {
+    var c: lib.GciWriterString = undefined;
+    var buffer: [64]u8 = undefined;
+
+    const init_err1 = lib.gci_writer_compress_init(null, lib.gci_writer_string_interface(&c), &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err1);
+
+    var context: lib.GciWriterCompress = undefined;
+    const init_err2 = lib.gci_writer_compress_init(&context, lib.gci_writer_string_interface(&c), null, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err2);
+}
+
+test "writer init small" {
+    var c: lib.GciWriterString = undefined;
+    var buffer: [2 * lib.GCI_COMPRESS_BLOCK_MIN - 1]u8 = undefined;
+
+    var context: lib.GciWriterCompress = undefined;
+    const init_err = lib.gci_writer_compress_init(&context, lib.gci_writer_string_interface(&c), &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err);
+}
+
+test "writer stores incompressible" {
+    var b: [64]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const c_err = lib.gci_writer_string_init(&c, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), c_err);
+
+    var buffer: [64]u8 = undefined;
+    var context: lib.GciWriterCompress = undefined;
+    const init_err = lib.gci_writer_compress_init(&context, lib.gci_writer_string_interface(&c), &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const writer = lib.gci_writer_compress_interface(&context);
+
+    const res = lib.gci_writer_write(writer, "0123", 4);
+    try testing.expectEqual(4, res);
+    try testing.expect(lib.gci_writer_compress_finish(&context));
+
+    const expected = "GCIZ" ++ [_]u8{ 32, 0, 0, 0 } ++ [_]u8{ 4, 0, 0, 0x80 } ++ "0123" ++ [_]u8{ 0, 0, 0, 0 };
+    try testing.expectEqualStrings(expected, b[0..c.current]);
+}
+
+test "parallel init bad counts" {
+    var c: lib.GciWriterString = undefined;
+    var buffer: [4 * 64]u8 = undefined;
+
+    var context: lib.GciWriterCompressParallel = undefined;
+    const init_err1 = lib.gci_writer_compress_parallel_init(&context, lib.gci_writer_string_interface(&c), &buffer, buffer.len, 1, 1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err1);
+
+    const init_err2 = lib.gci_writer_compress_parallel_init(&context, lib.gci_writer_string_interface(&c), &buffer, buffer.len, 4, 0);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err2);
+
+    const init_err3 = lib.gci_writer_compress_parallel_init(&context, lib.gci_writer_string_interface(&c), &buffer, 4 * 16, 4, 1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err3);
+}
+
+test "parallel write in order" {
+    var b: [256]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const c_err = lib.gci_writer_string_init(&c, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), c_err);
+
+    var buffer: [4 * 32]u8 = undefined;
+    var context: lib.GciWriterCompressParallel = undefined;
+    const init_err = lib.gci_writer_compress_parallel_init(&context, lib.gci_writer_string_interface(&c), &buffer, buffer.len, 4, 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const writer = lib.gci_writer_compress_parallel_interface(&context);
+
+    // Blocks of 16 incompressible bytes are stored raw
+    const data = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUV";
+    const res = lib.gci_writer_write(writer, data, data.len);
+    try testing.expectEqual(data.len, res);
+    try testing.expect(lib.gci_writer_compress_parallel_finish(&context));
+    try testing.expect(lib.gci_writer_compress_parallel_deinit(&context));
+
+    const expected = "GCIZ" ++ [_]u8{ 16, 0, 0, 0 } ++
+        [_]u8{ 16, 0, 0, 0x80 } ++ data[0..16] ++
+        [_]u8{ 16, 0, 0, 0x80 } ++ data[16..32] ++
+        [_]u8{ 16, 0, 0, 0x80 } ++ data[32..48] ++
+        [_]u8{ 10, 0, 0, 0x80 } ++ data[48..] ++
+        [_]u8{ 0, 0, 0, 0 };
+    try testing.expectEqualStrings(expected, b[0..c.current]);
+}
+
+test "reader init small" {
+    var c: lib.GciReaderString = undefined;
+    var buffer: [2 * lib.GCI_COMPRESS_BLOCK_MIN - 1]u8 = undefined;
+
+    var context: lib.GciReaderDecompress = undefined;
+    const init_err = lib.gci_reader_decompress_init(&context, lib.gci_reader_string_interface(&c), &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err);
+}
+
+test "reader peek" {
+    const stream = "GCIZ" ++ [_]u8{ 32, 0, 0, 0 } ++ [_]u8{ 4, 0, 0, 0x80 } ++ "0123" ++ [_]u8{ 0, 0, 0, 0 };
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, stream, stream.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [64]u8 = undefined;
+    var context: lib.GciReaderDecompress = undefined;
+    const init_err = lib.gci_reader_decompress_init(&context, lib.gci_reader_string_interface(&c), &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_decompress_interface(&context);
+
+    var view: [*c]const u8 = undefined;
+    const length1 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(4, length1);
+    try testing.expectEqualStrings("0123", view[0..4]);
+    lib.gci_reader_consume(reader, length1, 4);
+
+    const length2 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(0, length2);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "reader bad magic" {
+    const stream = "GCIX" ++ [_]u8{ 32, 0, 0, 0 } ++ [_]u8{ 0, 0, 0, 0 };
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, stream, stream.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [64]u8 = undefined;
+    var context: lib.GciReaderDecompress = undefined;
+    const init_err = lib.gci_reader_decompress_init(&context, lib.gci_reader_string_interface(&c), &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_decompress_interface(&context);
+
+    var result: [4]u8 = undefined;
+    const length = lib.gci_reader_read(reader, &result, result.len);
+    try testing.expectEqual(0, length);
+    try testing.expect(!lib.gci_reader_eof(reader));
+}
@@ -0,0 +1,194 @@
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#else
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#endif
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <gci_copy.h>
+#include <gci_fd.h>
+#include <gci_reader.h>
+#include <gci_writer.h>
+
+// The fd backed endpoints are recognized by their callbacks
+size_t gci_reader_fd_read(void const *context, char *buffer, size_t buffer_size);
+size_t gci_writer_fd_write(void const *context, char const *data, size_t data_size);
+size_t gci_writer_file_write(void const *context, char const *data, size_t data_size);
+
+int gci_copy_writer_fd(struct GciInterfaceWriter writer);
+size_t gci_copy_peek(struct GciInterfaceReader reader, struct GciInterfaceWriter writer);
+size_t gci_copy_buffered(
+    struct GciInterfaceReader reader,
+    struct GciInterfaceWriter writer,
+    char *buffer,
+    size_t buffer_size
+);
+
+#ifdef __linux__
+#define GCI_COPY_KERNEL_CHUNK ((size_t) 1 << 30)
+
+enum GciCopyKernel {
+    GCI_COPY_KERNEL_EOF         = 0,
+    GCI_COPY_KERNEL_FAILED      = 1,
+    GCI_COPY_KERNEL_UNSUPPORTED = 2,
+};
+
+enum GciCopyKernel gci_copy_kernel(int in_fd, int out_fd, size_t *copied);
+ssize_t gci_copy_kernel_step(int method, int in_fd, int out_fd);
+bool gci_copy_kernel_unsupported(int error);
+#endif
+
+size_t gci_copy(
+    struct GciInterfaceReader reader,
+    struct GciInterfaceWriter writer,
+    char *buffer,
+    size_t buffer_size
+) {
+    assert(reader.read != NULL);
+    assert(writer.write != NULL);
+    assert(buffer != NULL || buffer_size == 0);
+
+    size_t copied = 0;
+
+#ifdef __linux__
+    if (reader.read == gci_reader_fd_read) {
+        struct GciReaderFd *context = (struct GciReaderFd*) reader.context;
+        int out_fd = gci_copy_writer_fd(writer);
+
+        if (out_fd >= 0) {
+            enum GciCopyKernel result = gci_copy_kernel(context->fd, out_fd, &copied);
+            if (result == GCI_COPY_KERNEL_EOF) {
+                context->eof = true;
+                return copied;
+            } else if (result == GCI_COPY_KERNEL_FAILED) {
+                return copied;
+            }
+        }
+    }
+#endif
+
+    if (reader.peek != NULL) {
+        return copied + gci_copy_peek(reader, writer);
+    }
+
+    char stack_buffer[GCI_COPY_BUFFER_SIZE];
+    if (buffer == NULL) {
+        buffer = stack_buffer;
+        buffer_size = GCI_COPY_BUFFER_SIZE;
+    }
+    return copied + gci_copy_buffered(reader, writer, buffer, buffer_size);
+}
+
+int gci_copy_writer_fd(struct GciInterfaceWriter writer) {
+    if (writer.write == gci_writer_fd_write) {
+        struct GciWriterFd *context = (struct GciWriterFd*) writer.context;
+        return context->fd;
+    } else if (writer.write == gci_writer_file_write) {
+        // Anything still buffered by stdio must reach the file first
+        struct GciWriterFile *context = (struct GciWriterFile*) writer.context;
+        if (fflush(context->file) != 0) { return -1; }
+        return fileno(context->file);
+    }
+    return -1;
+}
+
+size_t gci_copy_peek(struct GciInterfaceReader reader, struct GciInterfaceWriter writer) {
+    size_t copied = 0;
+    while (true) {
+        char const *data;
+        size_t length = gci_reader_peek(reader, &data, NULL, 0);
+        if (length == 0) { break; }
+
+        size_t result = gci_writer_write(writer, data, length);
+        gci_reader_consume(reader, length, result);
+        copied += result;
+        if (result < length) { break; }
+    }
+    return copied;
+}
+
+size_t gci_copy_buffered(
+    struct GciInterfaceReader reader,
+    struct GciInterfaceWriter writer,
+    char *buffer,
+    size_t buffer_size
+) {
+    assert(buffer != NULL);
+    assert(buffer_size > 0);
+
+    size_t copied = 0;
+    while (true) {
+        // Read straight into the writer when it can lend a whole chunk
+        char *reserved = gci_writer_reserve(writer, buffer_size, buffer, buffer_size);
+        assert(reserved != NULL);
+
+        size_t length = gci_reader_read(reader, reserved, buffer_size);
+        size_t result = length > 0 ? gci_writer_commit(writer, reserved, length, buffer) : 0;
+        copied += result;
+
+        if (result < length || length < buffer_size) { break; }
+    }
+    return copied;
+}
+
+#ifdef __linux__
+enum GciCopyKernel gci_copy_kernel(int in_fd, int out_fd, size_t *copied) {
+    assert(copied != NULL);
+
+    for (int method = 0; method < 3; method++) {
+        size_t method_copied = 0;
+        while (true) {
+            ssize_t length = gci_copy_kernel_step(method, in_fd, out_fd);
+            if (length > 0) {
+                method_copied += (size_t) length;
+                *copied += (size_t) length;
+                continue;
+            }
+
+            // Some file systems report an empty file to `copy_file_range`
+            // instead of refusing, let the next method confirm it
+            if (length == 0 && method == 0 && method_copied == 0) { break; }
+            if (length == 0) { return GCI_COPY_KERNEL_EOF; }
+
+            if (errno == EINTR) { continue; }
+            if (gci_copy_kernel_unsupported(errno)) { break; }
+            return GCI_COPY_KERNEL_FAILED;
+        }
+    }
+
+    return GCI_COPY_KERNEL_UNSUPPORTED;
+}
+
+ssize_t gci_copy_kernel_step(int method, int in_fd, int out_fd) {
+    switch (method) {
+        case 0:
+            return copy_file_range(in_fd, NULL, out_fd, NULL, GCI_COPY_KERNEL_CHUNK, 0);
+        case 1:
+            return splice(in_fd, NULL, out_fd, NULL, GCI_COPY_KERNEL_CHUNK, SPLICE_F_MOVE);
+        default:
+            return sendfile(out_fd, in_fd, NULL, GCI_COPY_KERNEL_CHUNK);
+    }
+}
+
+bool gci_copy_kernel_unsupported(int error) {
+    switch (error) {
+        case EINVAL:
+        case EXDEV:
+        case ENOSYS:
+        case EOPNOTSUPP:
+        case EBADF:
+        case ESPIPE:
+            return true;
+        default:
+            return false;
+    }
+}
+#endif
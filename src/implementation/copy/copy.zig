@@ -0,0 +1,75 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const reader = @import("../reader/reader.zig");
+const writer = @import("../writer/writer.zig");
+const fd = @import("../fd/fd.zig");
+const InterfaceReader = reader.InterfaceReader;
+const InterfaceWriter = writer.InterfaceWriter;
+
+// Copies everything left in `in` to `out`, see `gci_copy`. A null `buffer`
+// makes the copy use a buffer on the stack when it needs one.
+pub fn copy(in: InterfaceReader, out: InterfaceWriter, buffer: ?[]u8) !usize {
+    var buffer_ptr: [*c]u8 = null;
+    var buffer_len: usize = 0;
+    if (buffer) |b| {
+        buffer_ptr = b.ptr;
+        buffer_len = b.len;
+    }
+
+    const copied = lib.gci_copy(in.reader, out.writer, buffer_ptr, buffer_len);
+    if (!in.eof()) {
+        return error.Copy;
+    }
+    return copied;
+}
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_copy.zig");
+}
+
+test "copy file to file" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const in_file = try tmp.dir.createFile("in", .{ .read = true });
+    defer in_file.close();
+    try in_file.writeAll("123456789");
+    try in_file.seekTo(0);
+
+    const out_file = try tmp.dir.createFile("out", .{ .read = true });
+    defer out_file.close();
+
+    var in_context = try fd.Reader.init(in_file.handle);
+    var out_context = try fd.Writer.init(out_file.handle);
+
+    const copied = try copy(in_context.interface(), out_context.interface(), null);
+    try testing.expectEqual(9, copied);
+
+    var result: [10]u8 = undefined;
+    const length = try out_file.preadAll(&result, 0);
+    try testing.expectEqualStrings("123456789", result[0..length]);
+}
+
+test "copy string to string" {
+    var in_context = try reader.String.init("123");
+
+    var buffer: [4]u8 = undefined;
+    var out_context = try writer.String.init(&buffer);
+
+    const copied = try copy(in_context.interface(), out_context.interface(), null);
+    try testing.expectEqual(3, copied);
+    try testing.expectEqualStrings("123", try out_context.end(0));
+}
+
+test "copy writer fail" {
+    var in_context = try reader.String.init("123");
+
+    var buffer: [2]u8 = undefined;
+    var out_context = try writer.String.init(&buffer);
+
+    const err = copy(in_context.interface(), out_context.interface(), null);
+    try testing.expectError(error.Copy, err);
+}
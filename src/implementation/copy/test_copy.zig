@@ -0,0 +1,145 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "copy file to pipe" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+    try file.writeAll("123456789");
+    try file.seekTo(2);
+
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+
+    var in_context: lib.GciReaderFd = undefined;
+    const in_err = lib.gci_reader_fd_init(&in_context, file.handle);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), in_err);
+
+    var out_context: lib.GciWriterFd = undefined;
+    const out_err = lib.gci_writer_fd_init(&out_context, fds[1]);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), out_err);
+
+    const reader = lib.gci_reader_fd_interface(&in_context);
+    const writer = lib.gci_writer_fd_interface(&out_context);
+
+    const copied = lib.gci_copy(reader, writer, null, 0);
+    try testing.expectEqual(7, copied);
+    try testing.expect(lib.gci_reader_eof(reader));
+    std.posix.close(fds[1]);
+
+    var buffer: [8]u8 = undefined;
+    const length = try std.posix.read(fds[0], &buffer);
+    try testing.expectEqualStrings("3456789", buffer[0..length]);
+}
+
+test "copy pipe to file" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+    _ = try std.posix.write(fds[1], "123");
+    std.posix.close(fds[1]);
+
+    var in_context: lib.GciReaderFd = undefined;
+    const in_err = lib.gci_reader_fd_init(&in_context, fds[0]);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), in_err);
+
+    var out_context: lib.GciWriterFd = undefined;
+    const out_err = lib.gci_writer_fd_init(&out_context, file.handle);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), out_err);
+
+    const reader = lib.gci_reader_fd_interface(&in_context);
+    const writer = lib.gci_writer_fd_interface(&out_context);
+
+    const copied = lib.gci_copy(reader, writer, null, 0);
+    try testing.expectEqual(3, copied);
+    try testing.expect(lib.gci_reader_eof(reader));
+
+    var buffer: [4]u8 = undefined;
+    const length = try file.preadAll(&buffer, 0);
+    try testing.expectEqualStrings("123", buffer[0..length]);
+}
+
+test "copy peek" {
+    var in_context: lib.GciReaderString = undefined;
+    const in_err = lib.gci_reader_string_init(&in_context, "123", 3);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), in_err);
+
+    var buffer: [4]u8 = undefined;
+    var out_context: lib.GciWriterString = undefined;
+    const out_err = lib.gci_writer_string_init(&out_context, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), out_err);
+
+    const reader = lib.gci_reader_string_interface(&in_context);
+    const writer = lib.gci_writer_string_interface(&out_context);
+
+    const copied = lib.gci_copy(reader, writer, null, 0);
+    try testing.expectEqual(3, copied);
+    try testing.expect(lib.gci_reader_eof(reader));
+    try testing.expectEqualStrings("123", buffer[0..3]);
+}
+
+test "copy peek writer fail" {
+    var in_context: lib.GciReaderString = undefined;
+    const in_err = lib.gci_reader_string_init(&in_context, "123", 3);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), in_err);
+
+    var buffer: [2]u8 = undefined;
+    var out_context: lib.GciWriterString = undefined;
+    const out_err = lib.gci_writer_string_init(&out_context, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), out_err);
+
+    const reader = lib.gci_reader_string_interface(&in_context);
+    const writer = lib.gci_writer_string_interface(&out_context);
+
+    const copied = lib.gci_copy(reader, writer, null, 0);
+    try testing.expectEqual(2, copied);
+    try testing.expect(!lib.gci_reader_eof(reader));
+}
+
+test "copy buffered" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+    _ = try std.posix.write(fds[1], "1234567");
+    std.posix.close(fds[1]);
+
+    var in_context: lib.GciReaderFd = undefined;
+    const in_err = lib.gci_reader_fd_init(&in_context, fds[0]);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), in_err);
+
+    var b: [8]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const c_err = lib.gci_writer_string_init(&c, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), c_err);
+
+    var buffer: [4]u8 = undefined;
+    var out_context: lib.GciWriterBuffer = undefined;
+    const out_err = lib.gci_writer_buffer_init(
+        &out_context,
+        lib.gci_writer_string_interface(&c),
+        &buffer,
+        buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), out_err);
+
+    const reader = lib.gci_reader_fd_interface(&in_context);
+    const writer = lib.gci_writer_buffer_interface(&out_context);
+
+    // The buffer writer lends its buffer so the scratch buffer stays unused
+    var scratch: [3]u8 = .{ 0, 0, 0 };
+    const copied = lib.gci_copy(reader, writer, &scratch, scratch.len);
+    try testing.expectEqual(7, copied);
+    try testing.expect(lib.gci_reader_eof(reader));
+    try testing.expectEqualSlices(u8, &.{ 0, 0, 0 }, &scratch);
+
+    const flush_res = lib.gci_writer_buffer_flush(&out_context);
+    try testing.expect(flush_res);
+    try testing.expectEqualStrings("1234567", b[0..7]);
+}
@@ -0,0 +1,240 @@
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#else
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#endif
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <gci_direct.h>
+
+size_t gci_writer_direct_write(void const *context, char const *data, size_t data_size);
+void *gci_writer_direct_run(void *context);
+void gci_writer_direct_publish(struct GciWriterDirect *context);
+void gci_writer_direct_wait(sem_t *semaphore);
+bool gci_writer_direct_write_all(int fd, char const *data, size_t data_size);
+bool gci_writer_direct_tail(struct GciWriterDirect *context);
+
+enum GciError gci_writer_direct_init(
+    struct GciWriterDirect *context,
+    int fd,
+    char *buffer,
+    size_t buffer_size,
+    size_t block_size
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    context->buffer = buffer;
+    if (buffer == NULL) { return GCI_ERROR_NULL; }
+    if (block_size == 0 || block_size > SIZE_MAX / 2) { return GCI_ERROR_BUFFER; }
+    if ((uintptr_t) buffer % block_size != 0) { return GCI_ERROR_BUFFER; }
+    if (buffer_size == 0 || buffer_size % (2 * block_size) != 0) { return GCI_ERROR_BUFFER; }
+
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+    if (offset < 0) { return GCI_ERROR_IO; }
+    if ((uint64_t) offset % block_size != 0) { return GCI_ERROR_BUFFER; }
+
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0) { return GCI_ERROR_IO; }
+
+    context->fd = fd;
+    context->flags = flags;
+    context->block_size = block_size;
+    context->half_size = buffer_size / 2;
+    context->producer_half = 0;
+    context->consumer_half = 0;
+    context->current = 0;
+    context->holding = false;
+    context->closing = false;
+    context->error = false;
+    context->direct = false;
+
+    if (sem_init(&context->filled, 0, 0) != 0) {
+        return GCI_ERROR_IO;
+    }
+    if (sem_init(&context->free, 0, 2) != 0) {
+        sem_destroy(&context->filled);
+        return GCI_ERROR_IO;
+    }
+
+#ifdef O_DIRECT
+    context->direct = fcntl(fd, F_SETFL, flags | O_DIRECT) == 0;
+#endif
+
+    if (pthread_create(&context->thread, NULL, gci_writer_direct_run, context) != 0) {
+        if (context->direct) {
+            fcntl(fd, F_SETFL, flags);
+        }
+        sem_destroy(&context->free);
+        sem_destroy(&context->filled);
+        return GCI_ERROR_IO;
+    }
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceWriter gci_writer_direct_interface(struct GciWriterDirect *context) {
+    return (struct GciInterfaceWriter) { .context = context, .write = gci_writer_direct_write };
+}
+
+void gci_writer_direct_wait(sem_t *semaphore) {
+    while (sem_wait(semaphore) != 0) {
+        assert(errno == EINTR);
+    }
+}
+
+bool gci_writer_direct_write_all(int fd, char const *data, size_t data_size) {
+    while (data_size > 0) {
+        ssize_t result = write(fd, data, data_size);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            return false;
+        }
+
+        data += result;
+        data_size -= (size_t) result;
+    }
+    return true;
+}
+
+// Background thread, writes full halves in order until closed.
+void *gci_writer_direct_run(void *void_context) {
+    assert(void_context != NULL);
+    struct GciWriterDirect *context = (struct GciWriterDirect*) void_context;
+
+    while (true) {
+        gci_writer_direct_wait(&context->filled);
+        if (__atomic_load_n(&context->closing, __ATOMIC_ACQUIRE)) { break; }
+
+        char *half = context->buffer + context->consumer_half * context->half_size;
+        size_t length = context->lengths[context->consumer_half];
+        assert(length % context->block_size == 0);
+
+        if (!__atomic_load_n(&context->error, __ATOMIC_ACQUIRE)) {
+            if (!gci_writer_direct_write_all(context->fd, half, length)) {
+                __atomic_store_n(&context->error, true, __ATOMIC_RELEASE);
+            }
+        }
+
+        context->consumer_half = 1 - context->consumer_half;
+        sem_post(&context->free);
+    }
+
+    return NULL;
+}
+
+void gci_writer_direct_publish(struct GciWriterDirect *context) {
+    assert(context != NULL);
+    assert(context->holding);
+    assert(context->current == context->half_size);
+
+    context->lengths[context->producer_half] = context->current;
+    context->producer_half = 1 - context->producer_half;
+    context->current = 0;
+    context->holding = false;
+    sem_post(&context->filled);
+}
+
+size_t gci_writer_direct_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciWriterDirect *context = (struct GciWriterDirect*) void_context;
+
+    if (__atomic_load_n(&context->error, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+
+    size_t write_length = 0;
+    while (write_length < data_size) {
+        if (!context->holding) {
+            gci_writer_direct_wait(&context->free);
+            context->holding = true;
+            context->current = 0;
+        }
+
+        char *half = context->buffer + context->producer_half * context->half_size;
+        size_t length = context->half_size - context->current;
+        length = length > data_size - write_length ? data_size - write_length : length;
+
+        memcpy(half + context->current, data + write_length, length);
+        context->current += length;
+        write_length += length;
+
+        if (context->current >= context->half_size) {
+            gci_writer_direct_publish(context);
+        }
+    }
+
+    return write_length;
+}
+
+bool gci_writer_direct_flush(struct GciWriterDirect *context) {
+    assert(context != NULL);
+
+    // Both halves are free once the background thread has caught up, except
+    // the one still being filled
+    size_t waiting = context->holding ? 1 : 2;
+    for (size_t i = 0; i < waiting; i++) {
+        gci_writer_direct_wait(&context->free);
+    }
+    for (size_t i = 0; i < waiting; i++) {
+        sem_post(&context->free);
+    }
+
+    return !__atomic_load_n(&context->error, __ATOMIC_ACQUIRE);
+}
+
+// Writes the partly filled half, the whole blocks directly and the rest
+// through the page cache since `O_DIRECT` only allows whole blocks.
+bool gci_writer_direct_tail(struct GciWriterDirect *context) {
+    assert(context != NULL);
+    if (!context->holding || context->current == 0) {
+        return true;
+    }
+
+    char *half = context->buffer + context->producer_half * context->half_size;
+    size_t aligned = context->current - context->current % context->block_size;
+
+    if (!gci_writer_direct_write_all(context->fd, half, aligned)) {
+        return false;
+    }
+    if (aligned == context->current) {
+        return true;
+    }
+
+#ifdef O_DIRECT
+    if (fcntl(context->fd, F_SETFL, context->flags & ~O_DIRECT) != 0) {
+        return false;
+    }
+#endif
+    return gci_writer_direct_write_all(context->fd, half + aligned, context->current - aligned);
+}
+
+bool gci_writer_direct_deinit(struct GciWriterDirect *context) {
+    assert(context != NULL);
+
+    bool result = gci_writer_direct_flush(context);
+
+    __atomic_store_n(&context->closing, true, __ATOMIC_RELEASE);
+    sem_post(&context->filled);
+    pthread_join(context->thread, NULL);
+
+    if (result) {
+        result = gci_writer_direct_tail(context);
+    }
+
+    if (context->direct) {
+        fcntl(context->fd, F_SETFL, context->flags);
+    }
+
+    sem_destroy(&context->free);
+    sem_destroy(&context->filled);
+    return result;
+}
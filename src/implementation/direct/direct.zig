@@ -0,0 +1,97 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const writer = @import("../writer/writer.zig");
+const InterfaceWriter = writer.InterfaceWriter;
+
+pub const Writer = struct {
+    inner: lib.GciWriterDirect,
+
+    // Starts a background thread which refers to `self`, so it is
+    // initialized in place and must not move until `deinit`.
+    pub fn init(self: *Writer, fd: c_int, buffer: []u8, block_size: usize) !void {
+        const err = lib.gci_writer_direct_init(&self.inner, fd, buffer.ptr, buffer.len, block_size);
+        try internal.enumToError(err);
+    }
+
+    // Writes the unaligned tail as well, so unlike other writers a failure
+    // may only show up here.
+    pub fn deinit(self: *Writer) !void {
+        const result = lib.gci_writer_direct_deinit(&self.inner);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+
+    pub fn interface(self: *Writer) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_direct_interface(&self.inner) };
+    }
+
+    // True if writes bypass the page cache.
+    pub fn direct(self: *const Writer) bool {
+        return self.inner.direct;
+    }
+
+    pub fn flush(self: *Writer) !void {
+        const result = lib.gci_writer_direct_flush(&self.inner);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_direct.zig");
+}
+
+test "direct init unaligned" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{});
+    defer file.close();
+
+    var buffer: [3 * 4096]u8 align(4096) = undefined;
+    var context: Writer = undefined;
+
+    const err1 = context.init(file.handle, buffer[1 .. 1 + 2 * 4096], 4096);
+    try testing.expectError(error.Buffer, err1);
+
+    const err2 = context.init(file.handle, buffer[0..4096], 4096);
+    try testing.expectError(error.Buffer, err2);
+
+    try file.writeAll("1");
+    const err3 = context.init(file.handle, buffer[0 .. 2 * 4096], 4096);
+    try testing.expectError(error.Buffer, err3);
+}
+
+test "direct write with tail" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+
+    var data: [5 * 4096 + 100]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = @truncate(index * 31 + index / 4096);
+    }
+
+    var buffer: [2 * 4096]u8 align(4096) = undefined;
+    var context: Writer = undefined;
+    try context.init(file.handle, &buffer, 4096);
+    const w = context.interface();
+
+    try w.write(data[0..1000]);
+    try w.write(data[1000 .. 3 * 4096]);
+    try context.flush();
+    try w.write(data[3 * 4096 ..]);
+    try context.deinit();
+
+    var result: [data.len + 1]u8 = undefined;
+    const length = try file.preadAll(&result, 0);
+    try testing.expectEqual(data.len, length);
+    try testing.expectEqualSlices(u8, &data, result[0..length]);
+}
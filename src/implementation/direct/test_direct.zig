@@ -0,0 +1,94 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "direct init null" {
+    var buffer: [8192]u8 align(4096) = undefined;
+
+    const init_err1 = lib.gci_writer_direct_init(null, 1, &buffer, buffer.len, 4096);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err1);
+
+    var context: lib.GciWriterDirect = undefined;
+    const init_err2 = lib.gci_writer_direct_init(&context, 1, null, buffer.len, 4096);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err2);
+}
+
+test "direct init buffer" {
+    var buffer: [8192]u8 align(4096) = undefined;
+    var context: lib.GciWriterDirect = undefined;
+
+    const init_err1 = lib.gci_writer_direct_init(&context, 1, &buffer, buffer.len, 0);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err1);
+
+    const init_err2 = lib.gci_writer_direct_init(&context, 1, &buffer, 6000, 4096);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err2);
+}
+
+test "direct init pipe" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+    defer std.posix.close(fds[1]);
+
+    var buffer: [8192]u8 align(4096) = undefined;
+    var context: lib.GciWriterDirect = undefined;
+    const init_err = lib.gci_writer_direct_init(&context, fds[1], &buffer, buffer.len, 4096);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_IO), init_err);
+}
+
+test "direct write" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+
+    var buffer: [8192]u8 align(4096) = undefined;
+    var context: lib.GciWriterDirect = undefined;
+    const init_err = lib.gci_writer_direct_init(&context, file.handle, &buffer, buffer.len, 4096);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_direct_interface(&context);
+    try testing.expectEqual(4, lib.gci_writer_write(writer, "data", 4));
+    try testing.expect(lib.gci_writer_direct_flush(&context));
+    try testing.expect(lib.gci_writer_direct_deinit(&context));
+
+    var result: [5]u8 = undefined;
+    const length = try file.preadAll(&result, 0);
+    try testing.expectEqualStrings("data", result[0..length]);
+}
+
+test "direct write halves and tail" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+    const flags = try std.posix.fcntl(file.handle, std.posix.F.GETFL, 0);
+
+    var buffer: [8192]u8 align(4096) = undefined;
+    var context: lib.GciWriterDirect = undefined;
+    const init_err = lib.gci_writer_direct_init(&context, file.handle, &buffer, buffer.len, 4096);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    // Three full halves go through the background thread, the last 100
+    // bytes are the unaligned tail
+    var data: [3 * 4096 + 100]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = @truncate(index *% 7 +% index / 4096);
+    }
+
+    const writer = lib.gci_writer_direct_interface(&context);
+    var index: usize = 0;
+    while (index < data.len) : (index += 1000) {
+        const chunk = @min(1000, data.len - index);
+        try testing.expectEqual(chunk, lib.gci_writer_write(writer, data[index..].ptr, chunk));
+    }
+    try testing.expect(lib.gci_writer_direct_flush(&context));
+    try testing.expect(lib.gci_writer_direct_deinit(&context));
+
+    try testing.expectEqual(flags, try std.posix.fcntl(file.handle, std.posix.F.GETFL, 0));
+
+    var result: [data.len + 1]u8 = undefined;
+    const length = try file.preadAll(&result, 0);
+    try testing.expectEqualSlices(u8, &data, result[0..length]);
+}
@@ -0,0 +1,1204 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <gci_encode.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GCI_ENCODE_X86
+#include <immintrin.h>
+#endif
+
+// Input bytes encoded per reservation of the encoding writer, a multiple of
+// the base64 group size, hex doubles its input so it takes half the scratch
+#define GCI_ENCODE_CHUNK 3072
+#define GCI_ENCODE_SCRATCH (GCI_ENCODE_CHUNK / 3 * 4)
+#define GCI_ENCODE_HEX_CHUNK (GCI_ENCODE_SCRATCH / 2)
+
+struct GciEncodeKernels {
+    size_t (*base64_encode)(char *output, char const *data, size_t data_size);
+    bool (*base64_decode)(char *output, size_t *output_size, char const *data, size_t data_size);
+    size_t (*hex_encode)(char *output, char const *data, size_t data_size);
+    bool (*hex_decode)(char *output, char const *data, size_t data_size);
+    size_t (*utf8_validate)(char const *data, size_t data_size, bool *incomplete);
+};
+
+size_t gci_base64_encode_scalar(char *output, char const *data, size_t data_size);
+bool gci_base64_decode_scalar(char *output, size_t *output_size, char const *data, size_t data_size);
+size_t gci_hex_encode_scalar(char *output, char const *data, size_t data_size);
+bool gci_hex_decode_scalar(char *output, char const *data, size_t data_size);
+size_t gci_utf8_validate_scalar(char const *data, size_t data_size, bool *incomplete);
+size_t gci_utf8_boundary(char const *data, size_t index);
+#ifdef GCI_ENCODE_X86
+size_t gci_base64_encode_sse42(char *output, char const *data, size_t data_size);
+bool gci_base64_decode_sse42(char *output, size_t *output_size, char const *data, size_t data_size);
+size_t gci_hex_encode_sse42(char *output, char const *data, size_t data_size);
+bool gci_hex_decode_sse42(char *output, char const *data, size_t data_size);
+size_t gci_utf8_validate_sse42(char const *data, size_t data_size, bool *incomplete);
+size_t gci_base64_encode_avx2(char *output, char const *data, size_t data_size);
+bool gci_base64_decode_avx2(char *output, size_t *output_size, char const *data, size_t data_size);
+size_t gci_hex_encode_avx2(char *output, char const *data, size_t data_size);
+bool gci_hex_decode_avx2(char *output, char const *data, size_t data_size);
+size_t gci_utf8_validate_avx2(char const *data, size_t data_size, bool *incomplete);
+#endif
+struct GciEncodeKernels const *gci_encode_kernels(enum GciSimd simd);
+struct GciEncodeKernels const *gci_encode_best(void);
+size_t gci_writer_encode_write(void const *context, char const *data, size_t data_size);
+bool gci_writer_encode_groups(struct GciWriterEncode *context, char const *data, size_t data_size);
+size_t gci_reader_decode_read(void const *context, char *buffer, size_t buffer_size);
+bool gci_reader_decode_eof(void const *context);
+bool gci_reader_decode_groups(struct GciReaderDecode *context, char *output, size_t *output_size, size_t group_count);
+size_t gci_reader_utf8_read(void const *context, char *buffer, size_t buffer_size);
+bool gci_reader_utf8_eof(void const *context);
+bool gci_reader_utf8_complete(struct GciReaderUtf8 *context);
+
+static struct GciEncodeKernels const gci_encode_kernels_scalar = {
+    .base64_encode = gci_base64_encode_scalar,
+    .base64_decode = gci_base64_decode_scalar,
+    .hex_encode = gci_hex_encode_scalar,
+    .hex_decode = gci_hex_decode_scalar,
+    .utf8_validate = gci_utf8_validate_scalar,
+};
+#ifdef GCI_ENCODE_X86
+static struct GciEncodeKernels const gci_encode_kernels_sse42 = {
+    .base64_encode = gci_base64_encode_sse42,
+    .base64_decode = gci_base64_decode_sse42,
+    .hex_encode = gci_hex_encode_sse42,
+    .hex_decode = gci_hex_decode_sse42,
+    .utf8_validate = gci_utf8_validate_sse42,
+};
+static struct GciEncodeKernels const gci_encode_kernels_avx2 = {
+    .base64_encode = gci_base64_encode_avx2,
+    .base64_decode = gci_base64_decode_avx2,
+    .hex_encode = gci_hex_encode_avx2,
+    .hex_decode = gci_hex_decode_avx2,
+    .utf8_validate = gci_utf8_validate_avx2,
+};
+#endif
+
+static char const gci_base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static char const gci_hex_digits[] = "0123456789abcdef";
+
+// Resolved on first use, racing threads resolve it to the same value
+struct GciEncodeKernels const *gci_encode_best_kernels = NULL;
+
+struct GciEncodeKernels const *gci_encode_kernels(enum GciSimd simd) {
+#ifdef GCI_ENCODE_X86
+    // The SSE kernels need the byte shuffles of SSSE3, which every cpu with
+    // SSE4.2 has
+    if (simd >= GCI_SIMD_AVX2) { return &gci_encode_kernels_avx2; }
+    if (simd >= GCI_SIMD_SSE42) { return &gci_encode_kernels_sse42; }
+#else
+    (void) simd;
+#endif
+    return &gci_encode_kernels_scalar;
+}
+
+struct GciEncodeKernels const *gci_encode_best(void) {
+    struct GciEncodeKernels const *kernels = __atomic_load_n(&gci_encode_best_kernels, __ATOMIC_RELAXED);
+    if (kernels == NULL) {
+        kernels = gci_encode_kernels(gci_simd_supported());
+        __atomic_store_n(&gci_encode_best_kernels, kernels, __ATOMIC_RELAXED);
+    }
+    return kernels;
+}
+
+static inline enum GciSimd gci_encode_level(enum GciSimd simd) {
+    enum GciSimd supported = gci_simd_supported();
+    return simd < supported ? simd : supported;
+}
+
+size_t gci_base64_encode(char *output, char const *data, size_t data_size) {
+    return gci_encode_best()->base64_encode(output, data, data_size);
+}
+
+bool gci_base64_decode(char *output, size_t *output_size, char const *data, size_t data_size) {
+    return gci_encode_best()->base64_decode(output, output_size, data, data_size);
+}
+
+size_t gci_hex_encode(char *output, char const *data, size_t data_size) {
+    return gci_encode_best()->hex_encode(output, data, data_size);
+}
+
+bool gci_hex_decode(char *output, char const *data, size_t data_size) {
+    return gci_encode_best()->hex_decode(output, data, data_size);
+}
+
+size_t gci_utf8_validate(char const *data, size_t data_size, bool *incomplete) {
+    return gci_encode_best()->utf8_validate(data, data_size, incomplete);
+}
+
+size_t gci_base64_encode_simd(enum GciSimd simd, char *output, char const *data, size_t data_size) {
+    return gci_encode_kernels(gci_encode_level(simd))->base64_encode(output, data, data_size);
+}
+
+bool gci_base64_decode_simd(enum GciSimd simd, char *output, size_t *output_size, char const *data, size_t data_size) {
+    return gci_encode_kernels(gci_encode_level(simd))->base64_decode(output, output_size, data, data_size);
+}
+
+size_t gci_hex_encode_simd(enum GciSimd simd, char *output, char const *data, size_t data_size) {
+    return gci_encode_kernels(gci_encode_level(simd))->hex_encode(output, data, data_size);
+}
+
+bool gci_hex_decode_simd(enum GciSimd simd, char *output, char const *data, size_t data_size) {
+    return gci_encode_kernels(gci_encode_level(simd))->hex_decode(output, data, data_size);
+}
+
+size_t gci_utf8_validate_simd(enum GciSimd simd, char const *data, size_t data_size, bool *incomplete) {
+    return gci_encode_kernels(gci_encode_level(simd))->utf8_validate(data, data_size, incomplete);
+}
+
+size_t gci_base64_encode_scalar(char *output, char const *data, size_t data_size) {
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+    unsigned char const *input = (unsigned char const*) data;
+
+    size_t length = 0;
+    size_t index = 0;
+    for (; index + 3 <= data_size; index += 3) {
+        uint32_t group = (uint32_t) input[index] << 16 | (uint32_t) input[index + 1] << 8 | input[index + 2];
+        output[length++] = gci_base64_alphabet[group >> 18];
+        output[length++] = gci_base64_alphabet[group >> 12 & 0x3f];
+        output[length++] = gci_base64_alphabet[group >> 6 & 0x3f];
+        output[length++] = gci_base64_alphabet[group & 0x3f];
+    }
+
+    if (index < data_size) {
+        uint32_t group = (uint32_t) input[index] << 16;
+        if (index + 1 < data_size) {
+            group |= (uint32_t) input[index + 1] << 8;
+        }
+        output[length++] = gci_base64_alphabet[group >> 18];
+        output[length++] = gci_base64_alphabet[group >> 12 & 0x3f];
+        output[length++] = index + 1 < data_size ? gci_base64_alphabet[group >> 6 & 0x3f] : '=';
+        output[length++] = '=';
+    }
+
+    return length;
+}
+
+// Value of a base64 character or -1 if it is not one
+static inline int gci_base64_value(unsigned char character) {
+    if ('A' <= character && character <= 'Z') { return character - 'A'; }
+    if ('a' <= character && character <= 'z') { return character - 'a' + 26; }
+    if ('0' <= character && character <= '9') { return character - '0' + 52; }
+    if (character == '+') { return 62; }
+    if (character == '/') { return 63; }
+    return -1;
+}
+
+bool gci_base64_decode_scalar(char *output, size_t *output_size, char const *data, size_t data_size) {
+    assert(output_size != NULL);
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+    unsigned char const *input = (unsigned char const*) data;
+
+    *output_size = 0;
+    if (data_size % 4 != 0) { return false; }
+
+    size_t length = 0;
+    for (size_t index = 0; index < data_size; index += 4) {
+        int a = gci_base64_value(input[index]);
+        int b = gci_base64_value(input[index + 1]);
+        int c = gci_base64_value(input[index + 2]);
+        int d = gci_base64_value(input[index + 3]);
+
+        if (a < 0 || b < 0) { return false; }
+        if (c < 0 || d < 0) {
+            // Padding, only allowed to end the last group
+            if (index + 4 != data_size || input[index + 3] != '=') { return false; }
+            if (c < 0 && input[index + 2] != '=') { return false; }
+
+            uint32_t group = (uint32_t) a << 18 | (uint32_t) b << 12 | (uint32_t) (c < 0 ? 0 : c) << 6;
+            output[length++] = (char) (group >> 16);
+            if (c >= 0) {
+                output[length++] = (char) (group >> 8 & 0xff);
+            }
+            break;
+        }
+
+        uint32_t group = (uint32_t) a << 18 | (uint32_t) b << 12 | (uint32_t) c << 6 | (uint32_t) d;
+        output[length++] = (char) (group >> 16);
+        output[length++] = (char) (group >> 8 & 0xff);
+        output[length++] = (char) (group & 0xff);
+    }
+
+    *output_size = length;
+    return true;
+}
+
+size_t gci_hex_encode_scalar(char *output, char const *data, size_t data_size) {
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+    unsigned char const *input = (unsigned char const*) data;
+
+    for (size_t index = 0; index < data_size; index++) {
+        output[2 * index] = gci_hex_digits[input[index] >> 4];
+        output[2 * index + 1] = gci_hex_digits[input[index] & 0xf];
+    }
+    return 2 * data_size;
+}
+
+// Value of a hexadecimal digit of either case or -1 if it is not one
+static inline int gci_hex_value(unsigned char character) {
+    if ('0' <= character && character <= '9') { return character - '0'; }
+    unsigned char lower = character | 0x20;
+    if ('a' <= lower && lower <= 'f') { return lower - 'a' + 10; }
+    return -1;
+}
+
+bool gci_hex_decode_scalar(char *output, char const *data, size_t data_size) {
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+    unsigned char const *input = (unsigned char const*) data;
+
+    if (data_size % 2 != 0) { return false; }
+
+    for (size_t index = 0; index < data_size; index += 2) {
+        int high = gci_hex_value(input[index]);
+        int low = gci_hex_value(input[index + 1]);
+        if (high < 0 || low < 0) { return false; }
+        output[index / 2] = (char) (high << 4 | low);
+    }
+    return true;
+}
+
+// Follows table 3-7 of the Unicode standard, which excludes overlong forms,
+// surrogates and code points past U+10FFFF through the allowed range of the
+// second byte
+size_t gci_utf8_validate_scalar(char const *data, size_t data_size, bool *incomplete) {
+    assert(incomplete != NULL);
+    assert(data != NULL || data_size == 0);
+    unsigned char const *input = (unsigned char const*) data;
+
+    *incomplete = false;
+    size_t index = 0;
+    while (index < data_size) {
+        // Eight ascii bytes at a time
+        if (index + 8 <= data_size) {
+            uint64_t word;
+            memcpy(&word, input + index, sizeof(word));
+            if ((word & UINT64_C(0x8080808080808080)) == 0) {
+                index += 8;
+                continue;
+            }
+        }
+
+        unsigned char lead = input[index];
+        if (lead < 0x80) {
+            index += 1;
+            continue;
+        }
+
+        size_t length;
+        unsigned char low = 0x80;
+        unsigned char high = 0xbf;
+        if (0xc2 <= lead && lead <= 0xdf) {
+            length = 2;
+        } else if (0xe0 <= lead && lead <= 0xef) {
+            length = 3;
+            if (lead == 0xe0) { low = 0xa0; }
+            if (lead == 0xed) { high = 0x9f; }
+        } else if (0xf0 <= lead && lead <= 0xf4) {
+            length = 4;
+            if (lead == 0xf0) { low = 0x90; }
+            if (lead == 0xf4) { high = 0x8f; }
+        } else {
+            return index;
+        }
+
+        size_t available = data_size - index;
+        for (size_t offset = 1; offset < length; offset++) {
+            if (offset >= available) {
+                *incomplete = true;
+                return index;
+            }
+
+            unsigned char byte = input[index + offset];
+            bool valid = offset == 1 ? low <= byte && byte <= high : (byte & 0xc0) == 0x80;
+            if (!valid) { return index; }
+        }
+
+        index += length;
+    }
+
+    return index;
+}
+
+// Finds where the scalar check takes over from a vector check which stopped
+// at `index`. Everything before `index` has been checked, except that a
+// sequence may be cut off by `index`, so this backs up to its lead byte.
+size_t gci_utf8_boundary(char const *data, size_t index) {
+    unsigned char const *input = (unsigned char const*) data;
+    for (size_t back = 1; back <= 3 && back <= index; back++) {
+        unsigned char byte = input[index - back];
+        if ((byte & 0xc0) != 0x80) {
+            return byte >= 0xc0 ? index - back : index;
+        }
+    }
+    return index;
+}
+
+#ifdef GCI_ENCODE_X86
+// Bits of the lookup tables of the UTF-8 check, every error sets a bit
+// in both the lookups of the first byte and of the second byte.
+#define GCI_UTF8_TOO_SHORT  (1 << 0)
+#define GCI_UTF8_TOO_LONG   (1 << 1)
+#define GCI_UTF8_OVERLONG_3 (1 << 2)
+#define GCI_UTF8_TOO_LARGE  (1 << 3)
+#define GCI_UTF8_SURROGATE  (1 << 4)
+#define GCI_UTF8_OVERLONG_2 (1 << 5)
+#define GCI_UTF8_TOO_LARGE_1000 (1 << 6)
+#define GCI_UTF8_OVERLONG_4 (1 << 6)
+#define GCI_UTF8_TWO_CONTS  (1 << 7)
+#define GCI_UTF8_CARRY (GCI_UTF8_TOO_SHORT | GCI_UTF8_TOO_LONG | GCI_UTF8_TWO_CONTS)
+
+#define GCI_UTF8_BYTE_1_HIGH \
+    GCI_UTF8_TOO_LONG, GCI_UTF8_TOO_LONG, GCI_UTF8_TOO_LONG, GCI_UTF8_TOO_LONG, \
+    GCI_UTF8_TOO_LONG, GCI_UTF8_TOO_LONG, GCI_UTF8_TOO_LONG, GCI_UTF8_TOO_LONG, \
+    GCI_UTF8_TWO_CONTS, GCI_UTF8_TWO_CONTS, GCI_UTF8_TWO_CONTS, GCI_UTF8_TWO_CONTS, \
+    GCI_UTF8_TOO_SHORT | GCI_UTF8_OVERLONG_2, \
+    GCI_UTF8_TOO_SHORT, \
+    GCI_UTF8_TOO_SHORT | GCI_UTF8_OVERLONG_3 | GCI_UTF8_SURROGATE, \
+    GCI_UTF8_TOO_SHORT | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000 | GCI_UTF8_OVERLONG_4
+
+#define GCI_UTF8_BYTE_1_LOW \
+    GCI_UTF8_CARRY | GCI_UTF8_OVERLONG_3 | GCI_UTF8_OVERLONG_2 | GCI_UTF8_OVERLONG_4, \
+    GCI_UTF8_CARRY | GCI_UTF8_OVERLONG_2, \
+    GCI_UTF8_CARRY, \
+    GCI_UTF8_CARRY, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000 | GCI_UTF8_SURROGATE, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000, \
+    GCI_UTF8_CARRY | GCI_UTF8_TOO_LARGE | GCI_UTF8_TOO_LARGE_1000
+
+#define GCI_UTF8_BYTE_2_HIGH \
+    GCI_UTF8_TOO_SHORT, GCI_UTF8_TOO_SHORT, GCI_UTF8_TOO_SHORT, GCI_UTF8_TOO_SHORT, \
+    GCI_UTF8_TOO_SHORT, GCI_UTF8_TOO_SHORT, GCI_UTF8_TOO_SHORT, GCI_UTF8_TOO_SHORT, \
+    GCI_UTF8_TOO_LONG | GCI_UTF8_OVERLONG_2 | GCI_UTF8_TWO_CONTS | GCI_UTF8_OVERLONG_3 | GCI_UTF8_TOO_LARGE_1000 | GCI_UTF8_OVERLONG_4, \
+    GCI_UTF8_TOO_LONG | GCI_UTF8_OVERLONG_2 | GCI_UTF8_TWO_CONTS | GCI_UTF8_OVERLONG_3 | GCI_UTF8_TOO_LARGE, \
+    GCI_UTF8_TOO_LONG | GCI_UTF8_OVERLONG_2 | GCI_UTF8_TWO_CONTS | GCI_UTF8_SURROGATE | GCI_UTF8_TOO_LARGE, \
+    GCI_UTF8_TOO_LONG | GCI_UTF8_OVERLONG_2 | GCI_UTF8_TWO_CONTS | GCI_UTF8_SURROGATE | GCI_UTF8_TOO_LARGE, \
+    GCI_UTF8_TOO_SHORT, GCI_UTF8_TOO_SHORT, GCI_UTF8_TOO_SHORT, GCI_UTF8_TOO_SHORT
+
+static unsigned char const gci_utf8_byte_1_high[16] = { GCI_UTF8_BYTE_1_HIGH };
+static unsigned char const gci_utf8_byte_1_low[16] = { GCI_UTF8_BYTE_1_LOW };
+static unsigned char const gci_utf8_byte_2_high[16] = { GCI_UTF8_BYTE_2_HIGH };
+
+__attribute__((target("sse4.2")))
+size_t gci_base64_encode_sse42(char *output, char const *data, size_t data_size) {
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+
+    __m128i const shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    __m128i const shift = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+    );
+
+    // Each iteration loads 16 bytes and encodes the first 12 of them
+    size_t length = 0;
+    size_t index = 0;
+    for (; index + 16 <= data_size; index += 12) {
+        __m128i input = _mm_loadu_si128((__m128i const*) (data + index));
+        input = _mm_shuffle_epi8(input, shuffle);
+
+        // Moves the four 6 bit fields of every 3 bytes into their own byte
+        __m128i high = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        __m128i low = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(high, low);
+
+        __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        __m128i letters = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        reduced = _mm_or_si128(reduced, _mm_and_si128(letters, _mm_set1_epi8(13)));
+        __m128i characters = _mm_add_epi8(_mm_shuffle_epi8(shift, reduced), indices);
+
+        _mm_storeu_si128((__m128i*) (output + length), characters);
+        length += 16;
+    }
+
+    return length + gci_base64_encode_scalar(output + length, data + index, data_size - index);
+}
+
+// Turns 16 base64 characters into their values, false if any is not a
+// base64 character
+__attribute__((target("sse4.2")))
+static inline bool gci_base64_values_sse42(__m128i *values) {
+    __m128i const lookup_low = _mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a
+    );
+    __m128i const lookup_high = _mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+    );
+    __m128i const lookup_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i const mask = _mm_set1_epi8(0x2f);
+
+    __m128i input = *values;
+    __m128i high_nibbles = _mm_and_si128(_mm_srli_epi32(input, 4), mask);
+    __m128i low_nibbles = _mm_and_si128(input, mask);
+    __m128i low = _mm_shuffle_epi8(lookup_low, low_nibbles);
+    __m128i high = _mm_shuffle_epi8(lookup_high, high_nibbles);
+    if (!_mm_testz_si128(low, high)) {
+        return false;
+    }
+
+    __m128i slash = _mm_cmpeq_epi8(input, mask);
+    __m128i roll = _mm_shuffle_epi8(lookup_roll, _mm_add_epi8(slash, high_nibbles));
+    *values = _mm_add_epi8(input, roll);
+    return true;
+}
+
+// Packs the 6 bit values of every 4 bytes into 3 bytes, leaving them in
+// the low 24 bits of each 32 bit lane in memory order
+__attribute__((target("sse4.2")))
+static inline __m128i gci_base64_pack_sse42(__m128i values) {
+    __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    return _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+}
+
+__attribute__((target("sse4.2")))
+bool gci_base64_decode_sse42(char *output, size_t *output_size, char const *data, size_t data_size) {
+    assert(output_size != NULL);
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+
+    __m128i const shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    *output_size = 0;
+    if (data_size % 4 != 0) { return false; }
+
+    // Stops while at least 8 characters are left, which keeps the padded
+    // last group out of the vector loop and leaves room for the 4 bytes
+    // stored past the 12 decoded ones
+    size_t length = 0;
+    size_t index = 0;
+    for (; index + 24 <= data_size; index += 16) {
+        __m128i values = _mm_loadu_si128((__m128i const*) (data + index));
+        if (!gci_base64_values_sse42(&values)) {
+            return false;
+        }
+
+        __m128i bytes = _mm_shuffle_epi8(gci_base64_pack_sse42(values), shuffle);
+        _mm_storeu_si128((__m128i*) (output + length), bytes);
+        length += 12;
+    }
+
+    size_t tail_size;
+    bool result = gci_base64_decode_scalar(output + length, &tail_size, data + index, data_size - index);
+    *output_size = result ? length + tail_size : 0;
+    return result;
+}
+
+__attribute__((target("sse4.2")))
+size_t gci_hex_encode_sse42(char *output, char const *data, size_t data_size) {
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+
+    __m128i const digits = _mm_loadu_si128((__m128i const*) gci_hex_digits);
+    __m128i const mask = _mm_set1_epi8(0x0f);
+
+    size_t index = 0;
+    for (; index + 16 <= data_size; index += 16) {
+        __m128i input = _mm_loadu_si128((__m128i const*) (data + index));
+        __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(input, 4), mask));
+        __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(input, mask));
+
+        _mm_storeu_si128((__m128i*) (output + 2 * index), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i*) (output + 2 * index + 16), _mm_unpackhi_epi8(high, low));
+    }
+
+    return 2 * index + gci_hex_encode_scalar(output + 2 * index, data + index, data_size - index);
+}
+
+// Turns 16 hexadecimal digits into their values, false if any is not a
+// hexadecimal digit
+__attribute__((target("sse4.2")))
+static inline bool gci_hex_values_sse42(__m128i *values) {
+    __m128i input = *values;
+    __m128i digit = _mm_sub_epi8(input, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(input, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+
+    if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff) {
+        return false;
+    }
+
+    letter = _mm_add_epi8(letter, _mm_set1_epi8(10));
+    *values = _mm_blendv_epi8(letter, digit, is_digit);
+    return true;
+}
+
+__attribute__((target("sse4.2")))
+bool gci_hex_decode_sse42(char *output, char const *data, size_t data_size) {
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+
+    if (data_size % 2 != 0) { return false; }
+
+    __m128i const weights = _mm_set1_epi16(0x0110);
+
+    size_t index = 0;
+    for (; index + 32 <= data_size; index += 32) {
+        __m128i first = _mm_loadu_si128((__m128i const*) (data + index));
+        __m128i second = _mm_loadu_si128((__m128i const*) (data + index + 16));
+        if (!gci_hex_values_sse42(&first) || !gci_hex_values_sse42(&second)) {
+            return false;
+        }
+
+        first = _mm_maddubs_epi16(first, weights);
+        second = _mm_maddubs_epi16(second, weights);
+        _mm_storeu_si128((__m128i*) (output + index / 2), _mm_packus_epi16(first, second));
+    }
+
+    return gci_hex_decode_scalar(output + index / 2, data + index, data_size - index);
+}
+
+// The bytes of `input` shifted by `amount` with the last bytes of `previous`
+// shifted in
+#define GCI_UTF8_PREVIOUS_SSE42(input, previous, amount) _mm_alignr_epi8(input, previous, 16 - (amount))
+
+__attribute__((target("sse4.2")))
+static inline __m128i gci_utf8_check_sse42(__m128i input, __m128i previous) {
+    __m128i const mask = _mm_set1_epi8(0x0f);
+    __m128i const byte_1_high = _mm_loadu_si128((__m128i const*) gci_utf8_byte_1_high);
+    __m128i const byte_1_low = _mm_loadu_si128((__m128i const*) gci_utf8_byte_1_low);
+    __m128i const byte_2_high = _mm_loadu_si128((__m128i const*) gci_utf8_byte_2_high);
+
+    __m128i previous1 = GCI_UTF8_PREVIOUS_SSE42(input, previous, 1);
+    __m128i special = _mm_and_si128(
+        _mm_and_si128(
+            _mm_shuffle_epi8(byte_1_high, _mm_and_si128(_mm_srli_epi16(previous1, 4), mask)),
+            _mm_shuffle_epi8(byte_1_low, _mm_and_si128(previous1, mask))
+        ),
+        _mm_shuffle_epi8(byte_2_high, _mm_and_si128(_mm_srli_epi16(input, 4), mask))
+    );
+
+    // Bytes which must be the second or third continuation of a 3 or 4 byte
+    // sequence, where the lookups flag two continuations in a row
+    __m128i previous2 = GCI_UTF8_PREVIOUS_SSE42(input, previous, 2);
+    __m128i previous3 = GCI_UTF8_PREVIOUS_SSE42(input, previous, 3);
+    __m128i third = _mm_subs_epu8(previous2, _mm_set1_epi8((char) (0xe0 - 0x80)));
+    __m128i fourth = _mm_subs_epu8(previous3, _mm_set1_epi8((char) (0xf0 - 0x80)));
+    __m128i continuation = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((char) 0x80));
+
+    return _mm_xor_si128(continuation, special);
+}
+
+__attribute__((target("sse4.2")))
+size_t gci_utf8_validate_sse42(char const *data, size_t data_size, bool *incomplete) {
+    assert(incomplete != NULL);
+    assert(data != NULL || data_size == 0);
+
+    // Non-zero in the last bytes if a sequence starting there needs bytes
+    // of the next block
+    __m128i const incomplete_limit = _mm_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        (char) (0xf0 - 1), (char) (0xe0 - 1), (char) (0xc0 - 1)
+    );
+
+    __m128i previous = _mm_setzero_si128();
+    __m128i previous_incomplete = _mm_setzero_si128();
+
+    size_t index = 0;
+    for (; index + 16 <= data_size; index += 16) {
+        __m128i input = _mm_loadu_si128((__m128i const*) (data + index));
+
+        __m128i error;
+        if (_mm_movemask_epi8(input) == 0) {
+            // Ascii only, valid unless the last block left a sequence open
+            error = previous_incomplete;
+            previous_incomplete = _mm_setzero_si128();
+        } else {
+            error = gci_utf8_check_sse42(input, previous);
+            previous_incomplete = _mm_subs_epu8(input, incomplete_limit);
+        }
+
+        if (!_mm_testz_si128(error, error)) { break; }
+        previous = input;
+    }
+
+    size_t start = gci_utf8_boundary(data, index);
+    return start + gci_utf8_validate_scalar(data + start, data_size - start, incomplete);
+}
+
+__attribute__((target("avx2")))
+size_t gci_base64_encode_avx2(char *output, char const *data, size_t data_size) {
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+
+    __m256i const shuffle = _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+    );
+    __m256i const shift = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+    );
+
+    // Each lane encodes 12 bytes, the second lane is loaded 12 bytes after
+    // the first
+    size_t length = 0;
+    size_t index = 0;
+    for (; index + 28 <= data_size; index += 24) {
+        __m128i first = _mm_loadu_si128((__m128i const*) (data + index));
+        __m128i second = _mm_loadu_si128((__m128i const*) (data + index + 12));
+        __m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1);
+        input = _mm256_shuffle_epi8(input, shuffle);
+
+        __m256i high = _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        __m256i low = _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        __m256i indices = _mm256_or_si256(high, low);
+
+        __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        __m256i letters = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        reduced = _mm256_or_si256(reduced, _mm256_and_si256(letters, _mm256_set1_epi8(13)));
+        __m256i characters = _mm256_add_epi8(_mm256_shuffle_epi8(shift, reduced), indices);
+
+        _mm256_storeu_si256((__m256i*) (output + length), characters);
+        length += 32;
+    }
+
+    return length + gci_base64_encode_sse42(output + length, data + index, data_size - index);
+}
+
+__attribute__((target("avx2")))
+bool gci_base64_decode_avx2(char *output, size_t *output_size, char const *data, size_t data_size) {
+    assert(output_size != NULL);
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+
+    __m256i const lookup_low = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a
+    );
+    __m256i const lookup_high = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+    );
+    __m256i const lookup_roll = _mm256_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+    );
+    __m256i const mask = _mm256_set1_epi8(0x2f);
+    __m256i const shuffle = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+    );
+    __m256i const gather = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1);
+
+    *output_size = 0;
+    if (data_size % 4 != 0) { return false; }
+
+    // Stops while at least 12 characters are left, see the SSE kernel
+    size_t length = 0;
+    size_t index = 0;
+    for (; index + 44 <= data_size; index += 32) {
+        __m256i input = _mm256_loadu_si256((__m256i const*) (data + index));
+
+        __m256i high_nibbles = _mm256_and_si256(_mm256_srli_epi32(input, 4), mask);
+        __m256i low_nibbles = _mm256_and_si256(input, mask);
+        __m256i low = _mm256_shuffle_epi8(lookup_low, low_nibbles);
+        __m256i high = _mm256_shuffle_epi8(lookup_high, high_nibbles);
+        if (!_mm256_testz_si256(low, high)) {
+            return false;
+        }
+
+        __m256i slash = _mm256_cmpeq_epi8(input, mask);
+        __m256i roll = _mm256_shuffle_epi8(lookup_roll, _mm256_add_epi8(slash, high_nibbles));
+        __m256i values = _mm256_add_epi8(input, roll);
+
+        __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        __m256i packed = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(packed, shuffle), gather);
+
+        _mm256_storeu_si256((__m256i*) (output + length), bytes);
+        length += 24;
+    }
+
+    size_t tail_size;
+    bool result = gci_base64_decode_sse42(output + length, &tail_size, data + index, data_size - index);
+    *output_size = result ? length + tail_size : 0;
+    return result;
+}
+
+__attribute__((target("avx2")))
+size_t gci_hex_encode_avx2(char *output, char const *data, size_t data_size) {
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+
+    __m256i const digits = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const*) gci_hex_digits));
+    __m256i const mask = _mm256_set1_epi8(0x0f);
+
+    size_t index = 0;
+    for (; index + 32 <= data_size; index += 32) {
+        __m256i input = _mm256_loadu_si256((__m256i const*) (data + index));
+        __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(input, 4), mask));
+        __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(input, mask));
+
+        // The unpacks work within lanes, so the halves are put back in order
+        __m256i first = _mm256_unpacklo_epi8(high, low);
+        __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256((__m256i*) (output + 2 * index), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256((__m256i*) (output + 2 * index + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+
+    return 2 * index + gci_hex_encode_sse42(output + 2 * index, data + index, data_size - index);
+}
+
+__attribute__((target("avx2")))
+static inline bool gci_hex_values_avx2(__m256i *values) {
+    __m256i input = *values;
+    __m256i digit = _mm256_sub_epi8(input, _mm256_set1_epi8('0'));
+    __m256i letter = _mm256_sub_epi8(_mm256_or_si256(input, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+
+    if ((unsigned) _mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != 0xffffffffu) {
+        return false;
+    }
+
+    letter = _mm256_add_epi8(letter, _mm256_set1_epi8(10));
+    *values = _mm256_blendv_epi8(letter, digit, is_digit);
+    return true;
+}
+
+__attribute__((target("avx2")))
+bool gci_hex_decode_avx2(char *output, char const *data, size_t data_size) {
+    assert(output != NULL || data_size == 0);
+    assert(data != NULL || data_size == 0);
+
+    if (data_size % 2 != 0) { return false; }
+
+    __m256i const weights = _mm256_set1_epi16(0x0110);
+
+    size_t index = 0;
+    for (; index + 64 <= data_size; index += 64) {
+        __m256i first = _mm256_loadu_si256((__m256i const*) (data + index));
+        __m256i second = _mm256_loadu_si256((__m256i const*) (data + index + 32));
+        if (!gci_hex_values_avx2(&first) || !gci_hex_values_avx2(&second)) {
+            return false;
+        }
+
+        first = _mm256_maddubs_epi16(first, weights);
+        second = _mm256_maddubs_epi16(second, weights);
+        __m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0xd8);
+        _mm256_storeu_si256((__m256i*) (output + index / 2), bytes);
+    }
+
+    return gci_hex_decode_sse42(output + index / 2, data + index, data_size - index);
+}
+
+// See `GCI_UTF8_PREVIOUS_SSE42`, the lanes are joined first since alignr
+// works within lanes
+#define GCI_UTF8_PREVIOUS_AVX2(input, previous, amount) \
+    _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - (amount))
+
+__attribute__((target("avx2")))
+static inline __m256i gci_utf8_check_avx2(__m256i input, __m256i previous) {
+    __m256i const mask = _mm256_set1_epi8(0x0f);
+    __m256i const byte_1_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const*) gci_utf8_byte_1_high));
+    __m256i const byte_1_low = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const*) gci_utf8_byte_1_low));
+    __m256i const byte_2_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const*) gci_utf8_byte_2_high));
+
+    __m256i previous1 = GCI_UTF8_PREVIOUS_AVX2(input, previous, 1);
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(
+            _mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(previous1, 4), mask)),
+            _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(previous1, mask))
+        ),
+        _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), mask))
+    );
+
+    __m256i previous2 = GCI_UTF8_PREVIOUS_AVX2(input, previous, 2);
+    __m256i previous3 = GCI_UTF8_PREVIOUS_AVX2(input, previous, 3);
+    __m256i third = _mm256_subs_epu8(previous2, _mm256_set1_epi8((char) (0xe0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(previous3, _mm256_set1_epi8((char) (0xf0 - 0x80)));
+    __m256i continuation = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char) 0x80));
+
+    return _mm256_xor_si256(continuation, special);
+}
+
+__attribute__((target("avx2")))
+size_t gci_utf8_validate_avx2(char const *data, size_t data_size, bool *incomplete) {
+    assert(incomplete != NULL);
+    assert(data != NULL || data_size == 0);
+
+    __m256i const incomplete_limit = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        (char) (0xf0 - 1), (char) (0xe0 - 1), (char) (0xc0 - 1)
+    );
+
+    __m256i previous = _mm256_setzero_si256();
+    __m256i previous_incomplete = _mm256_setzero_si256();
+
+    size_t index = 0;
+    for (; index + 32 <= data_size; index += 32) {
+        __m256i input = _mm256_loadu_si256((__m256i const*) (data + index));
+
+        __m256i error;
+        if (_mm256_movemask_epi8(input) == 0) {
+            error = previous_incomplete;
+            previous_incomplete = _mm256_setzero_si256();
+        } else {
+            error = gci_utf8_check_avx2(input, previous);
+            previous_incomplete = _mm256_subs_epu8(input, incomplete_limit);
+        }
+
+        if (!_mm256_testz_si256(error, error)) { break; }
+        previous = input;
+    }
+
+    size_t start = gci_utf8_boundary(data, index);
+    return start + gci_utf8_validate_sse42(data + start, data_size - start, incomplete);
+}
+#endif
+
+enum GciError gci_writer_encode_init(struct GciWriterEncode *context, struct GciInterfaceWriter writer, enum GciEncoding encoding) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (encoding != GCI_ENCODING_HEX && encoding != GCI_ENCODING_BASE64) { return GCI_ERROR_BUFFER; }
+
+    context->writer = writer;
+    context->encoding = encoding;
+    context->pending_size = 0;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceWriter gci_writer_encode_interface(struct GciWriterEncode *context) {
+    return (struct GciInterfaceWriter) { .context = context, .write = gci_writer_encode_write };
+}
+
+// Encodes whole groups of `data` into memory reserved from the internal
+// writer, a chunk at a time
+bool gci_writer_encode_groups(struct GciWriterEncode *context, char const *data, size_t data_size) {
+    assert(context != NULL);
+    char scratch[GCI_ENCODE_SCRATCH];
+    size_t chunk = context->encoding == GCI_ENCODING_HEX ? GCI_ENCODE_HEX_CHUNK : GCI_ENCODE_CHUNK;
+
+    while (data_size > 0) {
+        size_t length = data_size > chunk ? chunk : data_size;
+        size_t encoded_size = context->encoding == GCI_ENCODING_HEX ? 2 * length : (length + 2) / 3 * 4;
+
+        char *reserved = gci_writer_reserve(context->writer, encoded_size, scratch, sizeof(scratch));
+        if (reserved == NULL) { return false; }
+
+        if (context->encoding == GCI_ENCODING_HEX) {
+            gci_hex_encode(reserved, data, length);
+        } else {
+            gci_base64_encode(reserved, data, length);
+        }
+
+        if (gci_writer_commit(context->writer, reserved, encoded_size, scratch) != encoded_size) {
+            return false;
+        }
+
+        data += length;
+        data_size -= length;
+    }
+
+    return true;
+}
+
+size_t gci_writer_encode_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciWriterEncode *context = (struct GciWriterEncode*) void_context;
+
+    if (context->encoding == GCI_ENCODING_HEX) {
+        return gci_writer_encode_groups(context, data, data_size) ? data_size : 0;
+    }
+
+    // Completes the group left over by the last write first
+    size_t used = 0;
+    if (context->pending_size > 0) {
+        while (context->pending_size < 3 && used < data_size) {
+            context->pending[context->pending_size++] = data[used++];
+        }
+        if (context->pending_size < 3) {
+            return used;
+        }
+        if (!gci_writer_encode_groups(context, context->pending, 3)) {
+            return 0;
+        }
+        context->pending_size = 0;
+    }
+
+    size_t groups = (data_size - used) / 3 * 3;
+    if (!gci_writer_encode_groups(context, data + used, groups)) {
+        return used;
+    }
+    used += groups;
+
+    memcpy(context->pending, data + used, data_size - used);
+    context->pending_size = data_size - used;
+    return data_size;
+}
+
+bool gci_writer_encode_finish(struct GciWriterEncode *context) {
+    assert(context != NULL);
+
+    bool result = gci_writer_encode_groups(context, context->pending, context->pending_size);
+    context->pending_size = 0;
+    return result;
+}
+
+enum GciError gci_reader_decode_init(
+    struct GciReaderDecode *context,
+    struct GciInterfaceReader reader,
+    enum GciEncoding encoding,
+    char *buffer,
+    size_t buffer_size
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (buffer == NULL) { return GCI_ERROR_NULL; }
+    if (encoding != GCI_ENCODING_HEX && encoding != GCI_ENCODING_BASE64) { return GCI_ERROR_BUFFER; }
+    if (buffer_size < 4) { return GCI_ERROR_BUFFER; }
+
+    context->reader = reader;
+    context->encoding = encoding;
+    context->buffer = buffer;
+    context->buffer_size = buffer_size;
+    context->start = 0;
+    context->end = 0;
+    context->decoded_start = 0;
+    context->decoded_end = 0;
+    context->padded = false;
+    context->error = false;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceReader gci_reader_decode_interface(struct GciReaderDecode *context) {
+    return (struct GciInterfaceReader) {
+        .context = context,
+        .read = gci_reader_decode_read,
+        .eof = gci_reader_decode_eof,
+    };
+}
+
+// Decodes `group_count` buffered groups into `output`, notes base64 padding.
+// If a group is invalid `output_size` is set to the bytes decoded before it.
+bool gci_reader_decode_groups(struct GciReaderDecode *context, char *output, size_t *output_size, size_t group_count) {
+    assert(context != NULL);
+    bool hex = context->encoding == GCI_ENCODING_HEX;
+    size_t group_in = hex ? 2 : 4;
+    char const *data = context->buffer + context->start;
+    context->start += group_in * group_count;
+
+    if (hex && gci_hex_decode(output, data, 2 * group_count)) {
+        *output_size = group_count;
+        return true;
+    }
+    if (!hex && gci_base64_decode(output, output_size, data, 4 * group_count)) {
+        context->padded = *output_size < 3 * group_count;
+        return true;
+    }
+
+    // Decodes a group at a time to find the invalid one
+    *output_size = 0;
+    for (size_t group = 0; group < group_count && !context->padded; group++) {
+        size_t size = 1;
+        char *group_output = output + *output_size;
+        char const *group_data = data + group * group_in;
+
+        bool valid = hex
+            ? gci_hex_decode(group_output, group_data, group_in)
+            : gci_base64_decode(group_output, &size, group_data, group_in);
+        if (!valid) { break; }
+
+        context->padded = !hex && size < 3;
+        *output_size += size;
+    }
+    return false;
+}
+
+size_t gci_reader_decode_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    assert(buffer != NULL);
+    struct GciReaderDecode *context = (struct GciReaderDecode*) void_context;
+
+    size_t group_in = context->encoding == GCI_ENCODING_HEX ? 2 : 4;
+    size_t group_out = context->encoding == GCI_ENCODING_HEX ? 1 : 3;
+
+    size_t length = context->decoded_end - context->decoded_start;
+    length = length > buffer_size ? buffer_size : length;
+    memcpy(buffer, context->decoded + context->decoded_start, length);
+    context->decoded_start += length;
+
+    while (length < buffer_size && !context->error) {
+        size_t available = (context->end - context->start) / group_in;
+
+        if (available == 0) {
+            size_t left = context->end - context->start;
+            memmove(context->buffer, context->buffer + context->start, left);
+            context->start = 0;
+            context->end = left;
+
+            size_t amount = gci_reader_read(context->reader, context->buffer + left, context->buffer_size - left);
+            if (amount == 0) {
+                // A cut off group is invalid, otherwise the source ended
+                context->error = left > 0 || !gci_reader_eof(context->reader);
+                break;
+            }
+            context->end += amount;
+            continue;
+        }
+
+        if (context->padded) {
+            context->error = true;
+            break;
+        }
+
+        size_t fit = (buffer_size - length) / group_out;
+        if (fit == 0) {
+            // Too little room for a whole group, the rest is kept for later
+            size_t decoded_size;
+            if (!gci_reader_decode_groups(context, context->decoded, &decoded_size, 1)) {
+                context->error = true;
+                break;
+            }
+            context->decoded_start = 0;
+            context->decoded_end = decoded_size;
+
+            size_t amount = buffer_size - length < decoded_size ? buffer_size - length : decoded_size;
+            memcpy(buffer + length, context->decoded, amount);
+            context->decoded_start = amount;
+            length += amount;
+            continue;
+        }
+
+        size_t decoded_size;
+        size_t groups = available < fit ? available : fit;
+        bool valid = gci_reader_decode_groups(context, buffer + length, &decoded_size, groups);
+        length += decoded_size;
+        if (!valid) {
+            context->error = true;
+            break;
+        }
+    }
+
+    // The bytes decoded before an error are still returned, the next call
+    // fails
+    return length;
+}
+
+bool gci_reader_decode_eof(void const *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderDecode *context = (struct GciReaderDecode*) void_context;
+    return !context->error
+        && context->start == context->end
+        && context->decoded_start == context->decoded_end
+        && gci_reader_eof(context->reader);
+}
+
+enum GciError gci_reader_utf8_init(struct GciReaderUtf8 *context, struct GciInterfaceReader reader) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->reader = reader;
+    context->pending_size = 0;
+    context->pending_checked = false;
+    context->error = false;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceReader gci_reader_utf8_interface(struct GciReaderUtf8 *context) {
+    return (struct GciInterfaceReader) {
+        .context = context,
+        .read = gci_reader_utf8_read,
+        .eof = gci_reader_utf8_eof,
+    };
+}
+
+// Reads the bytes completing the sequence held back by the last read and
+// checks it, false if it is invalid or can no longer be completed
+bool gci_reader_utf8_complete(struct GciReaderUtf8 *context) {
+    assert(context != NULL);
+    assert(context->pending_size > 0);
+
+    size_t lead = (unsigned char) context->pending[0];
+    size_t sequence = lead >= 0xf0 ? 4 : lead >= 0xe0 ? 3 : 2;
+    while (context->pending_size < sequence) {
+        char *missing = context->pending + context->pending_size;
+        size_t amount = gci_reader_read(context->reader, missing, sequence - context->pending_size);
+        if (amount == 0) { return false; }
+        context->pending_size += amount;
+    }
+
+    bool incomplete;
+    context->pending_checked = gci_utf8_validate_scalar(context->pending, sequence, &incomplete) == sequence;
+    return context->pending_checked;
+}
+
+size_t gci_reader_utf8_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    assert(buffer != NULL);
+    struct GciReaderUtf8 *context = (struct GciReaderUtf8*) void_context;
+
+    if (context->error) {
+        return 0;
+    }
+
+    // Loops while everything read so far is held back
+    size_t length = 0;
+    while (length == 0 && buffer_size > 0) {
+        if (context->pending_size > 0 && !context->pending_checked) {
+            if (!gci_reader_utf8_complete(context)) {
+                context->error = true;
+                return 0;
+            }
+        }
+
+        // A checked sequence which did not fit the last buffer
+        if (context->pending_size > 0) {
+            length = context->pending_size > buffer_size ? buffer_size : context->pending_size;
+            memcpy(buffer, context->pending, length);
+            memmove(context->pending, context->pending + length, context->pending_size - length);
+            context->pending_size -= length;
+            if (context->pending_size > 0) { return length; }
+            context->pending_checked = false;
+            if (length == buffer_size) { return length; }
+        }
+
+        size_t amount = gci_reader_read(context->reader, buffer + length, buffer_size - length);
+        if (amount == 0) {
+            return length;
+        }
+
+        bool incomplete;
+        size_t valid = gci_utf8_validate(buffer + length, amount, &incomplete);
+        if (valid < amount && !incomplete) {
+            context->error = true;
+            return length + valid;
+        }
+
+        // A sequence cut off by the end of the read is kept until the bytes
+        // completing it are read
+        assert(amount - valid < sizeof(context->pending));
+        context->pending_size = amount - valid;
+        memcpy(context->pending, buffer + length + valid, context->pending_size);
+        length += valid;
+    }
+
+    return length;
+}
+
+bool gci_reader_utf8_eof(void const *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderUtf8 *context = (struct GciReaderUtf8*) void_context;
+    return !context->error && context->pending_size == 0 && gci_reader_eof(context->reader);
+}
@@ -0,0 +1,213 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const simd_impl = @import("../simd/simd.zig");
+const reader = @import("../reader/reader.zig");
+const writer = @import("../writer/writer.zig");
+const Simd = simd_impl.Simd;
+const InterfaceReader = reader.InterfaceReader;
+const InterfaceWriter = writer.InterfaceWriter;
+
+pub const Encoding = enum(c_uint) {
+    hex = lib.GCI_ENCODING_HEX,
+    base64 = lib.GCI_ENCODING_BASE64,
+};
+
+pub fn base64EncodedSize(data_size: usize) usize {
+    return (data_size + 2) / 3 * 4;
+}
+
+// `output` must hold `base64EncodedSize(data.len)` bytes.
+pub fn base64Encode(output: []u8, data: []const u8) []u8 {
+    std.debug.assert(output.len >= base64EncodedSize(data.len));
+    const length = lib.gci_base64_encode(output.ptr, data.ptr, data.len);
+    return output[0..length];
+}
+
+// `output` must hold `data.len / 4 * 3` bytes.
+pub fn base64Decode(output: []u8, data: []const u8) ![]u8 {
+    std.debug.assert(output.len >= data.len / 4 * 3);
+    var length: usize = undefined;
+    if (!lib.gci_base64_decode(output.ptr, &length, data.ptr, data.len)) {
+        return error.Invalid;
+    }
+    return output[0..length];
+}
+
+// `output` must hold `2 * data.len` bytes.
+pub fn hexEncode(output: []u8, data: []const u8) []u8 {
+    std.debug.assert(output.len >= 2 * data.len);
+    const length = lib.gci_hex_encode(output.ptr, data.ptr, data.len);
+    return output[0..length];
+}
+
+// `output` must hold `data.len / 2` bytes.
+pub fn hexDecode(output: []u8, data: []const u8) ![]u8 {
+    std.debug.assert(output.len >= data.len / 2);
+    if (!lib.gci_hex_decode(output.ptr, data.ptr, data.len)) {
+        return error.Invalid;
+    }
+    return output[0 .. data.len / 2];
+}
+
+pub const Utf8Prefix = struct {
+    // Length of the longest prefix of complete and valid sequences.
+    valid: usize,
+    // The bytes after `valid` start a sequence which is cut off.
+    incomplete: bool,
+};
+
+pub fn utf8Validate(data: []const u8) Utf8Prefix {
+    var incomplete: bool = undefined;
+    const valid = lib.gci_utf8_validate(data.ptr, data.len, &incomplete);
+    return .{ .valid = valid, .incomplete = incomplete };
+}
+
+pub fn utf8ValidateSimd(simd: Simd, data: []const u8) Utf8Prefix {
+    var incomplete: bool = undefined;
+    const valid = lib.gci_utf8_validate_simd(@intFromEnum(simd), data.ptr, data.len, &incomplete);
+    return .{ .valid = valid, .incomplete = incomplete };
+}
+
+pub fn isUtf8(data: []const u8) bool {
+    return utf8Validate(data).valid == data.len;
+}
+
+pub const Writer = struct {
+    inner: lib.GciWriterEncode,
+
+    pub fn init(w: InterfaceWriter, encoding: Encoding) !Writer {
+        var self: Writer = undefined;
+        const err = lib.gci_writer_encode_init(&self.inner, w.writer, @intFromEnum(encoding));
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Writer) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_encode_interface(&self.inner) };
+    }
+
+    // Writes the padded last group of base64.
+    pub fn finish(self: *Writer) !void {
+        const result = lib.gci_writer_encode_finish(&self.inner);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+};
+
+pub const Reader = struct {
+    inner: lib.GciReaderDecode,
+
+    pub fn init(r: InterfaceReader, encoding: Encoding, buffer: []u8) !Reader {
+        var self: Reader = undefined;
+        const err = lib.gci_reader_decode_init(&self.inner, r.reader, @intFromEnum(encoding), buffer.ptr, buffer.len);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Reader) InterfaceReader {
+        return .{ .reader = lib.gci_reader_decode_interface(&self.inner) };
+    }
+};
+
+pub const ReaderUtf8 = struct {
+    inner: lib.GciReaderUtf8,
+
+    pub fn init(r: InterfaceReader) !ReaderUtf8 {
+        var self: ReaderUtf8 = undefined;
+        const err = lib.gci_reader_utf8_init(&self.inner, r.reader);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *ReaderUtf8) InterfaceReader {
+        return .{ .reader = lib.gci_reader_utf8_interface(&self.inner) };
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_encode.zig");
+}
+
+test "base64 matches std" {
+    var data: [300]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = @truncate(index *% 97 +% 13);
+    }
+
+    var expected: [400]u8 = undefined;
+    var encoded: [400]u8 = undefined;
+    var decoded: [300]u8 = undefined;
+    for ([_]usize{ 0, 1, 2, 3, 11, 12, 13, 28, 47, 100, data.len }) |size| {
+        const expected_slice = std.base64.standard.Encoder.encode(&expected, data[0..size]);
+        const slice = base64Encode(&encoded, data[0..size]);
+        try testing.expectEqualStrings(expected_slice, slice);
+        try testing.expectEqualSlices(u8, data[0..size], try base64Decode(&decoded, slice));
+    }
+}
+
+test "base64 invalid" {
+    var decoded: [8]u8 = undefined;
+    try testing.expectError(error.Invalid, base64Decode(&decoded, "Zm9"));
+    try testing.expectError(error.Invalid, base64Decode(&decoded, "Zm9*"));
+    try testing.expectError(error.Invalid, base64Decode(&decoded, "Zg==Zm9v"));
+}
+
+test "hex round trip" {
+    var encoded: [8]u8 = undefined;
+    var decoded: [4]u8 = undefined;
+    try testing.expectEqualStrings("00ff10ab", hexEncode(&encoded, "\x00\xff\x10\xab"));
+    try testing.expectEqualSlices(u8, "\x00\xff\x10\xab", try hexDecode(&decoded, "00FF10aB"));
+    try testing.expectError(error.Invalid, hexDecode(&decoded, "0x"));
+}
+
+test "utf8 every level" {
+    var data: [200]u8 = undefined;
+    var index: usize = 0;
+    while (index + 4 <= data.len) {
+        index += std.unicode.utf8Encode(@intCast(index * 1117 % 0xd000), data[index..]) catch unreachable;
+    }
+    const valid = data[0..index];
+
+    inline for (std.meta.fields(Simd)) |field| {
+        const simd: Simd = @enumFromInt(field.value);
+        try testing.expectEqual(Utf8Prefix{ .valid = valid.len, .incomplete = false }, utf8ValidateSimd(simd, valid));
+        try testing.expectEqual(std.unicode.utf8ValidateSlice(valid), utf8ValidateSimd(simd, valid).valid == valid.len);
+    }
+
+    try testing.expect(isUtf8("gr\xc3\xbc\xc3\x9f"));
+    try testing.expect(!isUtf8("\xc0\xaf"));
+    try testing.expectEqual(Utf8Prefix{ .valid = 1, .incomplete = true }, utf8Validate("a\xe2\x82"));
+}
+
+test "encode writer and decode reader" {
+    var encoded: [32]u8 = undefined;
+    var string = try writer.String.init(&encoded);
+    var encoder = try Writer.init(string.interface(), .base64);
+    try encoder.interface().write("fo");
+    try encoder.interface().write("oba");
+    try encoder.finish();
+    try testing.expectEqualStrings("Zm9vYmE=", encoded[0..8]);
+
+    var source = try reader.String.init(encoded[0..8]);
+    var buffer: [4]u8 = undefined;
+    var decoder = try Reader.init(source.interface(), .base64, &buffer);
+    const r = decoder.interface();
+
+    var decoded: [8]u8 = undefined;
+    try testing.expectEqualStrings("fooba", try r.read(&decoded));
+    try testing.expect(r.eof());
+}
+
+test "utf8 reader" {
+    var source = try reader.String.init("a\xe2\x82\xac\xff");
+    var context = try ReaderUtf8.init(source.interface());
+    const r = context.interface();
+
+    var buffer: [8]u8 = undefined;
+    try testing.expectEqualStrings("a\xe2\x82\xac", try r.read(&buffer));
+    try testing.expect(!r.eof());
+}
@@ -0,0 +1,241 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "base64 encode" {
+    var output: [8]u8 = undefined;
+    const length1 = lib.gci_base64_encode(&output, "foobar", 6);
+    try testing.expectEqualStrings("Zm9vYmFy", output[0..length1]);
+
+    const length2 = lib.gci_base64_encode(&output, "foob", 4);
+    try testing.expectEqualStrings("Zm9vYg==", output[0..length2]);
+}
+
+test "base64 decode" {
+    var output: [6]u8 = undefined;
+    var length: usize = undefined;
+    const result1 = lib.gci_base64_decode(&output, &length, "Zm9vYmE=", 8);
+    try testing.expect(result1);
+    try testing.expectEqualStrings("fooba", output[0..length]);
+
+    const result2 = lib.gci_base64_decode(&output, &length, "Zm9vYmE", 7);
+    try testing.expect(!result2);
+
+    const result3 = lib.gci_base64_decode(&output, &length, "Zm=vYmE=", 8);
+    try testing.expect(!result3);
+}
+
+test "base64 every level" {
+    var data: [500]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = @truncate(index *% 131 +% 7);
+    }
+
+    var expected: [668]u8 = undefined;
+    const expected_length = lib.gci_base64_encode_simd(lib.GCI_SIMD_SCALAR, &expected, &data, data.len);
+
+    var encoded: [668]u8 = undefined;
+    const length = lib.gci_base64_encode_simd(lib.GCI_SIMD_AVX2, &encoded, &data, data.len);
+    try testing.expectEqualStrings(expected[0..expected_length], encoded[0..length]);
+
+    var decoded: [500]u8 = undefined;
+    var decoded_length: usize = undefined;
+    const result = lib.gci_base64_decode_simd(lib.GCI_SIMD_AVX2, &decoded, &decoded_length, &encoded, length);
+    try testing.expect(result);
+    try testing.expectEqualSlices(u8, &data, decoded[0..decoded_length]);
+}
+
+test "hex" {
+    var output: [4]u8 = undefined;
+    const length = lib.gci_hex_encode(&output, "\x01\xab", 2);
+    try testing.expectEqualStrings("01ab", output[0..length]);
+
+    var decoded: [2]u8 = undefined;
+    try testing.expect(lib.gci_hex_decode(&decoded, "01AB", 4));
+    try testing.expectEqualSlices(u8, "\x01\xab", &decoded);
+    try testing.expect(!lib.gci_hex_decode(&decoded, "01A", 3));
+    try testing.expect(!lib.gci_hex_decode(&decoded, "0g", 2));
+}
+
+test "utf8 validate" {
+    var incomplete: bool = undefined;
+    const valid1 = lib.gci_utf8_validate("a\xc3\xbc\xe2\x82\xac\xf0\x9f\x98\x80", 10, &incomplete);
+    try testing.expectEqual(10, valid1);
+    try testing.expect(!incomplete);
+
+    const valid2 = lib.gci_utf8_validate("a\xed\xa0\x80", 4, &incomplete);
+    try testing.expectEqual(1, valid2);
+    try testing.expect(!incomplete);
+
+    const valid3 = lib.gci_utf8_validate("ab\xf0\x9f\x98", 5, &incomplete);
+    try testing.expectEqual(2, valid3);
+    try testing.expect(incomplete);
+}
+
+test "writer encode init" {
+    var buffer: [8]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    const init_err1 = lib.gci_writer_encode_init(null, lib.gci_writer_string_interface(&c), lib.GCI_ENCODING_HEX);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err1);
+
+    var context: lib.GciWriterEncode = undefined;
+    const init_err2 = lib.gci_writer_encode_init(&context, lib.gci_writer_string_interface(&c), 0);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err2);
+}
+
+test "writer encode hex" {
+    var buffer: [8]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciWriterEncode = undefined;
+    const init_err = lib.gci_writer_encode_init(&context, lib.gci_writer_string_interface(&c), lib.GCI_ENCODING_HEX);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const w = lib.gci_writer_encode_interface(&context);
+    try testing.expectEqual(2, lib.gci_writer_write(w, "ab", 2));
+    try testing.expectEqual(2, lib.gci_writer_write(w, "cd", 2));
+    try testing.expect(lib.gci_writer_encode_finish(&context));
+    try testing.expectEqualStrings("61626364", &buffer);
+}
+
+test "writer encode full" {
+    var buffer: [6]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciWriterEncode = undefined;
+    const init_err = lib.gci_writer_encode_init(&context, lib.gci_writer_string_interface(&c), lib.GCI_ENCODING_BASE64);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const w = lib.gci_writer_encode_interface(&context);
+    try testing.expectEqual(4, lib.gci_writer_write(w, "abcd", 4));
+    try testing.expect(!lib.gci_writer_encode_finish(&context));
+}
+
+test "reader decode init" {
+    var buffer: [4]u8 = undefined;
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "00", 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+    const r = lib.gci_reader_string_interface(&c);
+
+    const init_err1 = lib.gci_reader_decode_init(null, r, lib.GCI_ENCODING_HEX, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err1);
+
+    var context: lib.GciReaderDecode = undefined;
+    const init_err2 = lib.gci_reader_decode_init(&context, r, lib.GCI_ENCODING_HEX, null, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err2);
+
+    const init_err3 = lib.gci_reader_decode_init(&context, r, lib.GCI_ENCODING_HEX, &buffer, 3);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err3);
+}
+
+test "reader decode" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "Zm9vYmFy", 8);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [5]u8 = undefined;
+    var context: lib.GciReaderDecode = undefined;
+    const init_err = lib.gci_reader_decode_init(&context, lib.gci_reader_string_interface(&c), lib.GCI_ENCODING_BASE64, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const r = lib.gci_reader_decode_interface(&context);
+    var output: [6]u8 = undefined;
+    try testing.expectEqual(2, lib.gci_reader_read(r, &output, 2));
+    try testing.expectEqual(4, lib.gci_reader_read(r, output[2..], 4));
+    try testing.expectEqualStrings("foobar", &output);
+    try testing.expect(lib.gci_reader_eof(r));
+}
+
+test "reader decode invalid" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "Zm9vY", 5);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [8]u8 = undefined;
+    var context: lib.GciReaderDecode = undefined;
+    const init_err = lib.gci_reader_decode_init(&context, lib.gci_reader_string_interface(&c), lib.GCI_ENCODING_BASE64, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const r = lib.gci_reader_decode_interface(&context);
+    var output: [8]u8 = undefined;
+    try testing.expectEqual(3, lib.gci_reader_read(r, &output, output.len));
+    try testing.expectEqualStrings("foo", output[0..3]);
+    try testing.expectEqual(0, lib.gci_reader_read(r, &output, output.len));
+    try testing.expect(!lib.gci_reader_eof(r));
+}
+
+test "reader utf8 truncated" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "ab\xe2\x82", 4);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderUtf8 = undefined;
+    const init_err = lib.gci_reader_utf8_init(&context, lib.gci_reader_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const r = lib.gci_reader_utf8_interface(&context);
+    var output: [8]u8 = undefined;
+    try testing.expectEqual(2, lib.gci_reader_read(r, &output, output.len));
+    try testing.expectEqualStrings("ab", output[0..2]);
+    try testing.expectEqual(0, lib.gci_reader_read(r, &output, output.len));
+    try testing.expect(!lib.gci_reader_eof(r));
+}
+
+test "reader utf8 split" {
+    const data = "a\xe2\x82\xac";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderUtf8 = undefined;
+    const init_err = lib.gci_reader_utf8_init(&context, lib.gci_reader_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    // The cut off sequence is held back until it has been checked
+    const r = lib.gci_reader_utf8_interface(&context);
+    var output: [2]u8 = undefined;
+    try testing.expectEqual(1, lib.gci_reader_read(r, &output, output.len));
+    try testing.expectEqualStrings("a", output[0..1]);
+    try testing.expectEqual(2, lib.gci_reader_read(r, &output, output.len));
+    try testing.expectEqualStrings("\xe2\x82", &output);
+    try testing.expectEqual(1, lib.gci_reader_read(r, &output, output.len));
+    try testing.expectEqualStrings("\xac", output[0..1]);
+    try testing.expectEqual(0, lib.gci_reader_read(r, &output, output.len));
+    try testing.expect(lib.gci_reader_eof(r));
+}
+
+test "writer encode hex without reserve" {
+    var data: [3000]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = @truncate(index);
+    }
+
+    var buffer: [6000]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var inner = lib.gci_writer_string_interface(&c);
+    inner.reserve = null;
+    inner.commit = null;
+
+    var context: lib.GciWriterEncode = undefined;
+    const init_err = lib.gci_writer_encode_init(&context, inner, lib.GCI_ENCODING_HEX);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const w = lib.gci_writer_encode_interface(&context);
+    try testing.expectEqual(data.len, lib.gci_writer_write(w, &data, data.len));
+    try testing.expect(lib.gci_writer_encode_finish(&context));
+
+    var expected: [6000]u8 = undefined;
+    _ = lib.gci_hex_encode(&expected, &data, data.len);
+    try testing.expectEqualStrings(&expected, &buffer);
+}
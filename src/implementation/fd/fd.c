@@ -0,0 +1,329 @@
+#if defined(__unix__) || defined(__APPLE__)
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <gci_fd.h>
+
+size_t gci_reader_fd_read(void const *context, char *buffer, size_t buffer_size);
+size_t gci_reader_mmap_read(void const *context, char *buffer, size_t buffer_size);
+bool gci_reader_fd_eof(void const *context);
+bool gci_reader_mmap_eof(void const *context);
+size_t gci_reader_mmap_peek(void const *context, char const **data);
+void gci_reader_mmap_consume(void const *context, size_t amount);
+size_t gci_reader_fd_read_at(void const *context, char *buffer, size_t buffer_size, uint64_t offset);
+size_t gci_reader_mmap_read_at(void const *context, char *buffer, size_t buffer_size, uint64_t offset);
+size_t gci_reader_pread(int fd, char *buffer, size_t buffer_size, uint64_t offset);
+bool gci_reader_mmap_map(struct GciReaderMmap *context, uint64_t offset);
+bool gci_reader_mmap_next(struct GciReaderMmap *context);
+size_t gci_writer_fd_write(void const *void_context, char const *data, size_t data_size);
+size_t gci_writer_fd_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count);
+
+// Shared with the file writer
+size_t gci_writer_writev_fd(int fd, struct GciIovec const *vectors, size_t vector_count);
+
+enum GciError gci_reader_fd_init(struct GciReaderFd *context, int fd) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->fd = fd;
+    context->eof = false;
+    if (fd < 0) { return GCI_ERROR_NULL; }
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceReader gci_reader_fd_interface(struct GciReaderFd *context) {
+    return (struct GciInterfaceReader) {
+        .context = context,
+        .read = gci_reader_fd_read,
+        .eof = gci_reader_fd_eof,
+        .read_at = gci_reader_fd_read_at,
+    };
+}
+
+size_t gci_reader_fd_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    struct GciReaderFd *context = (struct GciReaderFd*) void_context;
+
+    assert(buffer != NULL);
+    size_t read_length = 0;
+    while (read_length < buffer_size) {
+        size_t length_left = buffer_size - read_length;
+        length_left = length_left > SSIZE_MAX ? SSIZE_MAX : length_left;
+
+        ssize_t length = read(context->fd, buffer + read_length, length_left);
+        if (length < 0 && errno == EINTR) {
+            continue;
+        } else if (length < 0) {
+            break;
+        } else if (length == 0) {
+            context->eof = true;
+            break;
+        }
+
+        read_length += (size_t) length;
+    }
+
+    assert(read_length <= buffer_size);
+    return read_length;
+}
+
+bool gci_reader_fd_eof(void const *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderFd *context = (struct GciReaderFd*) void_context;
+    return context->eof;
+}
+
+size_t gci_reader_fd_read_at(void const *void_context, char *buffer, size_t buffer_size, uint64_t offset) {
+    assert(void_context != NULL);
+    struct GciReaderFd *context = (struct GciReaderFd*) void_context;
+    return gci_reader_pread(context->fd, buffer, buffer_size, offset);
+}
+
+size_t gci_reader_pread(int fd, char *buffer, size_t buffer_size, uint64_t offset) {
+    assert(buffer != NULL);
+    size_t read_length = 0;
+    while (read_length < buffer_size) {
+        if (offset > INT64_MAX - read_length) { break; }
+
+        size_t length_left = buffer_size - read_length;
+        length_left = length_left > SSIZE_MAX ? SSIZE_MAX : length_left;
+
+        ssize_t length = pread(fd, buffer + read_length, length_left, (off_t) (offset + read_length));
+        if (length < 0 && errno == EINTR) {
+            continue;
+        } else if (length <= 0) {
+            break;
+        }
+
+        read_length += (size_t) length;
+    }
+
+    assert(read_length <= buffer_size);
+    return read_length;
+}
+
+enum GciError gci_reader_mmap_init(
+    struct GciReaderMmap *context,
+    int fd,
+    size_t window_size,
+    enum GciReaderMmapAccess access
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->window = NULL;
+    context->window_length = 0;
+    if (fd < 0) { return GCI_ERROR_NULL; }
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) { return GCI_ERROR_IO; }
+    if (window_size % (size_t) page_size != 0) { return GCI_ERROR_BUFFER; }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) { return GCI_ERROR_IO; }
+    if (file_stat.st_size < 0) { return GCI_ERROR_IO; }
+
+    uint64_t file_size = (uint64_t) file_stat.st_size;
+    if (window_size == 0) {
+        if (file_size > SIZE_MAX) { return GCI_ERROR_BUFFER; }
+        window_size = (size_t) file_size;
+    }
+
+    context->fd = fd;
+    context->access = access;
+    context->window_size = window_size;
+    context->window_offset = 0;
+    context->file_size = file_size;
+    context->current = 0;
+    context->eof = false;
+
+    if (!gci_reader_mmap_map(context, 0)) { return GCI_ERROR_IO; }
+
+    return GCI_ERROR_OK;
+}
+
+void gci_reader_mmap_deinit(struct GciReaderMmap *context) {
+    assert(context != NULL);
+    if (context->window != NULL) {
+        munmap(context->window, context->window_length);
+    }
+
+    context->window = NULL;
+    context->window_length = 0;
+    context->current = 0;
+}
+
+struct GciInterfaceReader gci_reader_mmap_interface(struct GciReaderMmap *context) {
+    return (struct GciInterfaceReader) {
+        .context = context,
+        .read = gci_reader_mmap_read,
+        .eof = gci_reader_mmap_eof,
+        .peek = gci_reader_mmap_peek,
+        .consume = gci_reader_mmap_consume,
+        .read_at = gci_reader_mmap_read_at,
+    };
+}
+
+size_t gci_reader_mmap_read_at(void const *void_context, char *buffer, size_t buffer_size, uint64_t offset) {
+    assert(void_context != NULL);
+    struct GciReaderMmap *context = (struct GciReaderMmap*) void_context;
+    return gci_reader_pread(context->fd, buffer, buffer_size, offset);
+}
+
+bool gci_reader_mmap_map(struct GciReaderMmap *context, uint64_t offset) {
+    assert(context != NULL);
+    if (context->window != NULL) {
+        munmap(context->window, context->window_length);
+    }
+
+    context->window = NULL;
+    context->window_length = 0;
+    context->window_offset = offset;
+    context->current = 0;
+
+    if (offset >= context->file_size) {
+        return true;
+    }
+
+    uint64_t length_left = context->file_size - offset;
+    size_t length = length_left > context->window_size ? context->window_size : (size_t) length_left;
+    assert(length > 0);
+
+    void *window = mmap(NULL, length, PROT_READ, MAP_PRIVATE, context->fd, (off_t) offset);
+    if (window == MAP_FAILED) {
+        return false;
+    }
+
+    int advice = POSIX_MADV_SEQUENTIAL;
+    if (context->access == GCI_READER_MMAP_RANDOM) {
+        advice = POSIX_MADV_RANDOM;
+    }
+    (void) posix_madvise(window, length, advice);
+
+    context->window = window;
+    context->window_length = length;
+    return true;
+}
+
+// Slides the window past the consumed one, returns false on eof or if the
+// next window could not be mapped.
+bool gci_reader_mmap_next(struct GciReaderMmap *context) {
+    assert(context != NULL);
+    assert(context->current >= context->window_length);
+
+    uint64_t next_offset = context->window_offset + context->window_length;
+    if (next_offset >= context->file_size) {
+        context->eof = true;
+        return false;
+    }
+
+    return gci_reader_mmap_map(context, next_offset);
+}
+
+size_t gci_reader_mmap_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    struct GciReaderMmap *context = (struct GciReaderMmap*) void_context;
+
+    assert(buffer != NULL);
+    size_t read_length = 0;
+    while (read_length < buffer_size) {
+        if (context->current >= context->window_length) {
+            if (!gci_reader_mmap_next(context)) { break; }
+        }
+
+        size_t length = context->window_length - context->current;
+        length = length > buffer_size - read_length ? buffer_size - read_length : length;
+
+        memcpy(buffer + read_length, context->window + context->current, length);
+        context->current += length;
+        read_length += length;
+    }
+
+    assert(read_length <= buffer_size);
+    return read_length;
+}
+
+bool gci_reader_mmap_eof(void const *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderMmap *context = (struct GciReaderMmap*) void_context;
+    return context->eof;
+}
+
+size_t gci_reader_mmap_peek(void const *void_context, char const **data) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciReaderMmap *context = (struct GciReaderMmap*) void_context;
+
+    if (context->current >= context->window_length) {
+        if (!gci_reader_mmap_next(context)) { return 0; }
+    }
+
+    *data = context->window + context->current;
+    return context->window_length - context->current;
+}
+
+void gci_reader_mmap_consume(void const *void_context, size_t amount) {
+    assert(void_context != NULL);
+    struct GciReaderMmap *context = (struct GciReaderMmap*) void_context;
+
+    assert(context->current <= context->window_length);
+    assert(amount <= context->window_length - context->current);
+    context->current += amount;
+}
+
+enum GciError gci_writer_fd_init(struct GciWriterFd *context, int fd) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->fd = fd;
+    if (fd < 0) { return GCI_ERROR_NULL; }
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceWriter gci_writer_fd_interface(struct GciWriterFd *context) {
+    assert(context != NULL);
+    return (struct GciInterfaceWriter) {
+        .context = context,
+        .write = gci_writer_fd_write,
+        .writev = gci_writer_fd_writev,
+    };
+}
+
+size_t gci_writer_fd_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciWriterFd *context = (struct GciWriterFd*) void_context;
+
+    size_t write_length = 0;
+    while (write_length < data_size) {
+        size_t length_left = data_size - write_length;
+        length_left = length_left > SSIZE_MAX ? SSIZE_MAX : length_left;
+
+        ssize_t length = write(context->fd, data + write_length, length_left);
+        if (length < 0 && errno == EINTR) {
+            continue;
+        } else if (length <= 0) {
+            break;
+        }
+
+        write_length += (size_t) length;
+    }
+
+    assert(write_length <= data_size);
+    return write_length;
+}
+
+size_t gci_writer_fd_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count) {
+    assert(void_context != NULL);
+    struct GciWriterFd *context = (struct GciWriterFd*) void_context;
+    return gci_writer_writev_fd(context->fd, vectors, vector_count);
+}
+
+#endif
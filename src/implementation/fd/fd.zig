@@ -0,0 +1,214 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const InterfaceReader = @import("../reader/reader.zig").InterfaceReader;
+const InterfaceWriter = @import("../writer/writer.zig").InterfaceWriter;
+const Iovec = @import("../writer/writer.zig").Iovec;
+
+pub const Reader = struct {
+    inner: lib.GciReaderFd,
+
+    pub fn init(fd: c_int) !Reader {
+        var self: Reader = undefined;
+        const err = lib.gci_reader_fd_init(&self.inner, fd);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Reader) InterfaceReader {
+        return .{ .reader = lib.gci_reader_fd_interface(&self.inner) };
+    }
+};
+
+pub const Mmap = struct {
+    inner: lib.GciReaderMmap,
+
+    pub const Access = enum { sequential, random };
+
+    pub fn init(fd: c_int, window_size: usize, access: Access) !Mmap {
+        const c_access: c_uint = switch (access) {
+            .sequential => lib.GCI_READER_MMAP_SEQUENTIAL,
+            .random => lib.GCI_READER_MMAP_RANDOM,
+        };
+
+        var self: Mmap = undefined;
+        const err = lib.gci_reader_mmap_init(&self.inner, fd, window_size, c_access);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn deinit(self: *Mmap) void {
+        lib.gci_reader_mmap_deinit(&self.inner);
+    }
+
+    pub fn interface(self: *Mmap) InterfaceReader {
+        return .{ .reader = lib.gci_reader_mmap_interface(&self.inner) };
+    }
+};
+
+pub const Writer = struct {
+    inner: lib.GciWriterFd,
+
+    pub fn init(fd: c_int) !Writer {
+        var self: Writer = undefined;
+        const err = lib.gci_writer_fd_init(&self.inner, fd);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Writer) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_fd_interface(&self.inner) };
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_fd.zig");
+}
+
+test "reader init" {
+    const err = Reader.init(-1);
+    try testing.expectError(error.Null, err);
+}
+
+test "reader read" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+
+    _ = try std.posix.write(fds[1], "12");
+    std.posix.close(fds[1]);
+
+    var context = try Reader.init(fds[0]);
+    const reader = context.interface();
+    try testing.expect(!reader.eof());
+
+    var buffer: [3]u8 = undefined;
+    const result = try reader.read(&buffer);
+    try testing.expectEqualStrings("12", result);
+    try testing.expect(reader.eof());
+
+    const err = reader.read(&buffer);
+    try testing.expectError(error.Reader, err);
+    try testing.expect(reader.eof());
+}
+
+test "reader read at" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+    try file.writeAll("0123456789");
+
+    var context = try Reader.init(file.handle);
+    const reader = context.interface();
+
+    var buffer: [4]u8 = undefined;
+    const result1 = try reader.readAt(&buffer, 3);
+    try testing.expectEqualStrings("3456", result1);
+
+    const result2 = try reader.readAt(&buffer, 8);
+    try testing.expectEqualStrings("89", result2);
+
+    const err = reader.readAt(&buffer, 10);
+    try testing.expectError(error.Reader, err);
+}
+
+test "mmap init window" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+
+    const err = Mmap.init(file.handle, 3, .sequential);
+    try testing.expectError(error.Buffer, err);
+}
+
+test "mmap read windows" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const data = try testing.allocator.alloc(u8, 2 * std.mem.page_size + 3);
+    defer testing.allocator.free(data);
+    for (data, 0..) |*byte, i| {
+        byte.* = @truncate(i);
+    }
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+    try file.writeAll(data);
+
+    var context = try Mmap.init(file.handle, std.mem.page_size, .sequential);
+    defer context.deinit();
+    const reader = context.interface();
+
+    const result = try testing.allocator.alloc(u8, data.len + 1);
+    defer testing.allocator.free(result);
+
+    const r = try reader.read(result);
+    try testing.expectEqualSlices(u8, data, r);
+    try testing.expect(reader.eof());
+}
+
+test "mmap peek" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+    try file.writeAll("data");
+
+    var context = try Mmap.init(file.handle, 0, .random);
+    defer context.deinit();
+    const reader = context.interface();
+
+    var scratch: [0]u8 = undefined;
+    const result = try reader.peek(&scratch);
+    try testing.expectEqualStrings("data", result);
+    reader.consume(result, result.len);
+
+    const err = reader.peek(&scratch);
+    try testing.expectError(error.Reader, err);
+    try testing.expect(reader.eof());
+}
+
+test "writer init" {
+    const err = Writer.init(-1);
+    try testing.expectError(error.Null, err);
+}
+
+test "writer write" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+
+    var context = try Writer.init(fds[1]);
+    const writer = context.interface();
+
+    try writer.write("12");
+    std.posix.close(fds[1]);
+
+    var buffer: [3]u8 = undefined;
+    const length = try std.posix.read(fds[0], &buffer);
+    try testing.expectEqualStrings("12", buffer[0..length]);
+}
+
+test "writer writev" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+
+    var context = try Writer.init(fds[1]);
+    const writer = context.interface();
+
+    const vectors = [_]Iovec{
+        .{ .data = "1", .data_size = 1 },
+        .{ .data = "23", .data_size = 2 },
+    };
+    try writer.writev(&vectors);
+    std.posix.close(fds[1]);
+
+    var buffer: [4]u8 = undefined;
+    const length = try std.posix.read(fds[0], &buffer);
+    try testing.expectEqualStrings("123", buffer[0..length]);
+}
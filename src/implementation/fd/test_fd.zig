@@ -0,0 +1,248 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "reader init" {
+    var context: lib.GciReaderFd = undefined;
+    const init_err = lib.gci_reader_fd_init(&context, 0);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    _ = lib.gci_reader_fd_interface(&context);
+}
+
+test "reader init invalid" {
+    var context: lib.GciReaderFd = undefined;
+    const init_err = lib.gci_reader_fd_init(&context, -1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "reader read" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+
+    _ = try std.posix.write(fds[1], "12");
+    std.posix.close(fds[1]);
+
+    var context: lib.GciReaderFd = undefined;
+    const init_err = lib.gci_reader_fd_init(&context, fds[0]);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_fd_interface(&context);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    var buffer: [1]u8 = undefined;
+    const length1 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(1, length1);
+    try testing.expectEqualStrings("1", &buffer);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    const length2 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(1, length2);
+    try testing.expectEqualStrings("2", &buffer);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    const length3 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(0, length3);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "mmap init" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+
+    var context: lib.GciReaderMmap = undefined;
+    const init_err = lib.gci_reader_mmap_init(&context, file.handle, 0, lib.GCI_READER_MMAP_SEQUENTIAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_reader_mmap_deinit(&context);
+    _ = lib.gci_reader_mmap_interface(&context);
+}
+
+test "mmap init null" {
+    const init_err = lib.gci_reader_mmap_init(null, 0, 0, lib.GCI_READER_MMAP_SEQUENTIAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "mmap init window" {
+    var context: lib.GciReaderMmap = undefined;
+    const init_err = lib.gci_reader_mmap_init(&context, 0, std.mem.page_size + 1, lib.GCI_READER_MMAP_SEQUENTIAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err);
+}
+
+test "mmap read empty" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+
+    var context: lib.GciReaderMmap = undefined;
+    const init_err = lib.gci_reader_mmap_init(&context, file.handle, 0, lib.GCI_READER_MMAP_SEQUENTIAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_reader_mmap_deinit(&context);
+
+    const reader = lib.gci_reader_mmap_interface(&context);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    var buffer: [1]u8 = undefined;
+    const length = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(0, length);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "mmap read windows" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const data = try testing.allocator.alloc(u8, 2 * std.mem.page_size + 3);
+    defer testing.allocator.free(data);
+    for (data, 0..) |*byte, i| {
+        byte.* = @truncate(i * 7);
+    }
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+    try file.writeAll(data);
+
+    var context: lib.GciReaderMmap = undefined;
+    const init_err = lib.gci_reader_mmap_init(&context, file.handle, std.mem.page_size, lib.GCI_READER_MMAP_SEQUENTIAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_reader_mmap_deinit(&context);
+
+    const reader = lib.gci_reader_mmap_interface(&context);
+
+    const result = try testing.allocator.alloc(u8, data.len + 1);
+    defer testing.allocator.free(result);
+
+    const length1 = lib.gci_reader_read(reader, result.ptr, 5);
+    try testing.expectEqual(5, length1);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    const length2 = lib.gci_reader_read(reader, result.ptr + 5, result.len - 5);
+    try testing.expectEqual(data.len - 5, length2);
+    try testing.expectEqualSlices(u8, data, result[0..data.len]);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "mmap peek windows" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const data = try testing.allocator.alloc(u8, std.mem.page_size + 1);
+    defer testing.allocator.free(data);
+    @memset(data, 'a');
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+    try file.writeAll(data);
+
+    var context: lib.GciReaderMmap = undefined;
+    const init_err = lib.gci_reader_mmap_init(&context, file.handle, std.mem.page_size, lib.GCI_READER_MMAP_RANDOM);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_reader_mmap_deinit(&context);
+
+    const reader = lib.gci_reader_mmap_interface(&context);
+
+    var view: [*c]const u8 = undefined;
+    const length1 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(std.mem.page_size, length1);
+    lib.gci_reader_consume(reader, length1, length1);
+
+    const length2 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(1, length2);
+    try testing.expectEqualStrings("a", view[0..1]);
+    lib.gci_reader_consume(reader, length2, length2);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    const length3 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(0, length3);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "reader read until spill filled at eof" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+
+    _ = try std.posix.write(fds[1], "abc");
+    std.posix.close(fds[1]);
+
+    var context: lib.GciReaderFd = undefined;
+    const init_err = lib.gci_reader_fd_init(&context, fds[0]);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_fd_interface(&context);
+
+    var spill: [3]u8 = undefined;
+    var record: [*c]const u8 = undefined;
+    var length: usize = undefined;
+
+    const err1 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), err1);
+    try testing.expectEqualStrings("abc", record[0..length]);
+
+    const err2 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), err2);
+    try testing.expectEqual(0, length);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "writer init" {
+    var context: lib.GciWriterFd = undefined;
+    const init_err = lib.gci_writer_fd_init(&context, 1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    _ = lib.gci_writer_fd_interface(&context);
+}
+
+test "writer init invalid" {
+    var context: lib.GciWriterFd = undefined;
+    const init_err = lib.gci_writer_fd_init(&context, -1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "writer write" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+
+    var context: lib.GciWriterFd = undefined;
+    const init_err = lib.gci_writer_fd_init(&context, fds[1]);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_fd_interface(&context);
+
+    const res1 = lib.gci_writer_write(writer, "1", 1);
+    try testing.expectEqual(1, res1);
+
+    const res2 = lib.gci_writer_write(writer, "23", 2);
+    try testing.expectEqual(2, res2);
+    std.posix.close(fds[1]);
+
+    var buffer: [4]u8 = undefined;
+    const length = try std.posix.read(fds[0], &buffer);
+    try testing.expectEqual(3, length);
+    try testing.expectEqualStrings("123", buffer[0..3]);
+}
+
+test "writer writev" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+
+    var context: lib.GciWriterFd = undefined;
+    const init_err = lib.gci_writer_fd_init(&context, fds[1]);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_fd_interface(&context);
+
+    const vectors = [_]lib.GciIovec{
+        .{ .data = "1", .data_size = 1 },
+        .{ .data = "", .data_size = 0 },
+        .{ .data = "23", .data_size = 2 },
+    };
+    const res = lib.gci_writer_writev(writer, &vectors, vectors.len);
+    try testing.expectEqual(3, res);
+    std.posix.close(fds[1]);
+
+    var buffer: [4]u8 = undefined;
+    const length = try std.posix.read(fds[0], &buffer);
+    try testing.expectEqual(3, length);
+    try testing.expectEqualStrings("123", buffer[0..3]);
+}
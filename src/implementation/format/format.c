@@ -0,0 +1,726 @@
+#include <assert.h>
+#include <string.h>
+#include <gci_format.h>
+
+// Enough for the largest intermediate value of `gci_format_shortest`, about
+// 1140 bits for the smallest subnormal.
+#define GCI_FORMAT_BIG_WORDS 40
+#define GCI_FORMAT_DIGITS_MAX 17
+
+static char const gci_format_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static char const gci_format_hex_digits[] = "0123456789abcdef";
+
+// An unsigned integer of `size` little endian 32 bit words.
+struct GciFormatBig {
+    uint32_t words[GCI_FORMAT_BIG_WORDS];
+    size_t size;
+};
+
+// The shortest decimal digits of a finite double, its value is
+// 0.`digits` * 10^`exponent`.
+struct GciFormatDecimal {
+    char digits[GCI_FORMAT_DIGITS_MAX];
+    size_t size;
+    int exponent;
+    bool negative;
+    char const *special;
+};
+
+// A floating point number `f` * 2^`e` with a 64 bit significand.
+struct GciFormatFloat {
+    uint64_t f;
+    int e;
+};
+
+struct GciFormatPower {
+    uint64_t f;
+    int16_t e;
+    int16_t exponent;
+};
+
+// Normalized approximations of 10^`exponent` for every eighth exponent.
+static struct GciFormatPower const gci_format_powers[] = {
+    { 0xfa8fd5a0081c0288ull, -1220, -348 },
+    { 0xbaaee17fa23ebf76ull, -1193, -340 },
+    { 0x8b16fb203055ac76ull, -1166, -332 },
+    { 0xcf42894a5dce35eaull, -1140, -324 },
+    { 0x9a6bb0aa55653b2dull, -1113, -316 },
+    { 0xe61acf033d1a45dfull, -1087, -308 },
+    { 0xab70fe17c79ac6caull, -1060, -300 },
+    { 0xff77b1fcbebcdc4full, -1034, -292 },
+    { 0xbe5691ef416bd60cull, -1007, -284 },
+    { 0x8dd01fad907ffc3cull, -980, -276 },
+    { 0xd3515c2831559a83ull, -954, -268 },
+    { 0x9d71ac8fada6c9b5ull, -927, -260 },
+    { 0xea9c227723ee8bcbull, -901, -252 },
+    { 0xaecc49914078536dull, -874, -244 },
+    { 0x823c12795db6ce57ull, -847, -236 },
+    { 0xc21094364dfb5637ull, -821, -228 },
+    { 0x9096ea6f3848984full, -794, -220 },
+    { 0xd77485cb25823ac7ull, -768, -212 },
+    { 0xa086cfcd97bf97f4ull, -741, -204 },
+    { 0xef340a98172aace5ull, -715, -196 },
+    { 0xb23867fb2a35b28eull, -688, -188 },
+    { 0x84c8d4dfd2c63f3bull, -661, -180 },
+    { 0xc5dd44271ad3cdbaull, -635, -172 },
+    { 0x936b9fcebb25c996ull, -608, -164 },
+    { 0xdbac6c247d62a584ull, -582, -156 },
+    { 0xa3ab66580d5fdaf6ull, -555, -148 },
+    { 0xf3e2f893dec3f126ull, -529, -140 },
+    { 0xb5b5ada8aaff80b8ull, -502, -132 },
+    { 0x87625f056c7c4a8bull, -475, -124 },
+    { 0xc9bcff6034c13053ull, -449, -116 },
+    { 0x964e858c91ba2655ull, -422, -108 },
+    { 0xdff9772470297ebdull, -396, -100 },
+    { 0xa6dfbd9fb8e5b88full, -369, -92 },
+    { 0xf8a95fcf88747d94ull, -343, -84 },
+    { 0xb94470938fa89bcfull, -316, -76 },
+    { 0x8a08f0f8bf0f156bull, -289, -68 },
+    { 0xcdb02555653131b6ull, -263, -60 },
+    { 0x993fe2c6d07b7facull, -236, -52 },
+    { 0xe45c10c42a2b3b06ull, -210, -44 },
+    { 0xaa242499697392d3ull, -183, -36 },
+    { 0xfd87b5f28300ca0eull, -157, -28 },
+    { 0xbce5086492111aebull, -130, -20 },
+    { 0x8cbccc096f5088ccull, -103, -12 },
+    { 0xd1b71758e219652cull, -77, -4 },
+    { 0x9c40000000000000ull, -50, 4 },
+    { 0xe8d4a51000000000ull, -24, 12 },
+    { 0xad78ebc5ac620000ull, 3, 20 },
+    { 0x813f3978f8940984ull, 30, 28 },
+    { 0xc097ce7bc90715b3ull, 56, 36 },
+    { 0x8f7e32ce7bea5c70ull, 83, 44 },
+    { 0xd5d238a4abe98068ull, 109, 52 },
+    { 0x9f4f2726179a2245ull, 136, 60 },
+    { 0xed63a231d4c4fb27ull, 162, 68 },
+    { 0xb0de65388cc8ada8ull, 189, 76 },
+    { 0x83c7088e1aab65dbull, 216, 84 },
+    { 0xc45d1df942711d9aull, 242, 92 },
+    { 0x924d692ca61be758ull, 269, 100 },
+    { 0xda01ee641a708deaull, 295, 108 },
+    { 0xa26da3999aef774aull, 322, 116 },
+    { 0xf209787bb47d6b85ull, 348, 124 },
+    { 0xb454e4a179dd1877ull, 375, 132 },
+    { 0x865b86925b9bc5c2ull, 402, 140 },
+    { 0xc83553c5c8965d3dull, 428, 148 },
+    { 0x952ab45cfa97a0b3ull, 455, 156 },
+    { 0xde469fbd99a05fe3ull, 481, 164 },
+    { 0xa59bc234db398c25ull, 508, 172 },
+    { 0xf6c69a72a3989f5cull, 534, 180 },
+    { 0xb7dcbf5354e9beceull, 561, 188 },
+    { 0x88fcf317f22241e2ull, 588, 196 },
+    { 0xcc20ce9bd35c78a5ull, 614, 204 },
+    { 0x98165af37b2153dfull, 641, 212 },
+    { 0xe2a0b5dc971f303aull, 667, 220 },
+    { 0xa8d9d1535ce3b396ull, 694, 228 },
+    { 0xfb9b7cd9a4a7443cull, 720, 236 },
+    { 0xbb764c4ca7a44410ull, 747, 244 },
+    { 0x8bab8eefb6409c1aull, 774, 252 },
+    { 0xd01fef10a657842cull, 800, 260 },
+    { 0x9b10a4e5e9913129ull, 827, 268 },
+    { 0xe7109bfba19c0c9dull, 853, 276 },
+    { 0xac2820d9623bf429ull, 880, 284 },
+    { 0x80444b5e7aa7cf85ull, 907, 292 },
+    { 0xbf21e44003acdd2dull, 933, 300 },
+    { 0x8e679c2f5e44ff8full, 960, 308 },
+    { 0xd433179d9c8cb841ull, 986, 316 },
+    { 0x9e19db92b4e31ba9ull, 1013, 324 },
+    { 0xeb96bf6ebadf77d9ull, 1039, 332 },
+    { 0xaf87023b9bf0ee6bull, 1066, 340 },
+};
+
+size_t gci_format_length(uint64_t value);
+void gci_format_digits(char *output, uint64_t value, size_t length);
+size_t gci_format_hex_length(uint64_t value);
+void gci_format_big_set(struct GciFormatBig *big, uint64_t value);
+void gci_format_big_shift(struct GciFormatBig *big, unsigned bits);
+void gci_format_big_multiply(struct GciFormatBig *big, uint32_t factor);
+void gci_format_big_pow10(struct GciFormatBig *big, unsigned exponent);
+void gci_format_big_add(struct GciFormatBig *result, struct GciFormatBig const *a, struct GciFormatBig const *b);
+void gci_format_big_subtract(struct GciFormatBig *big, struct GciFormatBig const *other);
+int gci_format_big_compare(struct GciFormatBig const *a, struct GciFormatBig const *b);
+struct GciFormatFloat gci_format_normalize(struct GciFormatFloat value);
+struct GciFormatFloat gci_format_multiply(struct GciFormatFloat a, struct GciFormatFloat b);
+bool gci_format_grisu(struct GciFormatDecimal *decimal, uint64_t f, int e, bool uneven);
+bool gci_format_round_weed(
+    struct GciFormatDecimal *decimal,
+    uint64_t distance_high_w,
+    uint64_t unsafe_interval,
+    uint64_t rest,
+    uint64_t ten_kappa,
+    uint64_t unit
+);
+void gci_format_shortest(struct GciFormatDecimal *decimal, double value);
+size_t gci_format_decimal_length(struct GciFormatDecimal const *decimal);
+void gci_format_decimal_write(char *output, struct GciFormatDecimal const *decimal, size_t length);
+
+size_t gci_format_u64(char *output, uint64_t value) {
+    assert(output != NULL);
+    size_t length = gci_format_length(value);
+    gci_format_digits(output, value, length);
+    return length;
+}
+
+size_t gci_format_i64(char *output, int64_t value) {
+    assert(output != NULL);
+    if (value >= 0) {
+        return gci_format_u64(output, (uint64_t) value);
+    }
+
+    output[0] = '-';
+    return 1 + gci_format_u64(output + 1, 0 - (uint64_t) value);
+}
+
+size_t gci_format_hex(char *output, uint64_t value) {
+    assert(output != NULL);
+    size_t length = gci_format_hex_length(value);
+    for (size_t index = length; index > 0; index--) {
+        output[index - 1] = gci_format_hex_digits[value & 0xf];
+        value >>= 4;
+    }
+    return length;
+}
+
+size_t gci_format_f64(char *output, double value) {
+    assert(output != NULL);
+    struct GciFormatDecimal decimal;
+    gci_format_shortest(&decimal, value);
+
+    size_t length = gci_format_decimal_length(&decimal);
+    gci_format_decimal_write(output, &decimal, length);
+    return length;
+}
+
+bool gci_write_u64(struct GciInterfaceWriter writer, uint64_t value) {
+    char scratch[GCI_FORMAT_MAX];
+    size_t length = gci_format_length(value);
+
+    char *reserved = gci_writer_reserve(writer, length, scratch, sizeof(scratch));
+    if (reserved == NULL) { return false; }
+
+    gci_format_digits(reserved, value, length);
+    return gci_writer_commit(writer, reserved, length, scratch) == length;
+}
+
+bool gci_write_i64(struct GciInterfaceWriter writer, int64_t value) {
+    char scratch[GCI_FORMAT_MAX];
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t) value : (uint64_t) value;
+    size_t sign = value < 0 ? 1 : 0;
+    size_t length = sign + gci_format_length(magnitude);
+
+    char *reserved = gci_writer_reserve(writer, length, scratch, sizeof(scratch));
+    if (reserved == NULL) { return false; }
+
+    reserved[0] = '-';
+    gci_format_digits(reserved + sign, magnitude, length - sign);
+    return gci_writer_commit(writer, reserved, length, scratch) == length;
+}
+
+bool gci_write_hex(struct GciInterfaceWriter writer, uint64_t value) {
+    char scratch[GCI_FORMAT_MAX];
+    size_t length = gci_format_hex_length(value);
+
+    char *reserved = gci_writer_reserve(writer, length, scratch, sizeof(scratch));
+    if (reserved == NULL) { return false; }
+
+    gci_format_hex(reserved, value);
+    return gci_writer_commit(writer, reserved, length, scratch) == length;
+}
+
+bool gci_write_f64(struct GciInterfaceWriter writer, double value) {
+    char scratch[GCI_FORMAT_MAX];
+    struct GciFormatDecimal decimal;
+    gci_format_shortest(&decimal, value);
+    size_t length = gci_format_decimal_length(&decimal);
+
+    char *reserved = gci_writer_reserve(writer, length, scratch, sizeof(scratch));
+    if (reserved == NULL) { return false; }
+
+    gci_format_decimal_write(reserved, &decimal, length);
+    return gci_writer_commit(writer, reserved, length, scratch) == length;
+}
+
+size_t gci_format_length(uint64_t value) {
+    size_t length = 1;
+    while (value >= 10000) {
+        value /= 10000;
+        length += 4;
+    }
+    if (value >= 10) { length += 1; }
+    if (value >= 100) { length += 1; }
+    if (value >= 1000) { length += 1; }
+    return length;
+}
+
+// Writes exactly `length` digits of `value`, two at a time from the end.
+void gci_format_digits(char *output, uint64_t value, size_t length) {
+    assert(output != NULL);
+    assert(length == gci_format_length(value));
+
+    char *end = output + length;
+    while (value >= 100) {
+        size_t pair = (size_t) (value % 100) * 2;
+        value /= 100;
+        end -= 2;
+        memcpy(end, gci_format_pairs + pair, 2);
+    }
+
+    if (value >= 10) {
+        memcpy(output, gci_format_pairs + value * 2, 2);
+    } else {
+        output[0] = (char) ('0' + value);
+    }
+}
+
+size_t gci_format_hex_length(uint64_t value) {
+    size_t length = 1;
+    while (length < 16 && (value >> (4 * length)) != 0) {
+        length += 1;
+    }
+    return length;
+}
+
+void gci_format_big_set(struct GciFormatBig *big, uint64_t value) {
+    assert(big != NULL);
+    big->words[0] = (uint32_t) value;
+    big->words[1] = (uint32_t) (value >> 32);
+    big->size = big->words[1] != 0 ? 2 : (big->words[0] != 0 ? 1 : 0);
+}
+
+void gci_format_big_shift(struct GciFormatBig *big, unsigned bits) {
+    assert(big != NULL);
+    if (big->size == 0) { return; }
+
+    size_t words = bits / 32;
+    unsigned rest = bits % 32;
+    assert(big->size + words + 1 <= GCI_FORMAT_BIG_WORDS);
+
+    big->words[big->size] = 0;
+    for (size_t index = big->size + 1; index > 0; index--) {
+        uint32_t high = big->words[index - 1] << rest;
+        uint32_t low = 0;
+        if (rest != 0 && index >= 2) {
+            low = big->words[index - 2] >> (32 - rest);
+        }
+        big->words[index - 1 + words] = high | low;
+    }
+    for (size_t index = 0; index < words; index++) {
+        big->words[index] = 0;
+    }
+
+    big->size += words + 1;
+    while (big->size > 0 && big->words[big->size - 1] == 0) {
+        big->size -= 1;
+    }
+}
+
+void gci_format_big_multiply(struct GciFormatBig *big, uint32_t factor) {
+    assert(big != NULL);
+    uint64_t carry = 0;
+    for (size_t index = 0; index < big->size; index++) {
+        uint64_t product = (uint64_t) big->words[index] * factor + carry;
+        big->words[index] = (uint32_t) product;
+        carry = product >> 32;
+    }
+    if (carry != 0) {
+        assert(big->size < GCI_FORMAT_BIG_WORDS);
+        big->words[big->size] = (uint32_t) carry;
+        big->size += 1;
+    }
+}
+
+void gci_format_big_pow10(struct GciFormatBig *big, unsigned exponent) {
+    static uint32_t const powers[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+    };
+
+    for (; exponent >= 9; exponent -= 9) {
+        gci_format_big_multiply(big, powers[9]);
+    }
+    if (exponent > 0) {
+        gci_format_big_multiply(big, powers[exponent]);
+    }
+}
+
+void gci_format_big_add(struct GciFormatBig *result, struct GciFormatBig const *a, struct GciFormatBig const *b) {
+    assert(result != NULL && a != NULL && b != NULL);
+    size_t size = a->size > b->size ? a->size : b->size;
+
+    uint64_t carry = 0;
+    for (size_t index = 0; index < size; index++) {
+        uint64_t sum = carry;
+        sum += index < a->size ? a->words[index] : 0;
+        sum += index < b->size ? b->words[index] : 0;
+        result->words[index] = (uint32_t) sum;
+        carry = sum >> 32;
+    }
+    if (carry != 0) {
+        assert(size < GCI_FORMAT_BIG_WORDS);
+        result->words[size] = (uint32_t) carry;
+        size += 1;
+    }
+    result->size = size;
+}
+
+void gci_format_big_subtract(struct GciFormatBig *big, struct GciFormatBig const *other) {
+    assert(big != NULL && other != NULL);
+    assert(gci_format_big_compare(big, other) >= 0);
+
+    uint64_t borrow = 0;
+    for (size_t index = 0; index < big->size; index++) {
+        uint64_t subtrahend = borrow + (index < other->size ? other->words[index] : 0);
+        uint64_t word = big->words[index];
+        big->words[index] = (uint32_t) (word - subtrahend);
+        borrow = word < subtrahend ? 1 : 0;
+    }
+
+    while (big->size > 0 && big->words[big->size - 1] == 0) {
+        big->size -= 1;
+    }
+}
+
+int gci_format_big_compare(struct GciFormatBig const *a, struct GciFormatBig const *b) {
+    assert(a != NULL && b != NULL);
+    if (a->size != b->size) {
+        return a->size < b->size ? -1 : 1;
+    }
+    for (size_t index = a->size; index > 0; index--) {
+        if (a->words[index - 1] != b->words[index - 1]) {
+            return a->words[index - 1] < b->words[index - 1] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+struct GciFormatFloat gci_format_normalize(struct GciFormatFloat value) {
+    assert(value.f != 0);
+    while ((value.f >> 63) == 0) {
+        value.f <<= 1;
+        value.e -= 1;
+    }
+    return value;
+}
+
+// Multiplies two floats, rounding the significand of the product.
+struct GciFormatFloat gci_format_multiply(struct GciFormatFloat a, struct GciFormatFloat b) {
+    uint64_t mask = 0xffffffffu;
+    uint64_t a_high = a.f >> 32, a_low = a.f & mask;
+    uint64_t b_high = b.f >> 32, b_low = b.f & mask;
+
+    uint64_t high_high = a_high * b_high;
+    uint64_t low_high = a_low * b_high;
+    uint64_t high_low = a_high * b_low;
+    uint64_t low_low = a_low * b_low;
+
+    uint64_t middle = (low_low >> 32) + (high_low & mask) + (low_high & mask) + ((uint64_t) 1 << 31);
+    return (struct GciFormatFloat) {
+        .f = high_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32),
+        .e = a.e + b.e + 64,
+    };
+}
+
+// Grisu3 by Loitsch, generates the shortest digits with 64 bit arithmetic
+// and a cached power of ten. Returns false for the few values where the
+// imprecision of the scaled boundaries leaves the result uncertain.
+bool gci_format_grisu(struct GciFormatDecimal *decimal, uint64_t f, int e, bool uneven) {
+    assert(decimal != NULL);
+
+    struct GciFormatFloat w = gci_format_normalize((struct GciFormatFloat) { .f = f, .e = e });
+    struct GciFormatFloat plus = gci_format_normalize((struct GciFormatFloat) { .f = (f << 1) + 1, .e = e - 1 });
+    struct GciFormatFloat minus = uneven
+        ? (struct GciFormatFloat) { .f = (f << 2) - 1, .e = e - 2 }
+        : (struct GciFormatFloat) { .f = (f << 1) - 1, .e = e - 1 };
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+    assert(w.e == plus.e);
+
+    // Pick the power which scales w into [2^-60, 2^-32) so the integral
+    // part of every scaled value fits in 32 bits
+    double estimate = (double) (-60 - (w.e + 64) + 63) * 0.30102999566398114;
+    int k = (int) estimate;
+    if ((double) k < estimate) { k += 1; }
+    struct GciFormatPower const *power = &gci_format_powers[(348 + k - 1) / 8 + 1];
+    struct GciFormatFloat ten_mk = { .f = power->f, .e = power->e };
+
+    struct GciFormatFloat scaled_w = gci_format_multiply(w, ten_mk);
+    struct GciFormatFloat low = gci_format_multiply(minus, ten_mk);
+    struct GciFormatFloat high = gci_format_multiply(plus, ten_mk);
+    assert(-60 <= scaled_w.e && scaled_w.e <= -32);
+
+    // The scaled boundaries are off by at most one unit, only digits inside
+    // the narrowed interval are certain
+    uint64_t unit = 1;
+    uint64_t too_low = low.f - unit;
+    uint64_t too_high = high.f + unit;
+    uint64_t unsafe_interval = too_high - too_low;
+
+    unsigned shift = (unsigned) -scaled_w.e;
+    uint64_t one = (uint64_t) 1 << shift;
+    uint32_t integrals = (uint32_t) (too_high >> shift);
+    uint64_t fractionals = too_high & (one - 1);
+
+    uint32_t divisor = 1;
+    int kappa = integrals == 0 ? 0 : 1;
+    while (integrals / divisor >= 10) {
+        divisor *= 10;
+        kappa += 1;
+    }
+
+    decimal->size = 0;
+    while (kappa > 0) {
+        decimal->digits[decimal->size] = (char) ('0' + integrals / divisor);
+        decimal->size += 1;
+        integrals %= divisor;
+        kappa -= 1;
+
+        uint64_t rest = ((uint64_t) integrals << shift) + fractionals;
+        if (rest < unsafe_interval) {
+            decimal->exponent = (int) decimal->size + kappa - power->exponent;
+            return gci_format_round_weed(decimal, too_high - scaled_w.f, unsafe_interval, rest, (uint64_t) divisor << shift, unit);
+        }
+        divisor /= 10;
+    }
+
+    for (;;) {
+        if (decimal->size >= GCI_FORMAT_DIGITS_MAX) { return false; }
+
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+
+        decimal->digits[decimal->size] = (char) ('0' + (fractionals >> shift));
+        decimal->size += 1;
+        fractionals &= one - 1;
+        kappa -= 1;
+
+        if (fractionals < unsafe_interval) {
+            decimal->exponent = (int) decimal->size + kappa - power->exponent;
+            return gci_format_round_weed(decimal, (too_high - scaled_w.f) * unit, unsafe_interval, fractionals, one, unit);
+        }
+    }
+}
+
+// Moves the last digit towards w while it stays inside the safe interval
+// and checks that the result is certainly the closest shortest one.
+bool gci_format_round_weed(
+    struct GciFormatDecimal *decimal,
+    uint64_t distance_high_w,
+    uint64_t unsafe_interval,
+    uint64_t rest,
+    uint64_t ten_kappa,
+    uint64_t unit
+) {
+    assert(decimal != NULL && decimal->size > 0);
+    uint64_t small_distance = distance_high_w - unit;
+    uint64_t big_distance = distance_high_w + unit;
+
+    while (
+        rest < small_distance &&
+        unsafe_interval - rest >= ten_kappa &&
+        (rest + ten_kappa < small_distance || small_distance - rest >= rest + ten_kappa - small_distance)
+    ) {
+        decimal->digits[decimal->size - 1] -= 1;
+        rest += ten_kappa;
+    }
+
+    if (
+        rest < big_distance &&
+        unsafe_interval - rest >= ten_kappa &&
+        (rest + ten_kappa < big_distance || big_distance - rest > rest + ten_kappa - big_distance)
+    ) {
+        return false;
+    }
+
+    return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+// Finds the shortest digits which round to `value` with the free-format
+// algorithm of Burger and Dybvig. The value and the halfway points to its
+// neighbours are kept as exact fractions r / s and (r ± m) / s, digits are
+// generated until one of the halfway points is passed.
+void gci_format_shortest(struct GciFormatDecimal *decimal, double value) {
+    assert(decimal != NULL);
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    decimal->negative = (bits >> 63) != 0;
+    decimal->size = 0;
+    decimal->exponent = 0;
+    decimal->special = NULL;
+
+    uint64_t mantissa = bits & (((uint64_t) 1 << 52) - 1);
+    unsigned biased = (unsigned) ((bits >> 52) & 0x7ff);
+
+    if (biased == 0x7ff) {
+        decimal->special = mantissa != 0 ? "nan" : "inf";
+        decimal->negative = decimal->negative && mantissa == 0;
+        return;
+    }
+    if (biased == 0 && mantissa == 0) {
+        decimal->digits[0] = '0';
+        decimal->size = 1;
+        decimal->exponent = 1;
+        return;
+    }
+
+    uint64_t f = biased == 0 ? mantissa : mantissa | ((uint64_t) 1 << 52);
+    int e = biased == 0 ? -1074 : (int) biased - 1075;
+    // Halfway points are inclusive when the mantissa is even, round to even
+    // parses them back to `value`
+    bool inclusive = (f & 1) == 0;
+    // The gap to the next lower double is half as wide at a power of two
+    bool uneven = mantissa == 0 && biased > 1;
+    if (gci_format_grisu(decimal, f, e, uneven)) { return; }
+    decimal->size = 0;
+
+    struct GciFormatBig r, s, m_plus, m_minus, sum;
+    gci_format_big_set(&r, f);
+    gci_format_big_set(&s, 1);
+    gci_format_big_set(&m_plus, 1);
+    gci_format_big_set(&m_minus, 1);
+    if (e >= 0) {
+        gci_format_big_shift(&r, (unsigned) e + (uneven ? 2 : 1));
+        gci_format_big_shift(&s, uneven ? 2 : 1);
+        gci_format_big_shift(&m_plus, (unsigned) e + (uneven ? 1 : 0));
+        gci_format_big_shift(&m_minus, (unsigned) e);
+    } else {
+        gci_format_big_shift(&r, uneven ? 2 : 1);
+        gci_format_big_shift(&s, (unsigned) -e + (uneven ? 2 : 1));
+        gci_format_big_shift(&m_plus, uneven ? 1 : 0);
+    }
+
+    // Estimate of ceil(log10(value)) which is either right or one too small
+    int length = 0;
+    for (uint64_t rest = f; rest != 0; rest >>= 1) {
+        length += 1;
+    }
+    double estimate = (double) (e + length - 1) * 0.30102999566398114 - 1e-10;
+    int k = (int) estimate;
+    if ((double) k < estimate) { k += 1; }
+
+    if (k >= 0) {
+        gci_format_big_pow10(&s, (unsigned) k);
+    } else {
+        gci_format_big_pow10(&r, (unsigned) -k);
+        gci_format_big_pow10(&m_plus, (unsigned) -k);
+        gci_format_big_pow10(&m_minus, (unsigned) -k);
+    }
+
+    gci_format_big_add(&sum, &r, &m_plus);
+    int high = gci_format_big_compare(&sum, &s);
+    if (inclusive ? high >= 0 : high > 0) {
+        gci_format_big_multiply(&s, 10);
+        k += 1;
+    }
+    decimal->exponent = k;
+
+    for (;;) {
+        gci_format_big_multiply(&r, 10);
+        gci_format_big_multiply(&m_plus, 10);
+        gci_format_big_multiply(&m_minus, 10);
+
+        int digit = 0;
+        while (gci_format_big_compare(&r, &s) >= 0) {
+            gci_format_big_subtract(&r, &s);
+            digit += 1;
+        }
+        assert(digit <= 9);
+
+        int low = gci_format_big_compare(&r, &m_minus);
+        gci_format_big_add(&sum, &r, &m_plus);
+        high = gci_format_big_compare(&sum, &s);
+        bool low_reached = inclusive ? low <= 0 : low < 0;
+        bool high_reached = inclusive ? high >= 0 : high > 0;
+
+        if (low_reached && high_reached) {
+            // Both neighbours are in reach, pick the closer digit
+            gci_format_big_add(&sum, &r, &r);
+            if (gci_format_big_compare(&sum, &s) >= 0) { digit += 1; }
+        } else if (high_reached) {
+            digit += 1;
+        }
+
+        assert(decimal->size < GCI_FORMAT_DIGITS_MAX);
+        decimal->digits[decimal->size] = (char) ('0' + digit);
+        decimal->size += 1;
+        if (low_reached || high_reached) { break; }
+    }
+}
+
+size_t gci_format_decimal_length(struct GciFormatDecimal const *decimal) {
+    assert(decimal != NULL);
+    size_t sign = decimal->negative ? 1 : 0;
+    if (decimal->special != NULL) {
+        return sign + strlen(decimal->special);
+    }
+
+    int size = (int) decimal->size;
+    int k = decimal->exponent;
+    if (size <= k && k <= 21) {
+        return sign + (size_t) k;
+    } else if (0 < k && k <= 21) {
+        return sign + (size_t) size + 1;
+    } else if (-6 < k && k <= 0) {
+        return sign + 2 + (size_t) -k + (size_t) size;
+    }
+
+    int exponent = k - 1;
+    size_t exponent_length = exponent <= -100 || exponent >= 100 ? 3 : (exponent <= -10 || exponent >= 10 ? 2 : 1);
+    return sign + (size_t) size + (size > 1 ? 1 : 0) + 2 + exponent_length;
+}
+
+void gci_format_decimal_write(char *output, struct GciFormatDecimal const *decimal, size_t length) {
+    assert(output != NULL);
+    assert(decimal != NULL);
+    assert(length == gci_format_decimal_length(decimal));
+    (void) length;
+
+    if (decimal->negative) {
+        *output++ = '-';
+    }
+    if (decimal->special != NULL) {
+        memcpy(output, decimal->special, strlen(decimal->special));
+        return;
+    }
+
+    size_t size = decimal->size;
+    int k = decimal->exponent;
+    if ((int) size <= k && k <= 21) {
+        memcpy(output, decimal->digits, size);
+        memset(output + size, '0', (size_t) k - size);
+    } else if (0 < k && k <= 21) {
+        memcpy(output, decimal->digits, (size_t) k);
+        output[k] = '.';
+        memcpy(output + k + 1, decimal->digits + k, size - (size_t) k);
+    } else if (-6 < k && k <= 0) {
+        output[0] = '0';
+        output[1] = '.';
+        memset(output + 2, '0', (size_t) -k);
+        memcpy(output + 2 + -k, decimal->digits, size);
+    } else {
+        *output++ = decimal->digits[0];
+        if (size > 1) {
+            *output++ = '.';
+            memcpy(output, decimal->digits + 1, size - 1);
+            output += size - 1;
+        }
+
+        int exponent = k - 1;
+        *output++ = 'e';
+        *output++ = exponent < 0 ? '-' : '+';
+        unsigned magnitude = (unsigned) (exponent < 0 ? -exponent : exponent);
+        gci_format_digits(output, magnitude, gci_format_length(magnitude));
+    }
+}
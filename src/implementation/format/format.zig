@@ -0,0 +1,106 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const writer = @import("../writer/writer.zig");
+const InterfaceWriter = writer.InterfaceWriter;
+
+pub const max = lib.GCI_FORMAT_MAX;
+
+pub fn formatU64(buffer: *[max]u8, value: u64) []u8 {
+    return buffer[0..lib.gci_format_u64(buffer, value)];
+}
+
+pub fn formatI64(buffer: *[max]u8, value: i64) []u8 {
+    return buffer[0..lib.gci_format_i64(buffer, value)];
+}
+
+pub fn formatHex(buffer: *[max]u8, value: u64) []u8 {
+    return buffer[0..lib.gci_format_hex(buffer, value)];
+}
+
+pub fn formatF64(buffer: *[max]u8, value: f64) []u8 {
+    return buffer[0..lib.gci_format_f64(buffer, value)];
+}
+
+pub fn writeU64(w: InterfaceWriter, value: u64) !void {
+    if (!lib.gci_write_u64(w.writer, value)) {
+        return error.Writer;
+    }
+}
+
+pub fn writeI64(w: InterfaceWriter, value: i64) !void {
+    if (!lib.gci_write_i64(w.writer, value)) {
+        return error.Writer;
+    }
+}
+
+pub fn writeHex(w: InterfaceWriter, value: u64) !void {
+    if (!lib.gci_write_hex(w.writer, value)) {
+        return error.Writer;
+    }
+}
+
+pub fn writeF64(w: InterfaceWriter, value: f64) !void {
+    if (!lib.gci_write_f64(w.writer, value)) {
+        return error.Writer;
+    }
+}
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_format.zig");
+}
+
+test "integers" {
+    var buffer: [max]u8 = undefined;
+    try testing.expectEqualStrings("0", formatU64(&buffer, 0));
+    try testing.expectEqualStrings("18446744073709551615", formatU64(&buffer, std.math.maxInt(u64)));
+    try testing.expectEqualStrings("-9223372036854775808", formatI64(&buffer, std.math.minInt(i64)));
+    try testing.expectEqualStrings("ff00", formatHex(&buffer, 0xff00));
+}
+
+test "floats round trip" {
+    var prng = std.Random.DefaultPrng.init(7);
+    const random = prng.random();
+
+    var buffer: [max]u8 = undefined;
+    for (0..10000) |_| {
+        const value: f64 = @bitCast(random.int(u64));
+        if (!std.math.isFinite(value)) {
+            continue;
+        }
+        const result = formatF64(&buffer, value);
+        try testing.expectEqual(value, try std.fmt.parseFloat(f64, result));
+    }
+}
+
+test "floats shortest" {
+    var buffer: [max]u8 = undefined;
+    try testing.expectEqualStrings("0.1", formatF64(&buffer, 0.1));
+    try testing.expectEqualStrings("0.30000000000000004", formatF64(&buffer, 0.1 + 0.2));
+    try testing.expectEqualStrings("-1500", formatF64(&buffer, -1500.0));
+    try testing.expectEqualStrings("1e+21", formatF64(&buffer, 1e21));
+    try testing.expectEqualStrings("2.5e-7", formatF64(&buffer, 2.5e-7));
+    try testing.expectEqualStrings("5e-324", formatF64(&buffer, 5e-324));
+    try testing.expectEqualStrings("-inf", formatF64(&buffer, -std.math.inf(f64)));
+}
+
+test "write into buffer" {
+    var b: [64]u8 = undefined;
+    var c = try writer.String.init(&b);
+    var buffer: [8]u8 = undefined;
+    var context = try writer.Buffer.init(c.interface(), &buffer);
+    const w = context.interface();
+
+    try writeU64(w, 42);
+    try w.write(" ");
+    try writeI64(w, -7);
+    try w.write(" ");
+    try writeHex(w, 0xbeef);
+    try w.write(" ");
+    try writeF64(w, 1234.5);
+    try context.flush();
+
+    try testing.expectEqualStrings("42 -7 beef 1234.5", b[0..c.inner.current]);
+}
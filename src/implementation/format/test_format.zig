@@ -0,0 +1,66 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "format u64" {
+    var buffer: [lib.GCI_FORMAT_MAX]u8 = undefined;
+
+    const length1 = lib.gci_format_u64(&buffer, 7);
+    try testing.expectEqualStrings("7", buffer[0..length1]);
+
+    const length2 = lib.gci_format_u64(&buffer, 1234567890);
+    try testing.expectEqualStrings("1234567890", buffer[0..length2]);
+}
+
+test "format i64" {
+    var buffer: [lib.GCI_FORMAT_MAX]u8 = undefined;
+
+    const length1 = lib.gci_format_i64(&buffer, -100);
+    try testing.expectEqualStrings("-100", buffer[0..length1]);
+
+    const length2 = lib.gci_format_i64(&buffer, 99);
+    try testing.expectEqualStrings("99", buffer[0..length2]);
+}
+
+test "format hex" {
+    var buffer: [lib.GCI_FORMAT_MAX]u8 = undefined;
+
+    const length1 = lib.gci_format_hex(&buffer, 0);
+    try testing.expectEqualStrings("0", buffer[0..length1]);
+
+    const length2 = lib.gci_format_hex(&buffer, 0xffffffffffffffff);
+    try testing.expectEqualStrings("ffffffffffffffff", buffer[0..length2]);
+}
+
+test "format f64" {
+    var buffer: [lib.GCI_FORMAT_MAX]u8 = undefined;
+
+    const length1 = lib.gci_format_f64(&buffer, 0.000001);
+    try testing.expectEqualStrings("0.000001", buffer[0..length1]);
+
+    const length2 = lib.gci_format_f64(&buffer, 1.7976931348623157e308);
+    try testing.expectEqualStrings("1.7976931348623157e+308", buffer[0..length2]);
+
+    const length3 = lib.gci_format_f64(&buffer, -0.0);
+    try testing.expectEqualStrings("-0", buffer[0..length3]);
+
+    const length4 = lib.gci_format_f64(&buffer, std.math.nan(f64));
+    try testing.expectEqualStrings("nan", buffer[0..length4]);
+}
+
+test "write without reserve" {
+    var b: [8]u8 = undefined;
+    var s: lib.GciWriterString = undefined;
+    const init_err = lib.gci_writer_string_init(&s, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    var writer = lib.gci_writer_string_interface(&s);
+    writer.reserve = null;
+    writer.commit = null;
+
+    try testing.expect(lib.gci_write_f64(writer, 2.5));
+    try testing.expect(lib.gci_write_u64(writer, 10));
+    try testing.expectEqualStrings("2.510", b[0..s.current]);
+
+    try testing.expect(!lib.gci_write_u64(writer, 1000));
+}
@@ -0,0 +1,45 @@
+#ifndef GCI_ALLOCATOR_H
+#define GCI_ALLOCATOR_H
+#include <stddef.h>
+#include <gci_common.h>
+#include <gci_interface_allocator.h>
+
+// Alignment of every allocation made by the allocators in this file.
+#define GCI_ALLOCATOR_ALIGNMENT 16
+
+// Makes an allocator interface using `malloc`, `realloc` and `free`.
+struct GciInterfaceAllocator gci_allocator_libc_interface(void);
+
+// A bump allocator handing out memory from a caller supplied buffer. Memory
+// is released all at once by `gci_allocator_arena_reset`, only the most
+// recent allocation can be freed or resized in place.
+struct GciAllocatorArena {
+    char *buffer;
+    size_t buffer_size;
+    size_t current;
+    size_t last;
+};
+
+// Initializes a `struct GciAllocatorArena`.
+//
+// Params:
+//  context:        Single item pointer to `struct GciAllocatorArena`.
+//  buffer:         Pointer to at least as many items as specified by
+//                  `buffer_size`, owned by `context` if call succeeds.
+//  buffer_size:    Specifies at most how many items `buffer` points to.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `buffer` is null.
+enum GciError gci_allocator_arena_init(struct GciAllocatorArena *context, char *buffer, size_t buffer_size);
+
+// Makes an allocator interface from an already initialized
+// `struct GciAllocatorArena` the returned allocator owns the passed in `context`.
+struct GciInterfaceAllocator gci_allocator_arena_interface(struct GciAllocatorArena *context);
+
+// Releases every allocation made from the arena.
+void gci_allocator_arena_reset(struct GciAllocatorArena *context);
+
+#endif
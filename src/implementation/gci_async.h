@@ -0,0 +1,113 @@
+#ifndef GCI_ASYNC_H
+#define GCI_ASYNC_H
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <gci_common.h>
+#include <gci_interface_reader.h>
+#include <gci_interface_writer.h>
+
+// Readers and writers which call their internal reader or writer from a
+// background thread. Needs POSIX threads and unnamed semaphores.
+
+// A double buffer whose idle half is filled by a background thread while
+// the active half is consumed. All calls to the internal reader are made
+// from the background thread. Must not be moved after a successful
+// `gci_reader_async_init` and must be released with `gci_reader_async_deinit`.
+struct GciReaderAsync {
+    struct GciInterfaceReader reader;
+    char *buffer;
+    char *next_read;
+    size_t buffer_size;
+    size_t current;
+    size_t length_read;
+    size_t fill_length;
+    bool fill_requested;
+    bool fill_done;
+    bool fill_eof;
+    bool stop;
+    bool eof;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t signal;
+};
+
+enum GciError gci_reader_async_init(
+    struct GciReaderAsync *context,
+    struct GciInterfaceReader reader,
+    char *buffer,
+    size_t buffer_size
+);
+void gci_reader_async_deinit(struct GciReaderAsync *context);
+struct GciInterfaceReader gci_reader_async_interface(struct GciReaderAsync *context);
+
+#define GCI_WRITER_ASYNC_SLOTS_MAX 16
+
+// A writer that hands filled slots of its buffer to a background thread
+// which writes them to an internal writer, the producer only blocks when
+// every slot is waiting to be written. Slots are passed through a single
+// producer single consumer ring, where each side owns its own index and
+// the `filled` and `free` semaphores hand slots between them.
+//
+// Must not be moved after a successful `gci_writer_async_init` and must be
+// released with `gci_writer_async_deinit`.
+struct GciWriterAsync {
+    struct GciInterfaceWriter writer;
+    char *buffer;
+    size_t slot_size;
+    size_t slot_count;
+    size_t lengths[GCI_WRITER_ASYNC_SLOTS_MAX];
+    size_t producer_slot;
+    size_t consumer_slot;
+    size_t current;
+    bool holding;
+    bool closing;
+    bool error;
+    sem_t filled;
+    sem_t free;
+    pthread_t thread;
+};
+
+// Initializes a `struct GciWriterAsync` and starts its background thread.
+//
+// Params:
+//  context:        Single item pointer to `struct GciWriterAsync`.
+//  writer:         Valid write struct, owned by `context` if call succeeds
+//                  and only called from the background thread.
+//  buffer:         Pointer to at least as many items as specified by
+//                  `buffer_size`, owned by `writer` if call succeeds.
+//  buffer_size:    Specifies at most how many items `buffer` points to.
+//  slot_count:     Amount of equally sized slots `buffer` is split into.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `buffer` is null.
+//  GCI_ERROR_BUFFER:   Returned in the following situations:
+//      1. `slot_count` is less than 2 or larger than `GCI_WRITER_ASYNC_SLOTS_MAX`.
+//      2. `buffer_size` is not a non-zero multiple of `slot_count`.
+//  GCI_ERROR_IO:       The background thread could not be started.
+enum GciError gci_writer_async_init(
+    struct GciWriterAsync *context,
+    struct GciInterfaceWriter writer,
+    char *buffer,
+    size_t buffer_size,
+    size_t slot_count
+);
+
+// Makes a writer interface from an already initialized `struct GciWriterAsync`
+// the returned writer owns the passed in `context`.
+struct GciInterfaceWriter gci_writer_async_interface(struct GciWriterAsync *context);
+
+// Hands any buffered bytes to the background thread and waits until
+// everything written so far has been written to the internal writer.
+// Returns false if any write to the internal writer has failed.
+bool gci_writer_async_flush(struct GciWriterAsync *context);
+
+// Flushes and stops the background thread. Returns false if any write to
+// the internal writer has failed.
+bool gci_writer_async_deinit(struct GciWriterAsync *context);
+
+#endif
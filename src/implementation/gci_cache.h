@@ -0,0 +1,146 @@
+#ifndef GCI_CACHE_H
+#define GCI_CACHE_H
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <gci_common.h>
+#include <gci_interface_allocator.h>
+#include <gci_interface_reader.h>
+
+enum GciCacheBlockState {
+    GCI_CACHE_BLOCK_EMPTY   = 0,
+    GCI_CACHE_BLOCK_LOADING = 1,
+    GCI_CACHE_BLOCK_READY   = 2,
+};
+
+// Bookkeeping of one cached block. Blocks which are not pinned and not
+// being loaded are kept in a list from least to most recently used through
+// `older` and `newer`, `chain` links blocks which hash to the same bucket.
+struct GciCacheBlock {
+    uint64_t index;
+    size_t length;
+    size_t pins;
+    enum GciCacheBlockState state;
+    size_t older;
+    size_t newer;
+    size_t chain;
+};
+
+// A cache of fixed size blocks read from a reader which implements
+// `read_at`, shared between any amount of threads. Block `i` holds the
+// bytes at offset `i * block_size` of the source. A block is pinned while it
+// is in use and the least recently used unpinned block is evicted to load a
+// missing one. The source is read outside of the lock, threads which need a
+// block that is being loaded wait for it instead of reading it again.
+//
+// Must not be moved after a successful `gci_reader_cached_init` and must be
+// released with `gci_reader_cached_deinit`.
+struct GciReaderCached {
+    struct GciInterfaceReader reader;
+    struct GciInterfaceAllocator allocator;
+    char *data;
+    struct GciCacheBlock *blocks;
+    size_t *buckets;
+    size_t block_size;
+    size_t block_count;
+    unsigned bucket_bits;
+    size_t oldest;
+    size_t newest;
+    size_t waiting;
+    uint64_t hits;
+    uint64_t misses;
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+};
+
+// Initializes a `struct GciReaderCached`.
+//
+// Params:
+//  context:        Single item pointer to `struct GciReaderCached`.
+//  reader:         Valid reader struct which implements `read_at`, owned by
+//                  `context` if call succeeds.
+//  allocator:      Valid allocator struct, used until `gci_reader_cached_deinit`.
+//  block_size:     Amount of bytes in each block.
+//  block_count:    Amount of blocks kept in memory.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `reader` does not implement `read_at`.
+//  GCI_ERROR_BUFFER:   Returned in the following situations:
+//      1. `block_size` or `block_count` is zero.
+//      2. The blocks could not be allocated.
+//  GCI_ERROR_IO:       The lock could not be created.
+enum GciError gci_reader_cached_init(
+    struct GciReaderCached *context,
+    struct GciInterfaceReader reader,
+    struct GciInterfaceAllocator allocator,
+    size_t block_size,
+    size_t block_count
+);
+
+// Returns the blocks to the allocator, no block may be pinned.
+void gci_reader_cached_deinit(struct GciReaderCached *context);
+
+// Reads `buffer_size` bytes starting at `offset` through the cache. May be
+// called from several threads at once. Returns the amount of bytes read, a
+// short read means the source ended or an error occured.
+size_t gci_reader_cached_read_at(struct GciReaderCached *context, char *buffer, size_t buffer_size, uint64_t offset);
+
+// Pins block `block` in memory, loading it if needed. Waits for another
+// thread to unpin a block if every block is pinned.
+//
+// Params:
+//  context:    Single item pointer to `struct GciReaderCached`.
+//  block:      Index of the block.
+//  length:     Set to the amount of bytes in the block, less than
+//              `block_size` if the source ended or an error occured.
+//
+// Return:
+//  The bytes of the block, valid until they are passed to
+//  `gci_reader_cached_unpin`.
+char const *gci_reader_cached_pin(struct GciReaderCached *context, uint64_t block, size_t *length);
+
+// Releases a block returned by `gci_reader_cached_pin`.
+void gci_reader_cached_unpin(struct GciReaderCached *context, char const *data);
+
+// Sets `hits` and `misses` to the amount of pins which found their block in
+// the cache and which had to load it.
+void gci_reader_cached_counters(struct GciReaderCached *context, uint64_t *hits, uint64_t *misses);
+
+// A sequential reader over a `struct GciReaderCached` starting at some
+// offset, used by one thread at a time. Keeps the block it is reading from
+// pinned so peeks borrow straight from the cache. Its `read_at` reads
+// through the shared cache and may be used from any thread.
+struct GciReaderCachedCursor {
+    struct GciReaderCached *cache;
+    uint64_t offset;
+    char const *pinned;
+    uint64_t pinned_block;
+    size_t pinned_length;
+    bool eof;
+};
+
+// Initializes a `struct GciReaderCachedCursor`.
+//
+// Params:
+//  context:    Single item pointer to `struct GciReaderCachedCursor`.
+//  cache:      Initialized cache, must outlive `context`.
+//  offset:     Offset of the source the first read starts at.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `cache` is null.
+enum GciError gci_reader_cached_cursor_init(struct GciReaderCachedCursor *context, struct GciReaderCached *cache, uint64_t offset);
+
+// Unpins the block the cursor is reading from.
+void gci_reader_cached_cursor_deinit(struct GciReaderCachedCursor *context);
+
+// Makes a reader interface from an already initialized `struct GciReaderCachedCursor`
+// the returned reader owns the passed in `context`.
+struct GciInterfaceReader gci_reader_cached_cursor_interface(struct GciReaderCachedCursor *context);
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef GCI_CHECKSUM_H
+#define GCI_CHECKSUM_H
+#include <stdint.h>
+#include <gci_common.h>
+#include <gci_simd.h>
+#include <gci_interface_reader.h>
+#include <gci_interface_writer.h>
+
+// Updates a CRC32C (Castagnoli) checksum with `data`, start from zero and
+// pass the previous result to continue a checksum over several pieces. Uses
+// the crc32 instruction of SSE4.2 if the running cpu supports it.
+uint32_t gci_crc32c(uint32_t crc, char const *data, size_t data_size);
+
+// Like `gci_crc32c` but uses the kernel of `simd`, or of the best supported
+// level if `simd` is not supported.
+uint32_t gci_crc32c_simd(enum GciSimd simd, uint32_t crc, char const *data, size_t data_size);
+
+// Streaming state of a xxHash64 checksum.
+struct GciXxh64 {
+    uint64_t seed;
+    uint64_t total;
+    uint64_t lanes[4];
+    unsigned char pending[32];
+    size_t pending_size;
+};
+
+void gci_xxh64_init(struct GciXxh64 *state, uint64_t seed);
+void gci_xxh64_update(struct GciXxh64 *state, char const *data, size_t data_size);
+
+// Returns the checksum of everything passed to `state` so far, `state` may
+// be updated further afterwards.
+uint64_t gci_xxh64_digest(struct GciXxh64 const *state);
+
+enum GciChecksumAlgorithm {
+    GCI_CHECKSUM_CRC32C = 1,
+    GCI_CHECKSUM_XXH64  = 2,
+};
+
+// Checksums computed over the same bytes, `algorithms` is a bitwise or of
+// `enum GciChecksumAlgorithm` and only the selected ones are updated.
+struct GciChecksum {
+    unsigned algorithms;
+    uint32_t crc32c;
+    struct GciXxh64 xxh64;
+};
+
+void gci_checksum_init(struct GciChecksum *checksum, unsigned algorithms);
+void gci_checksum_update(struct GciChecksum *checksum, char const *data, size_t data_size);
+uint32_t gci_checksum_crc32c(struct GciChecksum const *checksum);
+uint64_t gci_checksum_xxh64(struct GciChecksum const *checksum);
+
+// A reader that forwards every call to an internal reader and checksums the
+// bytes as they are read or consumed.
+struct GciReaderChecksum {
+    struct GciInterfaceReader reader;
+    struct GciChecksum checksum;
+    char const *peeked;
+};
+
+// Initializes a `struct GciReaderChecksum`.
+//
+// Params:
+//  context:    Single item pointer to `struct GciReaderChecksum`.
+//  reader:     Valid reader struct, owned by `context` if call succeeds.
+//  algorithms: Bitwise or of the `enum GciChecksumAlgorithm` to compute.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     `context` is null.
+enum GciError gci_reader_checksum_init(struct GciReaderChecksum *context, struct GciInterfaceReader reader, unsigned algorithms);
+
+// Makes a reader interface from an already initialized `struct GciReaderChecksum`
+// the returned reader owns the passed in `context`. The interface implements
+// `peek` and `consume` if the internal reader does, and forwards `read_at`
+// without checksumming the bytes it reads.
+struct GciInterfaceReader gci_reader_checksum_interface(struct GciReaderChecksum *context);
+
+// A writer that forwards every call to an internal writer and checksums the
+// bytes as they are written. Once a write has been short the checksum may
+// cover bytes the internal writer did not write.
+struct GciWriterChecksum {
+    struct GciInterfaceWriter writer;
+    struct GciChecksum checksum;
+    char const *reserved;
+};
+
+// Initializes a `struct GciWriterChecksum`.
+//
+// Params:
+//  context:    Single item pointer to `struct GciWriterChecksum`.
+//  writer:     Valid write struct, owned by `context` if call succeeds.
+//  algorithms: Bitwise or of the `enum GciChecksumAlgorithm` to compute.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     `context` is null.
+enum GciError gci_writer_checksum_init(struct GciWriterChecksum *context, struct GciInterfaceWriter writer, unsigned algorithms);
+
+// Makes a writer interface from an already initialized `struct GciWriterChecksum`
+// the returned writer owns the passed in `context`. The interface implements
+// the optional functions the internal writer implements.
+struct GciInterfaceWriter gci_writer_checksum_interface(struct GciWriterChecksum *context);
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef GCI_COMPRESS_H
+#define GCI_COMPRESS_H
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <gci_common.h>
+#include <gci_interface_reader.h>
+#include <gci_interface_writer.h>
+
+// An LZ77 block format in the style of LZ4. A block is a list of sequences,
+// each made of a token byte whose high and low nibble hold the literal
+// length and the match length minus four, extra length bytes for either
+// nibble equal to 15, the literals, and a little endian 16 bit offset back
+// to where the match is copied from. The last sequence has no match.
+//
+// A stream is the four byte magic "GCIZ", the block size of the writer as a
+// 32 bit little endian integer and a list of blocks. Every block starts with
+// a 32 bit little endian header holding the length of its payload, the high
+// bit is set if the payload is stored uncompressed, and a zero header marks
+// the end of the stream.
+
+#define GCI_COMPRESS_BLOCK_MAX 65536
+#define GCI_COMPRESS_BLOCK_MIN 16
+#define GCI_COMPRESS_TABLE_SIZE 8192
+
+// Compresses `data` into `output`.
+//
+// Params:
+//  table:          Scratch space of `GCI_COMPRESS_TABLE_SIZE` items.
+//  data:           The bytes to compress, at most `GCI_COMPRESS_BLOCK_MAX`.
+//  data_size:      The length of `data` in bytes.
+//  output:         Buffer the block is written to.
+//  output_size:    The length of `output` in bytes.
+//
+// Return:
+//  The length of the block, zero if it does not fit in `output`.
+size_t gci_compress_block(
+    uint16_t *table,
+    char const *data,
+    size_t data_size,
+    char *output,
+    size_t output_size
+);
+
+// Decompresses a block made by `gci_compress_block` into `output`. Returns
+// false if the block is malformed or does not fit in `output`, otherwise
+// `length` is set to the amount of bytes written to `output`.
+bool gci_decompress_block(
+    char const *block,
+    size_t block_size,
+    char *output,
+    size_t output_size,
+    size_t *length
+);
+
+// A writer that compresses everything written into blocks and writes them
+// to an internal writer as a stream, see above. A block is compressed once
+// it is full or the writer is flushed, blocks which do not get smaller are
+// stored as they are.
+struct GciWriterCompress {
+    struct GciInterfaceWriter writer;
+    char *buffer;
+    size_t block_size;
+    char *output;
+    size_t output_size;
+    size_t current;
+    bool started;
+    uint16_t table[GCI_COMPRESS_TABLE_SIZE];
+};
+
+// Initializes a `struct GciWriterCompress`.
+//
+// Params:
+//  context:        Single item pointer to `struct GciWriterCompress`.
+//  writer:         Valid write struct, owned by `context` if call succeeds.
+//  buffer:         Pointer to at least as many items as specified by
+//                  `buffer_size`, owned by `context` if call succeeds. Half
+//                  of it, at most `GCI_COMPRESS_BLOCK_MAX` bytes, is used
+//                  for the uncompressed block.
+//  buffer_size:    Specifies at most how many items `buffer` points to.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `buffer` is null.
+//  GCI_ERROR_BUFFER:   `buffer_size` is less than `2 * GCI_COMPRESS_BLOCK_MIN`.
+enum GciError gci_writer_compress_init(
+    struct GciWriterCompress *context,
+    struct GciInterfaceWriter writer,
+    char *buffer,
+    size_t buffer_size
+);
+
+// Makes a writer interface from an already initialized `struct GciWriterCompress`
+// the returned writer owns the passed in `context`.
+struct GciInterfaceWriter gci_writer_compress_interface(struct GciWriterCompress *context);
+
+// Compresses and writes the partially filled block. Returns false if the
+// internal writer failed.
+bool gci_writer_compress_flush(struct GciWriterCompress *context);
+
+// Flushes and ends the stream, nothing may be written afterwards. Returns
+// false if the internal writer failed.
+bool gci_writer_compress_finish(struct GciWriterCompress *context);
+
+#define GCI_COMPRESS_SLOTS_MAX 32
+#define GCI_COMPRESS_THREADS_MAX 16
+
+enum GciCompressSlotState {
+    GCI_COMPRESS_SLOT_FREE      = 0,
+    GCI_COMPRESS_SLOT_FILLED    = 1,
+    GCI_COMPRESS_SLOT_BUSY      = 2,
+    GCI_COMPRESS_SLOT_DONE      = 3,
+};
+
+// A writer that writes the same stream as `struct GciWriterCompress` but
+// compresses its blocks on a pool of worker threads. The buffer is split
+// into slots, each holding a block and room for its compressed form. Filled
+// slots are compressed by whichever worker is idle and written to the
+// internal writer in order by the producer, which only blocks when the
+// oldest slot is still being compressed and it needs the slot back.
+//
+// Must not be moved after a successful `gci_writer_compress_parallel_init`
+// and must be released with `gci_writer_compress_parallel_deinit`.
+struct GciWriterCompressParallel {
+    struct GciInterfaceWriter writer;
+    char *buffer;
+    size_t block_size;
+    size_t slot_count;
+    size_t thread_count;
+    size_t lengths[GCI_COMPRESS_SLOTS_MAX];
+    size_t compressed[GCI_COMPRESS_SLOTS_MAX];
+    enum GciCompressSlotState states[GCI_COMPRESS_SLOTS_MAX];
+    size_t fill_slot;
+    size_t work_slot;
+    size_t write_slot;
+    size_t in_flight;
+    size_t current;
+    bool started;
+    bool closing;
+    bool error;
+    pthread_mutex_t mutex;
+    pthread_cond_t work;
+    pthread_cond_t done;
+    pthread_t threads[GCI_COMPRESS_THREADS_MAX];
+};
+
+// Initializes a `struct GciWriterCompressParallel` and starts its workers.
+//
+// Params:
+//  context:        Single item pointer to `struct GciWriterCompressParallel`.
+//  writer:         Valid write struct, owned by `context` if call succeeds.
+//  buffer:         Pointer to at least as many items as specified by
+//                  `buffer_size`, owned by `context` if call succeeds. Each
+//                  slot gets `buffer_size / slot_count` bytes, half of them,
+//                  at most `GCI_COMPRESS_BLOCK_MAX`, for its block.
+//  buffer_size:    Specifies at most how many items `buffer` points to.
+//  slot_count:     Amount of blocks that may be in flight at once.
+//  thread_count:   Amount of worker threads.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `buffer` is null.
+//  GCI_ERROR_BUFFER:   Returned in the following situations:
+//      1. `slot_count` is less than 2 or larger than `GCI_COMPRESS_SLOTS_MAX`.
+//      2. `thread_count` is zero or larger than `GCI_COMPRESS_THREADS_MAX`.
+//      3. A block would be smaller than `GCI_COMPRESS_BLOCK_MIN`.
+//  GCI_ERROR_IO:       The worker threads could not be started.
+enum GciError gci_writer_compress_parallel_init(
+    struct GciWriterCompressParallel *context,
+    struct GciInterfaceWriter writer,
+    char *buffer,
+    size_t buffer_size,
+    size_t slot_count,
+    size_t thread_count
+);
+
+// Makes a writer interface from an already initialized
+// `struct GciWriterCompressParallel` the returned writer owns the passed in
+// `context`.
+struct GciInterfaceWriter gci_writer_compress_parallel_interface(struct GciWriterCompressParallel *context);
+
+// Hands the partially filled block to the workers and writes every block in
+// flight. Returns false if the internal writer failed.
+bool gci_writer_compress_parallel_flush(struct GciWriterCompressParallel *context);
+
+// Flushes and ends the stream, nothing may be written afterwards. Returns
+// false if the internal writer failed.
+bool gci_writer_compress_parallel_finish(struct GciWriterCompressParallel *context);
+
+// Flushes and stops the workers, the stream is only ended by
+// `gci_writer_compress_parallel_finish`. Returns false if the internal
+// writer failed.
+bool gci_writer_compress_parallel_deinit(struct GciWriterCompressParallel *context);
+
+// A reader that decompresses a stream made by `struct GciWriterCompress`
+// a block at a time. A malformed or truncated stream is reported as a short
+// read without reaching eof.
+struct GciReaderDecompress {
+    struct GciInterfaceReader reader;
+    char *buffer;
+    size_t buffer_size;
+    char *input;
+    size_t input_size;
+    size_t block_size;
+    size_t current;
+    size_t length;
+    bool started;
+    bool eof;
+    bool error;
+};
+
+// Initializes a `struct GciReaderDecompress`.
+//
+// Params:
+//  context:        Single item pointer to `struct GciReaderDecompress`.
+//  reader:         Valid reader struct, owned by `context` if call succeeds.
+//  buffer:         Pointer to at least as many items as specified by
+//                  `buffer_size`, owned by `context` if call succeeds. Must
+//                  hold two blocks of the stream being read.
+//  buffer_size:    Specifies at most how many items `buffer` points to.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `buffer` is null.
+//  GCI_ERROR_BUFFER:   `buffer_size` is less than `2 * GCI_COMPRESS_BLOCK_MIN`.
+enum GciError gci_reader_decompress_init(
+    struct GciReaderDecompress *context,
+    struct GciInterfaceReader reader,
+    char *buffer,
+    size_t buffer_size
+);
+
+// Makes a reader interface from an already initialized `struct GciReaderDecompress`
+// the returned reader owns the passed in `context`.
+struct GciInterfaceReader gci_reader_decompress_interface(struct GciReaderDecompress *context);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef GCI_COPY_H
+#define GCI_COPY_H
+#include <stddef.h>
+#include <gci_interface_reader.h>
+#include <gci_interface_writer.h>
+
+#define GCI_COPY_BUFFER_SIZE 16384
+
+// Copies everything left in `reader` to `writer`. Picks the cheapest way
+// available, in order:
+//
+//  1. If `reader` is a `struct GciReaderFd` and `writer` a `struct GciWriterFd`
+//     or `struct GciWriterFile` the kernel copies the data with
+//     `copy_file_range(2)`, `splice(2)` or `sendfile(2)` (Linux only).
+//  2. If `reader` implements `peek` its bytes are written straight from the
+//     view it borrows.
+//  3. Otherwise the data is read into memory reserved in `writer` if it
+//     implements `reserve`, or into `buffer`.
+//
+// Params:
+//  reader:         A reader interface.
+//  writer:         A writer interface.
+//  buffer:         Scratch buffer for the buffered copy, may be null in which
+//                  case `GCI_COPY_BUFFER_SIZE` bytes of stack are used.
+//  buffer_size:    The length of `buffer` in bytes.
+//
+// Returns:
+//  The amount of bytes written to `writer`. The copy completed if `reader`
+//  is at eof afterwards, otherwise reading or writing failed.
+size_t gci_copy(
+    struct GciInterfaceReader reader,
+    struct GciInterfaceWriter writer,
+    char *buffer,
+    size_t buffer_size
+);
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef GCI_DIRECT_H
+#define GCI_DIRECT_H
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <gci_common.h>
+#include <gci_interface_writer.h>
+
+// A writer for large sequential output which bypasses the page cache. The
+// file descriptor is switched to `O_DIRECT` and the buffer is split in two
+// halves, a background thread writes one full half while the other fills.
+// Every write but the last is a whole amount of blocks from an aligned
+// address at an aligned offset. The unaligned tail is written on deinit
+// after `O_DIRECT` has been cleared again.
+//
+// If the descriptor cannot be switched to `O_DIRECT`, e.g. because the file
+// system does not support it, the writer still works but `direct` is false
+// and writes go through the page cache.
+//
+// Must not be moved after a successful `gci_writer_direct_init` and must be
+// released with `gci_writer_direct_deinit`.
+struct GciWriterDirect {
+    int fd;
+    int flags;
+    char *buffer;
+    size_t block_size;
+    size_t half_size;
+    size_t lengths[2];
+    size_t producer_half;
+    size_t consumer_half;
+    size_t current;
+    bool holding;
+    bool closing;
+    bool error;
+    bool direct;
+    sem_t filled;
+    sem_t free;
+    pthread_t thread;
+};
+
+// Initializes a `struct GciWriterDirect` and starts its background thread.
+//
+// Params:
+//  context:        Single item pointer to `struct GciWriterDirect`.
+//  fd:             File descriptor opened for writing, its offset must be a
+//                  multiple of `block_size`. Not closed by the writer.
+//  buffer:         Pointer to at least as many items as specified by
+//                  `buffer_size` aligned to `block_size`, owned by `context`
+//                  if call succeeds.
+//  buffer_size:    Specifies at most how many items `buffer` points to.
+//  block_size:     Alignment required by the device, usually the page size.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `buffer` is null.
+//  GCI_ERROR_BUFFER:   Returned in the following situations:
+//      1. `block_size` is zero.
+//      2. `buffer` is not aligned to `block_size`.
+//      3. `buffer_size` is not a non-zero multiple of two blocks.
+//      4. The offset of `fd` is not a multiple of `block_size`.
+//  GCI_ERROR_IO:       Returned in the following situations:
+//      1. The offset or flags of `fd` could not be read.
+//      2. The background thread could not be started.
+enum GciError gci_writer_direct_init(
+    struct GciWriterDirect *context,
+    int fd,
+    char *buffer,
+    size_t buffer_size,
+    size_t block_size
+);
+
+// Makes a writer interface from an already initialized `struct GciWriterDirect`
+// the returned writer owns the passed in `context`.
+struct GciInterfaceWriter gci_writer_direct_interface(struct GciWriterDirect *context);
+
+// Waits until every full half has been written, bytes of the last partial
+// block stay buffered until deinit. Returns false if any write has failed.
+bool gci_writer_direct_flush(struct GciWriterDirect *context);
+
+// Writes everything still buffered including the unaligned tail, stops the
+// background thread and restores the flags of the file descriptor. Returns
+// false if any write has failed.
+bool gci_writer_direct_deinit(struct GciWriterDirect *context);
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef GCI_ENCODE_H
+#define GCI_ENCODE_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <gci_common.h>
+#include <gci_simd.h>
+#include <gci_interface_reader.h>
+#include <gci_interface_writer.h>
+
+enum GciEncoding {
+    GCI_ENCODING_HEX    = 1,
+    GCI_ENCODING_BASE64 = 2,
+};
+
+// Encodes `data` as padded base64 with the standard alphabet into `output`,
+// which must hold at least `4 * ((data_size + 2) / 3)` bytes. Returns the
+// amount of bytes written. Like the other functions below it uses the best
+// kernel the running cpu supports.
+size_t gci_base64_encode(char *output, char const *data, size_t data_size);
+
+// Decodes base64 into `output`, which must hold at least `data_size / 4 * 3`
+// bytes, and sets `output_size` to the amount of bytes written. Padding may
+// only occur in the last group. Returns false if `data_size` is not a
+// multiple of four or `data` is not valid base64.
+bool gci_base64_decode(char *output, size_t *output_size, char const *data, size_t data_size);
+
+// Encodes `data` as lowercase hexadecimal into `output`, which must hold
+// `2 * data_size` bytes. Returns the amount of bytes written.
+size_t gci_hex_encode(char *output, char const *data, size_t data_size);
+
+// Decodes hexadecimal of either case into `output`, which must hold
+// `data_size / 2` bytes. Returns false if `data_size` is odd or `data` is not
+// valid hexadecimal.
+bool gci_hex_decode(char *output, char const *data, size_t data_size);
+
+// Returns the length of the longest prefix of `data` made of complete and
+// valid UTF-8 sequences. `incomplete` is set if the rest of `data` is the
+// start of a valid sequence which is cut off, so `data` is valid if the
+// result is `data_size` or `incomplete` is set and more bytes follow.
+size_t gci_utf8_validate(char const *data, size_t data_size, bool *incomplete);
+
+// Like the functions above but use the kernels of `simd`, or of the best
+// supported level if `simd` is not supported.
+size_t gci_base64_encode_simd(enum GciSimd simd, char *output, char const *data, size_t data_size);
+bool gci_base64_decode_simd(enum GciSimd simd, char *output, size_t *output_size, char const *data, size_t data_size);
+size_t gci_hex_encode_simd(enum GciSimd simd, char *output, char const *data, size_t data_size);
+bool gci_hex_decode_simd(enum GciSimd simd, char *output, char const *data, size_t data_size);
+size_t gci_utf8_validate_simd(enum GciSimd simd, char const *data, size_t data_size, bool *incomplete);
+
+// A writer that encodes everything written to it before writing it to an
+// internal writer. Encoded bytes are written straight into memory reserved
+// from the internal writer if it implements `reserve`. Base64 is encoded in
+// groups of three bytes, the last partial group is padded and written by
+// `gci_writer_encode_finish`.
+struct GciWriterEncode {
+    struct GciInterfaceWriter writer;
+    enum GciEncoding encoding;
+    char pending[3];
+    size_t pending_size;
+};
+
+// Initializes a `struct GciWriterEncode`.
+//
+// Params:
+//  context:    Single item pointer to `struct GciWriterEncode`.
+//  writer:     Valid write struct, owned by `context` if call succeeds.
+//  encoding:   Encoding of the written bytes.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     `context` is null.
+//  GCI_ERROR_BUFFER:   `encoding` is not an `enum GciEncoding`.
+enum GciError gci_writer_encode_init(struct GciWriterEncode *context, struct GciInterfaceWriter writer, enum GciEncoding encoding);
+
+// Makes a writer interface from an already initialized `struct GciWriterEncode`
+// the returned writer owns the passed in `context`.
+struct GciInterfaceWriter gci_writer_encode_interface(struct GciWriterEncode *context);
+
+// Writes the last partial group with padding, nothing may be written
+// afterwards. Returns false if the internal writer failed.
+bool gci_writer_encode_finish(struct GciWriterEncode *context);
+
+// A reader that decodes the bytes read from an internal reader. Once invalid
+// data is seen a read returns the bytes decoded before it and every later
+// read fails, `eof` is then false. Data which ends in the middle of a group
+// or continues after base64 padding is invalid.
+struct GciReaderDecode {
+    struct GciInterfaceReader reader;
+    enum GciEncoding encoding;
+    char *buffer;
+    size_t buffer_size;
+    size_t start;
+    size_t end;
+    char decoded[3];
+    size_t decoded_start;
+    size_t decoded_end;
+    bool padded;
+    bool error;
+};
+
+// Initializes a `struct GciReaderDecode`.
+//
+// Params:
+//  context:        Single item pointer to `struct GciReaderDecode`.
+//  reader:         Valid reader struct, owned by `context` if call succeeds.
+//  encoding:       Encoding of the bytes read from `reader`.
+//  buffer:         Pointer to at least as many items as specified by
+//                  `buffer_size`, holds encoded bytes until they are decoded.
+//  buffer_size:    Specifies at most how many items `buffer` points to.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `buffer` is null.
+//  GCI_ERROR_BUFFER:   Returned in the following situations:
+//      1. `encoding` is not an `enum GciEncoding`.
+//      2. `buffer_size` < 4.
+enum GciError gci_reader_decode_init(
+    struct GciReaderDecode *context,
+    struct GciInterfaceReader reader,
+    enum GciEncoding encoding,
+    char *buffer,
+    size_t buffer_size
+);
+
+// Makes a reader interface from an already initialized `struct GciReaderDecode`
+// the returned reader owns the passed in `context`.
+struct GciInterfaceReader gci_reader_decode_interface(struct GciReaderDecode *context);
+
+// A reader that forwards reads to an internal reader and validates that the
+// bytes are UTF-8. Once invalid data is seen a read returns the valid bytes
+// before it and every later read fails, `eof` is then false. A sequence cut
+// off by the end of a read is held back until the bytes completing it have
+// been read and checked, data which ends in the middle of a sequence is
+// invalid.
+struct GciReaderUtf8 {
+    struct GciInterfaceReader reader;
+    char pending[4];
+    size_t pending_size;
+    bool pending_checked;
+    bool error;
+};
+
+// Initializes a `struct GciReaderUtf8`.
+//
+// Params:
+//  context:    Single item pointer to `struct GciReaderUtf8`.
+//  reader:     Valid reader struct, owned by `context` if call succeeds.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     `context` is null.
+enum GciError gci_reader_utf8_init(struct GciReaderUtf8 *context, struct GciInterfaceReader reader);
+
+// Makes a reader interface from an already initialized `struct GciReaderUtf8`
+// the returned reader owns the passed in `context`.
+struct GciInterfaceReader gci_reader_utf8_interface(struct GciReaderUtf8 *context);
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef GCI_FD_H
+#define GCI_FD_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <gci_common.h>
+#include <gci_interface_reader.h>
+#include <gci_interface_writer.h>
+
+// POSIX only, readers and writers of a file descriptor.
+
+// Reads from a file descriptor, `read_at` reads with `pread` and leaves the
+// file offset alone.
+struct GciReaderFd {
+    int fd;
+    bool eof;
+};
+
+enum GciError gci_reader_fd_init(struct GciReaderFd *context, int fd);
+struct GciInterfaceReader gci_reader_fd_interface(struct GciReaderFd *context);
+
+enum GciReaderMmapAccess {
+    GCI_READER_MMAP_SEQUENTIAL  = 0,
+    GCI_READER_MMAP_RANDOM      = 1,
+};
+
+// Reads a file through a window of `window_size` bytes mapped into memory,
+// the window slides forward as it is consumed and the previous one is
+// unmapped. A `window_size` of zero maps the whole file at once.
+struct GciReaderMmap {
+    int fd;
+    enum GciReaderMmapAccess access;
+    char *window;
+    size_t window_size;
+    size_t window_length;
+    uint64_t window_offset;
+    uint64_t file_size;
+    size_t current;
+    bool eof;
+};
+
+enum GciError gci_reader_mmap_init(
+    struct GciReaderMmap *context,
+    int fd,
+    size_t window_size,
+    enum GciReaderMmapAccess access
+);
+void gci_reader_mmap_deinit(struct GciReaderMmap *context);
+struct GciInterfaceReader gci_reader_mmap_interface(struct GciReaderMmap *context);
+
+// A writer that writes directly to a file descriptor with `write(2)`,
+// bypassing stdio. Use `gci_writer_fd_init` to initialize.
+struct GciWriterFd {
+    int fd;
+};
+
+// Initializes a `struct GciWriterFd`.
+//
+// Params:
+//  context:    Single item pointer to `struct GciWriterFd`.
+//  fd:         Open file descriptor, if call succeeds owned by `writer`.
+//
+// Return:
+//  GCI_ERROR_OK: Call succeeded
+//  GCI_ERROR_NULL: Returned in the following situations:
+//      1. `context` is null.
+//      2. `fd` is negative.
+enum GciError gci_writer_fd_init(struct GciWriterFd *context, int fd);
+
+// Makes a writer interface from an already initialized `struct GciWriterFd`
+// the returned writer owns the passed in `context`.
+struct GciInterfaceWriter gci_writer_fd_interface(struct GciWriterFd *context);
+
+#endif
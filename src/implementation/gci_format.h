@@ -0,0 +1,35 @@
+#ifndef GCI_FORMAT_H
+#define GCI_FORMAT_H
+#include <stdbool.h>
+#include <stdint.h>
+#include <gci_interface_writer.h>
+
+// The most bytes any of the formatting functions below write.
+#define GCI_FORMAT_MAX 32
+
+// Formats `value` in decimal into `output`, which must hold at least
+// `GCI_FORMAT_MAX` bytes, and returns the amount of bytes written. No
+// terminating null byte is written and the locale is never consulted.
+size_t gci_format_u64(char *output, uint64_t value);
+size_t gci_format_i64(char *output, int64_t value);
+
+// Formats `value` in lowercase hexadecimal without a prefix or leading
+// zeros, see `gci_format_u64`.
+size_t gci_format_hex(char *output, uint64_t value);
+
+// Formats `value` with the fewest significant digits which parse back to
+// exactly `value`, see `gci_format_u64`. Numbers with a decimal exponent
+// in [-6, 21) are written as plain decimals, e.g. "0.001" or "1500", others
+// in scientific notation, e.g. "1e+21" or "2.5e-7". Infinities and NaN are
+// written as "inf", "-inf" and "nan".
+size_t gci_format_f64(char *output, double value);
+
+// Formats a value straight into memory reserved from `writer`, or a stack
+// buffer if the writer does not implement `reserve`, and commits it. Returns
+// false if the writer failed.
+bool gci_write_u64(struct GciInterfaceWriter writer, uint64_t value);
+bool gci_write_i64(struct GciInterfaceWriter writer, int64_t value);
+bool gci_write_hex(struct GciInterfaceWriter writer, uint64_t value);
+bool gci_write_f64(struct GciInterfaceWriter writer, double value);
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef GCI_POOL_H
+#define GCI_POOL_H
+#include <pthread.h>
+#include <stdbool.h>
+#include <gci_common.h>
+#include <gci_interface_allocator.h>
+#include <gci_interface_reader.h>
+#include <gci_interface_writer.h>
+#include <gci_reader.h>
+#include <gci_writer.h>
+
+// Size the memory of a pool is rounded up to when huge pages are requested.
+#define GCI_POOL_HUGE_PAGE_SIZE ((size_t) 2 << 20)
+
+enum GciPoolPages {
+    GCI_POOL_PAGES_NORMAL   = 0,
+    GCI_POOL_PAGES_HUGE     = 1,
+};
+
+// The free buffers kept by one thread, linked into the list of caches of
+// its pool so they can be released together with the pool.
+struct GciPoolCache {
+    struct GciPool *pool;
+    char *head;
+    size_t count;
+    struct GciPoolCache *previous;
+    struct GciPoolCache *next;
+};
+
+// A fixed amount of page aligned buffers of equal size carved out of one
+// mapping, shared between any amount of threads. Free buffers are kept in a
+// shared list and each thread keeps up to `cache_size` of them in a cache of
+// its own, so most acquires and releases never take the lock. Buffers in the
+// cache of one thread are not available to others, so a pool should hold
+// more buffers than its threads check out at once.
+//
+// With huge pages the mapping is first requested from the huge page pool
+// (`MAP_HUGETLB`) and otherwise advised to be backed by transparent huge
+// pages, `huge` is set if the former succeeded.
+//
+// Must not be moved after a successful `gci_pool_init` and must be released
+// with `gci_pool_deinit`.
+struct GciPool {
+    struct GciInterfaceAllocator allocator;
+    char *region;
+    size_t region_size;
+    char *memory;
+    size_t buffer_size;
+    size_t buffer_count;
+    size_t cache_size;
+    bool mapped;
+    bool huge;
+    char *head;
+    size_t count;
+    struct GciPoolCache *caches;
+    pthread_mutex_t mutex;
+    pthread_key_t key;
+};
+
+// Initializes a `struct GciPool`.
+//
+// Params:
+//  context:        Single item pointer to `struct GciPool`.
+//  allocator:      Valid allocator struct, used for the thread caches and for
+//                  the buffers on systems without anonymous mappings. Used
+//                  until `gci_pool_deinit`.
+//  buffer_size:    Least amount of bytes in each buffer, rounded up to a
+//                  multiple of the page size.
+//  buffer_count:   Amount of buffers in the pool.
+//  cache_size:     Most buffers each thread keeps for itself, zero to always
+//                  use the shared list.
+//  pages:          Kind of pages backing the buffers.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     `context` is null.
+//  GCI_ERROR_BUFFER:   Returned in the following situations:
+//      1. `buffer_size` or `buffer_count` is zero.
+//      2. The buffers could not be allocated.
+//  GCI_ERROR_IO:       The lock or thread cache key could not be created.
+enum GciError gci_pool_init(
+    struct GciPool *context,
+    struct GciInterfaceAllocator allocator,
+    size_t buffer_size,
+    size_t buffer_count,
+    size_t cache_size,
+    enum GciPoolPages pages
+);
+
+// Releases the buffers and every thread cache. No other thread may use the
+// pool during or after this call, buffers which are still checked out are
+// no longer valid.
+void gci_pool_deinit(struct GciPool *context);
+
+// Checks out a buffer of `buffer_size` bytes, null if no free buffer is
+// left. May be called from several threads at once.
+char *gci_pool_acquire(struct GciPool *context);
+
+// Returns the buffer `pointer` points into to the pool. May be called from
+// several threads at once, not necessarily the one which acquired it.
+void gci_pool_release(struct GciPool *context, char *pointer);
+
+// Initializes a `struct GciReaderBuffer` like `gci_reader_buffer_init` or
+// `gci_reader_double_buffer_init` with a buffer checked out from `pool`. The
+// buffer is returned with `gci_reader_buffer_deinit_pooled`.
+//
+// Params:
+//  context:        Single item pointer to `struct GciReaderBuffer`.
+//  reader:         Valid reader struct, owned by `context` if call succeeds.
+//  pool:           Initialized pool, must outlive `context`.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `pool` is null.
+//  GCI_ERROR_BUFFER:   The pool has no free buffer.
+enum GciError gci_reader_buffer_init_pooled(
+    struct GciReaderBuffer *context,
+    struct GciInterfaceReader reader,
+    struct GciPool *pool
+);
+enum GciError gci_reader_double_buffer_init_pooled(
+    struct GciReaderBuffer *context,
+    struct GciInterfaceReader reader,
+    struct GciPool *pool
+);
+
+// Returns the buffer of a reader initialized from `pool`.
+void gci_reader_buffer_deinit_pooled(struct GciReaderBuffer *context, struct GciPool *pool);
+
+// Initializes a `struct GciWriterBuffer` like `gci_writer_buffer_init` with
+// a buffer checked out from `pool`, see `gci_reader_buffer_init_pooled`. The
+// buffer is returned with `gci_writer_buffer_deinit_pooled`.
+enum GciError gci_writer_buffer_init_pooled(
+    struct GciWriterBuffer *context,
+    struct GciInterfaceWriter writer,
+    struct GciPool *pool
+);
+
+// Returns the buffer of a writer initialized from `pool`. Does not flush,
+// anything still buffered is lost.
+void gci_writer_buffer_deinit_pooled(struct GciWriterBuffer *context, struct GciPool *pool);
+
+#endif
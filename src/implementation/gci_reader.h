@@ -1,5 +1,6 @@
 #ifndef GCI_READER_H
 #define GCI_READER_H
+#include <stdint.h>
 #include <stdio.h>
 #include <gci_common.h>
 #include <gci_interface_reader.h>
@@ -59,4 +60,102 @@ enum GciError gci_reader_double_buffer_init(
 
 struct GciInterfaceReader gci_reader_buffer_interface(struct GciReaderBuffer *context);
 
+// Reads the bytes in [`start`, `end`) of a reader which implements
+// `read_at`. Every range reads its source with `read_at` only, so ranges of
+// the same source may be read from different threads at once. Its own
+// `read_at` takes offsets relative to `start`.
+struct GciReaderRange {
+    struct GciInterfaceReader reader;
+    uint64_t start;
+    uint64_t end;
+    uint64_t current;
+    bool eof;
+};
+
+// Initializes a `struct GciReaderRange`.
+//
+// Params:
+//  context:    Single item pointer to `struct GciReaderRange`.
+//  reader:     Valid reader struct which implements `read_at`.
+//  start:      Offset of the first byte of the range.
+//  end:        Offset one past the last byte of the range.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `reader` does not implement `read_at`.
+//  GCI_ERROR_BUFFER:   `start` is larger than `end`.
+enum GciError gci_reader_range_init(
+    struct GciReaderRange *context,
+    struct GciInterfaceReader reader,
+    uint64_t start,
+    uint64_t end
+);
+
+struct GciInterfaceReader gci_reader_range_interface(struct GciReaderRange *context);
+
+// Splits the first `size` bytes of a reader into `range_count` ranges of
+// about equal size, range `i` is [`bounds[i]`, `bounds[i + 1]`). Ranges may
+// be empty if records are longer than a range.
+//
+// Params:
+//  reader:         Valid reader struct which implements `read_at`, only
+//                  read if `delimited` is set.
+//  size:           The amount of bytes to split.
+//  range_count:    The amount of ranges.
+//  delimited:      Moves every bound forward to just after the next
+//                  `delimiter` so no record straddles two ranges.
+//  delimiter:      The byte ending each record.
+//  bounds:         Pointer to `range_count + 1` items.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `bounds` is null.
+//      2. `delimited` is set and `reader` does not implement `read_at`.
+//  GCI_ERROR_BUFFER:   `range_count` is zero.
+//  GCI_ERROR_IO:       `reader` ended before `size` bytes were read.
+enum GciError gci_reader_range_split(
+    struct GciInterfaceReader reader,
+    uint64_t size,
+    size_t range_count,
+    bool delimited,
+    char delimiter,
+    uint64_t *bounds
+);
+
+// Reads the next record ending with `delimiter`. Readers implementing `peek`
+// have their buffer scanned in place and a record which lies within it is
+// returned as a view into it, only a record straddling a refill is copied
+// into `spill`. Other readers are read a byte at a time into `spill`.
+//
+// Params:
+//  reader:     A reader interface.
+//  delimiter:  The byte ending each record.
+//  spill:      Buffer for records which cannot be returned as a view.
+//  spill_size: The length of `spill` in bytes.
+//  record:     Set to point at the record, valid until the next call to
+//              `read` or `peek` of the reader.
+//  length:     Set to the length of the record including its delimiter, the
+//              last record may lack a delimiter. Zero once nothing is left.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_BUFFER:   The record does not fit in `spill`, `record` holds its
+//                      first `spill_size` bytes and the rest is left unread.
+//                      A reader without `peek` cannot look past a full
+//                      `spill`, so a last record without a delimiter which
+//                      exactly fills it is also reported unless the reader
+//                      already knows it is at its end. The next call then
+//                      sets `length` to zero.
+enum GciError gci_reader_read_until(
+    struct GciInterfaceReader reader,
+    char delimiter,
+    char *spill,
+    size_t spill_size,
+    char const **record,
+    size_t *length
+);
+
 #endif
@@ -0,0 +1,80 @@
+#ifndef GCI_SHARED_H
+#define GCI_SHARED_H
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <gci_common.h>
+#include <gci_interface_writer.h>
+
+// The part of a shared writer common to every thread, each thread writes
+// through its own `struct GciWriterSharedBuffer`. Writes to the internal
+// writer are serialized by a lock which is only taken when a thread hands
+// over a full buffer, so records from different threads never interleave.
+//
+// Must not be moved after a successful `gci_writer_shared_init` and must be
+// released with `gci_writer_shared_deinit`.
+struct GciWriterShared {
+    struct GciInterfaceWriter writer;
+    bool error;
+    pthread_mutex_t mutex;
+};
+
+// Initializes a `struct GciWriterShared`.
+//
+// Params:
+//  context:    Single item pointer to `struct GciWriterShared`.
+//  writer:     Valid write struct, owned by `context` if call succeeds.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     `context` is null.
+//  GCI_ERROR_IO:       The lock could not be created.
+enum GciError gci_writer_shared_init(struct GciWriterShared *context, struct GciInterfaceWriter writer);
+
+// Releases the lock, every buffer should have been flushed.
+void gci_writer_shared_deinit(struct GciWriterShared *context);
+
+// The buffer of one thread writing to a `struct GciWriterShared`. Every
+// call to `write` or `writev` and every reservation is a record, which is
+// kept in the buffer until it is full and then appended to the internal
+// writer whole. Records larger than the buffer are written directly.
+struct GciWriterSharedBuffer {
+    struct GciWriterShared *shared;
+    char *buffer;
+    size_t buffer_size;
+    size_t current;
+};
+
+// Initializes a `struct GciWriterSharedBuffer`.
+//
+// Params:
+//  context:        Single item pointer to `struct GciWriterSharedBuffer`.
+//  shared:         Initialized shared writer, must outlive `context`.
+//  buffer:         Pointer to at least as many items as specified by
+//                  `buffer_size`, owned by `context` if call succeeds.
+//  buffer_size:    Specifies at most how many items `buffer` points to.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `shared` is null.
+//      3. `buffer` is null.
+//  GCI_ERROR_BUFFER:   `buffer_size` is zero.
+enum GciError gci_writer_shared_buffer_init(
+    struct GciWriterSharedBuffer *context,
+    struct GciWriterShared *shared,
+    char *buffer,
+    size_t buffer_size
+);
+
+// Makes a writer interface from an already initialized `struct GciWriterSharedBuffer`
+// the returned writer owns the passed in `context`.
+struct GciInterfaceWriter gci_writer_shared_buffer_interface(struct GciWriterSharedBuffer *context);
+
+// Appends the buffered records to the internal writer. Returns false if
+// any write to the internal writer has failed, the records then stay in the
+// buffer and every later write to any buffer of the shared writer fails.
+bool gci_writer_shared_buffer_flush(struct GciWriterSharedBuffer *context);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef GCI_SIMD_H
+#define GCI_SIMD_H
+#include <stddef.h>
+
+// Instruction set extensions used by the vectorized kernels, ordered so a
+// level implies support for every level below it.
+enum GciSimd {
+    GCI_SIMD_SCALAR = 0,
+    GCI_SIMD_SSE2   = 1,
+    GCI_SIMD_SSE42  = 2,
+    GCI_SIMD_AVX2   = 3,
+};
+
+// Returns the best level supported by the running cpu.
+enum GciSimd gci_simd_supported(void);
+
+// Returns a pointer to the first occurrence of `byte` in `data` or null if
+// it does not occur, using the best kernel the running cpu supports.
+char const *gci_find_byte(char const *data, size_t data_size, char byte);
+
+// Like `gci_find_byte` but uses the kernel of `simd`, or of the best
+// supported level if `simd` is not supported.
+char const *gci_find_byte_simd(enum GciSimd simd, char const *data, size_t data_size, char byte);
+
+#endif
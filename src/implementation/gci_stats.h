@@ -0,0 +1,71 @@
+#ifndef GCI_STATS_H
+#define GCI_STATS_H
+#include <stdbool.h>
+#include <stdint.h>
+#include <gci_common.h>
+#include <gci_interface_reader.h>
+#include <gci_interface_writer.h>
+
+#define GCI_STATS_BUCKETS 32
+
+// Counters kept by the stats wrappers.
+//
+//  calls:              Amount of calls into the wrapped interface.
+//  bytes:              Amount of bytes read or written.
+//  short_calls:        Calls which transferred less than asked for.
+//  eof_transitions:    Times the wrapped reader was seen reaching eof,
+//                      always zero for writers.
+//  latency:            Histogram of call durations, bucket `i` counts calls
+//                      which took [2^i, 2^(i + 1)) nanoseconds. The first
+//                      bucket also counts calls faster than a nanosecond and
+//                      the last every call slower than its lower bound.
+struct GciStats {
+    uint64_t calls;
+    uint64_t bytes;
+    uint64_t short_calls;
+    uint64_t eof_transitions;
+    uint64_t latency[GCI_STATS_BUCKETS];
+};
+
+// A reader that forwards every call to an internal reader and records
+// `struct GciStats` about them. The counters are updated atomically so
+// `gci_reader_stats_snapshot` may be called from another thread while the
+// reader is in use.
+struct GciReaderStats {
+    struct GciInterfaceReader reader;
+    struct GciStats stats;
+    bool eof;
+};
+
+enum GciError gci_reader_stats_init(struct GciReaderStats *context, struct GciInterfaceReader reader);
+struct GciInterfaceReader gci_reader_stats_interface(struct GciReaderStats *context);
+void gci_reader_stats_snapshot(struct GciReaderStats const *context, struct GciStats *snapshot);
+
+// A writer that forwards every call to an internal writer and records
+// `struct GciStats` about them, see `struct GciReaderStats`.
+struct GciWriterStats {
+    struct GciInterfaceWriter writer;
+    struct GciStats stats;
+};
+
+// Initializes a `struct GciWriterStats`.
+//
+// Params:
+//  context:    Single item pointer to `struct GciWriterStats`.
+//  writer:     Valid write struct, owned by `context` if call succeeds.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     `context` is null.
+enum GciError gci_writer_stats_init(struct GciWriterStats *context, struct GciInterfaceWriter writer);
+
+// Makes a writer interface from an already initialized `struct GciWriterStats`
+// the returned writer owns the passed in `context`. The interface implements
+// the optional functions the internal writer implements.
+struct GciInterfaceWriter gci_writer_stats_interface(struct GciWriterStats *context);
+
+// Copies the current counters of `context` into `snapshot`, each counter is
+// read atomically but the counters are not read as one unit.
+void gci_writer_stats_snapshot(struct GciWriterStats const *context, struct GciStats *snapshot);
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef GCI_URING_H
+#define GCI_URING_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <gci_common.h>
+#include <gci_interface_reader.h>
+#include <gci_interface_writer.h>
+
+// Linux only, io_uring based readers and writers of a seekable file descriptor.
+
+#define GCI_URING_BLOCKS_MAX 32
+
+// The submission and completion rings shared with the kernel.
+struct GciUring {
+    int fd;
+    unsigned sq_entries;
+    unsigned pending;
+    void *sq_ring;
+    size_t sq_ring_size;
+    void *cq_ring;
+    size_t cq_ring_size;
+    void *sqes;
+    size_t sqes_size;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_array;
+    unsigned sq_mask;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    void *cqes;
+};
+
+enum GciUringState {
+    GCI_URING_IDLE      = 0,
+    GCI_URING_BUSY      = 1,
+    GCI_URING_DONE      = 2,
+    GCI_URING_FAILED    = 3,
+};
+
+// Reads a file with up to `block_count` reads in flight, each filling one
+// block of `buffer`. Reading starts at the current offset of `fd`, which is
+// moved to the end of what was consumed by `gci_reader_uring_deinit`.
+struct GciReaderUring {
+    struct GciUring ring;
+    int fd;
+    char *buffer;
+    size_t block_size;
+    size_t block_count;
+    size_t lengths[GCI_URING_BLOCKS_MAX];
+    uint64_t offsets[GCI_URING_BLOCKS_MAX];
+    enum GciUringState states[GCI_URING_BLOCKS_MAX];
+    uint64_t next_offset;
+    size_t head;
+    size_t current;
+    bool fixed;
+    bool eof;
+};
+
+// Initializes a `struct GciReaderUring` and submits a read for every block.
+//
+// Params:
+//  context:        Single item pointer to `struct GciReaderUring`.
+//  fd:             Seekable file descriptor, not closed by the reader.
+//  buffer:         Pointer to at least as many items as specified by
+//                  `buffer_size`, owned by `reader` if call succeeds.
+//  buffer_size:    Specifies at most how many items `buffer` points to.
+//  block_count:    Amount of equally sized blocks `buffer` is split into.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `buffer` is null.
+//      3. `fd` is negative.
+//  GCI_ERROR_BUFFER:   Returned in the following situations:
+//      1. `block_count` is zero or larger than `GCI_URING_BLOCKS_MAX`.
+//      2. `buffer_size` is not a non-zero multiple of `block_count`.
+//      3. A block is larger than `UINT32_MAX` bytes.
+//  GCI_ERROR_IO:       The ring could not be set up or `fd` is not seekable.
+enum GciError gci_reader_uring_init(
+    struct GciReaderUring *context,
+    int fd,
+    char *buffer,
+    size_t buffer_size,
+    size_t block_count
+);
+
+// Waits for every read in flight, moves the offset of `fd` to the end of
+// what was consumed and tears down the ring.
+void gci_reader_uring_deinit(struct GciReaderUring *context);
+
+// Makes a reader interface from an already initialized `struct GciReaderUring`
+// the returned reader owns the passed in `context`.
+struct GciInterfaceReader gci_reader_uring_interface(struct GciReaderUring *context);
+
+// Writes a file with up to `block_count` writes in flight, each writing one
+// filled block of `buffer`. Writing starts at the current offset of `fd`,
+// which is moved to the end of what was written by `gci_writer_uring_deinit`.
+struct GciWriterUring {
+    struct GciUring ring;
+    int fd;
+    char *buffer;
+    size_t block_size;
+    size_t block_count;
+    size_t lengths[GCI_URING_BLOCKS_MAX];
+    size_t written[GCI_URING_BLOCKS_MAX];
+    uint64_t offsets[GCI_URING_BLOCKS_MAX];
+    enum GciUringState states[GCI_URING_BLOCKS_MAX];
+    uint64_t next_offset;
+    size_t head;
+    bool fixed;
+    bool error;
+};
+
+// Initializes a `struct GciWriterUring`.
+//
+// Params:
+//  context:        Single item pointer to `struct GciWriterUring`.
+//  fd:             Seekable file descriptor, not closed by the writer.
+//  buffer:         Pointer to at least as many items as specified by
+//                  `buffer_size`, owned by `writer` if call succeeds.
+//  buffer_size:    Specifies at most how many items `buffer` points to.
+//  block_count:    Amount of equally sized blocks `buffer` is split into.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `buffer` is null.
+//      3. `fd` is negative.
+//  GCI_ERROR_BUFFER:   Returned in the following situations:
+//      1. `block_count` is zero or larger than `GCI_URING_BLOCKS_MAX`.
+//      2. `buffer_size` is not a non-zero multiple of `block_count`.
+//      3. A block is larger than `UINT32_MAX` bytes.
+//  GCI_ERROR_IO:       The ring could not be set up or `fd` is not seekable.
+enum GciError gci_writer_uring_init(
+    struct GciWriterUring *context,
+    int fd,
+    char *buffer,
+    size_t buffer_size,
+    size_t block_count
+);
+
+// Makes a writer interface from an already initialized `struct GciWriterUring`
+// the returned writer owns the passed in `context`.
+struct GciInterfaceWriter gci_writer_uring_interface(struct GciWriterUring *context);
+
+// Submits the partially filled block and waits for every write in flight.
+// Returns false if any write has failed.
+bool gci_writer_uring_flush(struct GciWriterUring *context);
+
+// Flushes and tears down the ring. Returns false if any write has failed.
+bool gci_writer_uring_deinit(struct GciWriterUring *context);
+
+#endif
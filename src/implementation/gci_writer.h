@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <gci_common.h>
+#include <gci_interface_allocator.h>
 #include <gci_interface_writer.h>
 
 // A writer that writes to a file, use `gci_writer_file` to initialize.
@@ -61,6 +62,146 @@ size_t gci_writer_string_start(struct GciWriterString *context);
 // Guaranteed to be valid pointer into the `buffer` owned by `context`.
 enum GciError gci_writer_string_end(struct GciWriterString *context, size_t start, char **string, size_t *length);
 
+// A writer that writes to a contiguous buffer obtained from an allocator,
+// the buffer grows geometrically when it is full. Writes only fail if the
+// allocator cannot provide a larger buffer.
+struct GciWriterGrowable {
+    struct GciInterfaceAllocator allocator;
+    char *buffer;
+    size_t buffer_size;
+    size_t current;
+};
+
+// Initializes a `struct GciWriterGrowable`.
+//
+// Params:
+//  context:        Single item pointer to `struct GciWriterGrowable`.
+//  allocator:      Valid allocator struct, used until `gci_writer_growable_deinit`.
+//  initial_size:   Size of the first buffer, zero defers the first allocation
+//                  to the first write.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     `context` is null.
+//  GCI_ERROR_BUFFER:   The first buffer could not be allocated.
+enum GciError gci_writer_growable_init(
+    struct GciWriterGrowable *context,
+    struct GciInterfaceAllocator allocator,
+    size_t initial_size
+);
+
+// Returns the buffer to the allocator.
+void gci_writer_growable_deinit(struct GciWriterGrowable *context);
+
+// Makes a writer interface from an already initialized `struct GciWriterGrowable`
+// the returned writer owns the passed in `context`.
+struct GciInterfaceWriter gci_writer_growable_interface(struct GciWriterGrowable *context);
+
+// Forgets everything written while keeping the buffer for reuse.
+void gci_writer_growable_reset(struct GciWriterGrowable *context);
+
+// Returns the start of a string in the writer
+size_t gci_writer_growable_start(struct GciWriterGrowable *context);
+
+// Given the start of a string returns a sized string in `string` and `length`.
+// The string is invalidated by the next write since the buffer may move.
+enum GciError gci_writer_growable_end(struct GciWriterGrowable *context, size_t start, char **string, size_t *length);
+
+// A chunk of a `struct GciWriterRope`.
+struct GciWriterRopeChunk {
+    struct GciWriterRopeChunk *next;
+    size_t length;
+    char data[];
+};
+
+// A writer that stores everything written as a list of equally sized chunks
+// from an allocator, written data is never moved. The contents are written
+// out by `gci_writer_rope_drain` with a single vectored write per batch of
+// chunks. Drained chunks are kept for reuse until `gci_writer_rope_deinit`.
+struct GciWriterRope {
+    struct GciInterfaceAllocator allocator;
+    size_t chunk_size;
+    struct GciWriterRopeChunk *head;
+    struct GciWriterRopeChunk *tail;
+    struct GciWriterRopeChunk *spare;
+    size_t head_offset;
+    size_t length;
+};
+
+// Initializes a `struct GciWriterRope`.
+//
+// Params:
+//  context:        Single item pointer to `struct GciWriterRope`.
+//  allocator:      Valid allocator struct, used until `gci_writer_rope_deinit`.
+//  chunk_size:     Amount of bytes stored in each chunk.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     `context` is null.
+//  GCI_ERROR_BUFFER:   `chunk_size` is zero.
+enum GciError gci_writer_rope_init(
+    struct GciWriterRope *context,
+    struct GciInterfaceAllocator allocator,
+    size_t chunk_size
+);
+
+// Returns every chunk to the allocator.
+void gci_writer_rope_deinit(struct GciWriterRope *context);
+
+// Makes a writer interface from an already initialized `struct GciWriterRope`
+// the returned writer owns the passed in `context`.
+struct GciInterfaceWriter gci_writer_rope_interface(struct GciWriterRope *context);
+
+// Returns the amount of bytes stored in the rope.
+size_t gci_writer_rope_length(struct GciWriterRope const *context);
+
+// Fills `vectors` with the first pieces of the contents of the rope.
+//
+// Params:
+//  context:        Single item pointer to `struct GciWriterRope`.
+//  vectors:        Pointer to at least `vector_count` items.
+//  vector_count:   Specifies at most how many items `vectors` points to.
+//
+// Returns:
+//  The amount of items of `vectors` that were filled.
+size_t gci_writer_rope_segments(struct GciWriterRope const *context, struct GciIovec *vectors, size_t vector_count);
+
+// Writes the whole contents of the rope to `writer` and empties it, whatever
+// was written stays removed from the rope on failure.
+// Returns true if the call succeded and false if call failed.
+bool gci_writer_rope_drain(struct GciWriterRope *context, struct GciInterfaceWriter writer);
+
+// Empties the rope without writing its contents anywhere.
+void gci_writer_rope_reset(struct GciWriterRope *context);
+
+// A writer that duplicates everything written to two internal writers. The
+// second writer is given what the first one wrote, so after a short write
+// both have written the same bytes.
+struct GciWriterTee {
+    struct GciInterfaceWriter first;
+    struct GciInterfaceWriter second;
+};
+
+// Initializes a `struct GciWriterTee`.
+//
+// Params:
+//  context:    Single item pointer to `struct GciWriterTee`.
+//  first:      Valid write struct, owned by `context` if call succeeds.
+//  second:     Valid write struct, owned by `context` if call succeeds.
+//
+// Return:
+//  GCI_ERROR_OK:       Call succeeded.
+//  GCI_ERROR_NULL:     `context` is null.
+enum GciError gci_writer_tee_init(
+    struct GciWriterTee *context,
+    struct GciInterfaceWriter first,
+    struct GciInterfaceWriter second
+);
+
+// Makes a writer interface from an already initialized `struct GciWriterTee`
+// the returned writer owns the passed in `context`.
+struct GciInterfaceWriter gci_writer_tee_interface(struct GciWriterTee *context);
+
 // A writer that buffers any calls to an internal writer.
 struct GciWriterBuffer {
     struct GciInterfaceWriter writer;
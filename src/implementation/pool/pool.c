@@ -0,0 +1,377 @@
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <sys/mman.h>
+#else
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#endif
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <gci_pool.h>
+
+bool gci_pool_map(struct GciPool *context, size_t size, size_t page_size, enum GciPoolPages pages);
+void gci_pool_unmap(struct GciPool *context);
+char *gci_pool_next(char const *buffer);
+void gci_pool_link(char *buffer, char *next);
+struct GciPoolCache *gci_pool_cache(struct GciPool *context);
+void gci_pool_cache_destroy(void *cache);
+void gci_pool_cache_drain(struct GciPoolCache *cache, size_t keep);
+
+enum GciError gci_pool_init(
+    struct GciPool *context,
+    struct GciInterfaceAllocator allocator,
+    size_t buffer_size,
+    size_t buffer_count,
+    size_t cache_size,
+    enum GciPoolPages pages
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (buffer_size == 0 || buffer_count == 0) { return GCI_ERROR_BUFFER; }
+
+    long system_page_size = sysconf(_SC_PAGESIZE);
+    size_t page_size = system_page_size > 0 ? (size_t) system_page_size : 4096;
+
+    if (buffer_size > SIZE_MAX - page_size) { return GCI_ERROR_BUFFER; }
+    buffer_size = (buffer_size + page_size - 1) / page_size * page_size;
+    if (buffer_count > SIZE_MAX / buffer_size) { return GCI_ERROR_BUFFER; }
+
+    context->allocator = allocator;
+    context->buffer_size = buffer_size;
+    context->buffer_count = buffer_count;
+    context->cache_size = cache_size;
+    context->huge = false;
+    context->caches = NULL;
+
+    if (pthread_mutex_init(&context->mutex, NULL) != 0) {
+        return GCI_ERROR_IO;
+    }
+    if (pthread_key_create(&context->key, gci_pool_cache_destroy) != 0) {
+        pthread_mutex_destroy(&context->mutex);
+        return GCI_ERROR_IO;
+    }
+
+    if (!gci_pool_map(context, buffer_size * buffer_count, page_size, pages)) {
+        pthread_key_delete(context->key);
+        pthread_mutex_destroy(&context->mutex);
+        return GCI_ERROR_BUFFER;
+    }
+
+    context->head = NULL;
+    for (size_t index = buffer_count; index > 0; index--) {
+        char *buffer = context->memory + (index - 1) * buffer_size;
+        gci_pool_link(buffer, context->head);
+        context->head = buffer;
+    }
+    context->count = buffer_count;
+
+    return GCI_ERROR_OK;
+}
+
+void gci_pool_deinit(struct GciPool *context) {
+    assert(context != NULL);
+
+    pthread_key_delete(context->key);
+
+    struct GciPoolCache *cache = context->caches;
+    while (cache != NULL) {
+        struct GciPoolCache *next = cache->next;
+        gci_allocator_free(context->allocator, cache, sizeof(struct GciPoolCache));
+        cache = next;
+    }
+    context->caches = NULL;
+
+    gci_pool_unmap(context);
+    pthread_mutex_destroy(&context->mutex);
+}
+
+bool gci_pool_map(struct GciPool *context, size_t size, size_t page_size, enum GciPoolPages pages) {
+    assert(context != NULL);
+    assert(size > 0);
+
+#ifdef __linux__
+    (void) page_size;
+    context->mapped = true;
+
+    if (pages == GCI_POOL_PAGES_HUGE && size <= SIZE_MAX - GCI_POOL_HUGE_PAGE_SIZE) {
+        size_t huge_size = (size + GCI_POOL_HUGE_PAGE_SIZE - 1) / GCI_POOL_HUGE_PAGE_SIZE * GCI_POOL_HUGE_PAGE_SIZE;
+        void *region = mmap(NULL, huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (region != MAP_FAILED) {
+            context->region = region;
+            context->region_size = huge_size;
+            context->memory = region;
+            context->huge = true;
+            return true;
+        }
+    }
+
+    void *region = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        return false;
+    }
+    if (pages == GCI_POOL_PAGES_HUGE) {
+        // Only advice, the pool works the same without transparent huge pages
+        (void) madvise(region, size, MADV_HUGEPAGE);
+    }
+
+    context->region = region;
+    context->region_size = size;
+    context->memory = region;
+    return true;
+#else
+    (void) pages;
+    context->mapped = false;
+
+    if (size > SIZE_MAX - page_size) { return false; }
+    char *region = gci_allocator_alloc(context->allocator, size + page_size);
+    if (region == NULL) {
+        return false;
+    }
+
+    uintptr_t misalignment = (uintptr_t) region % page_size;
+    context->region = region;
+    context->region_size = size + page_size;
+    context->memory = misalignment == 0 ? region : region + (page_size - misalignment);
+    return true;
+#endif
+}
+
+void gci_pool_unmap(struct GciPool *context) {
+    assert(context != NULL);
+
+#ifdef __linux__
+    if (context->mapped) {
+        munmap(context->region, context->region_size);
+        return;
+    }
+#endif
+    gci_allocator_free(context->allocator, context->region, context->region_size);
+}
+
+char *gci_pool_next(char const *buffer) {
+    assert(buffer != NULL);
+    char *next;
+    memcpy(&next, buffer, sizeof(next));
+    return next;
+}
+
+void gci_pool_link(char *buffer, char *next) {
+    assert(buffer != NULL);
+    memcpy(buffer, &next, sizeof(next));
+}
+
+struct GciPoolCache *gci_pool_cache(struct GciPool *context) {
+    assert(context != NULL);
+    if (context->cache_size == 0) {
+        return NULL;
+    }
+
+    struct GciPoolCache *cache = pthread_getspecific(context->key);
+    if (cache != NULL) {
+        return cache;
+    }
+
+    cache = gci_allocator_alloc(context->allocator, sizeof(struct GciPoolCache));
+    if (cache == NULL) {
+        return NULL;
+    }
+    cache->pool = context;
+    cache->head = NULL;
+    cache->count = 0;
+    cache->previous = NULL;
+
+    if (pthread_setspecific(context->key, cache) != 0) {
+        gci_allocator_free(context->allocator, cache, sizeof(struct GciPoolCache));
+        return NULL;
+    }
+
+    pthread_mutex_lock(&context->mutex);
+    cache->next = context->caches;
+    if (context->caches != NULL) {
+        context->caches->previous = cache;
+    }
+    context->caches = cache;
+    pthread_mutex_unlock(&context->mutex);
+
+    return cache;
+}
+
+// Runs when a thread which used the pool exits
+void gci_pool_cache_destroy(void *void_cache) {
+    assert(void_cache != NULL);
+    struct GciPoolCache *cache = (struct GciPoolCache*) void_cache;
+    struct GciPool *context = cache->pool;
+
+    gci_pool_cache_drain(cache, 0);
+
+    pthread_mutex_lock(&context->mutex);
+    if (cache->previous != NULL) {
+        cache->previous->next = cache->next;
+    } else {
+        context->caches = cache->next;
+    }
+    if (cache->next != NULL) {
+        cache->next->previous = cache->previous;
+    }
+    pthread_mutex_unlock(&context->mutex);
+
+    gci_allocator_free(context->allocator, cache, sizeof(struct GciPoolCache));
+}
+
+// Moves cached buffers back to the shared list until `keep` are left
+void gci_pool_cache_drain(struct GciPoolCache *cache, size_t keep) {
+    assert(cache != NULL);
+    if (cache->count <= keep) {
+        return;
+    }
+
+    char *first = cache->head;
+    char *last = first;
+    for (size_t index = keep + 1; index < cache->count; index++) {
+        last = gci_pool_next(last);
+    }
+    cache->head = gci_pool_next(last);
+    size_t amount = cache->count - keep;
+    cache->count = keep;
+
+    struct GciPool *context = cache->pool;
+    pthread_mutex_lock(&context->mutex);
+    gci_pool_link(last, context->head);
+    context->head = first;
+    context->count += amount;
+    pthread_mutex_unlock(&context->mutex);
+}
+
+char *gci_pool_acquire(struct GciPool *context) {
+    assert(context != NULL);
+
+    struct GciPoolCache *cache = gci_pool_cache(context);
+    if (cache != NULL && cache->count > 0) {
+        char *buffer = cache->head;
+        cache->head = gci_pool_next(buffer);
+        cache->count -= 1;
+        return buffer;
+    }
+
+    pthread_mutex_lock(&context->mutex);
+    char *buffer = context->head;
+    if (buffer != NULL) {
+        context->head = gci_pool_next(buffer);
+        context->count -= 1;
+
+        // Refill half of the cache so the next acquires skip the lock
+        size_t refill = cache != NULL ? context->cache_size / 2 : 0;
+        while (refill > 0 && context->head != NULL) {
+            char *cached = context->head;
+            context->head = gci_pool_next(cached);
+            context->count -= 1;
+
+            gci_pool_link(cached, cache->head);
+            cache->head = cached;
+            cache->count += 1;
+            refill -= 1;
+        }
+    }
+    pthread_mutex_unlock(&context->mutex);
+
+    return buffer;
+}
+
+void gci_pool_release(struct GciPool *context, char *pointer) {
+    assert(context != NULL);
+    assert(pointer != NULL);
+    assert(context->memory <= pointer);
+
+    size_t index = (size_t) (pointer - context->memory) / context->buffer_size;
+    assert(index < context->buffer_count);
+    char *buffer = context->memory + index * context->buffer_size;
+
+    struct GciPoolCache *cache = gci_pool_cache(context);
+    if (cache == NULL) {
+        pthread_mutex_lock(&context->mutex);
+        gci_pool_link(buffer, context->head);
+        context->head = buffer;
+        context->count += 1;
+        pthread_mutex_unlock(&context->mutex);
+        return;
+    }
+
+    gci_pool_link(buffer, cache->head);
+    cache->head = buffer;
+    cache->count += 1;
+
+    if (cache->count > context->cache_size) {
+        gci_pool_cache_drain(cache, context->cache_size / 2);
+    }
+}
+
+enum GciError gci_reader_buffer_init_pooled(
+    struct GciReaderBuffer *context,
+    struct GciInterfaceReader reader,
+    struct GciPool *pool
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (pool == NULL) { return GCI_ERROR_NULL; }
+
+    char *buffer = gci_pool_acquire(pool);
+    if (buffer == NULL) { return GCI_ERROR_BUFFER; }
+
+    enum GciError err = gci_reader_buffer_init(context, reader, buffer, pool->buffer_size);
+    if (err != GCI_ERROR_OK) {
+        gci_pool_release(pool, buffer);
+    }
+    return err;
+}
+
+enum GciError gci_reader_double_buffer_init_pooled(
+    struct GciReaderBuffer *context,
+    struct GciInterfaceReader reader,
+    struct GciPool *pool
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (pool == NULL) { return GCI_ERROR_NULL; }
+
+    char *buffer = gci_pool_acquire(pool);
+    if (buffer == NULL) { return GCI_ERROR_BUFFER; }
+
+    enum GciError err = gci_reader_double_buffer_init(context, reader, buffer, pool->buffer_size);
+    if (err != GCI_ERROR_OK) {
+        gci_pool_release(pool, buffer);
+    }
+    return err;
+}
+
+void gci_reader_buffer_deinit_pooled(struct GciReaderBuffer *context, struct GciPool *pool) {
+    assert(context != NULL);
+    assert(pool != NULL);
+    // Both halves of a double buffer lie in the same pool buffer
+    gci_pool_release(pool, context->buffer);
+}
+
+enum GciError gci_writer_buffer_init_pooled(
+    struct GciWriterBuffer *context,
+    struct GciInterfaceWriter writer,
+    struct GciPool *pool
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (pool == NULL) { return GCI_ERROR_NULL; }
+
+    char *buffer = gci_pool_acquire(pool);
+    if (buffer == NULL) { return GCI_ERROR_BUFFER; }
+
+    enum GciError err = gci_writer_buffer_init(context, writer, buffer, pool->buffer_size);
+    if (err != GCI_ERROR_OK) {
+        gci_pool_release(pool, buffer);
+    }
+    return err;
+}
+
+void gci_writer_buffer_deinit_pooled(struct GciWriterBuffer *context, struct GciPool *pool) {
+    assert(context != NULL);
+    assert(pool != NULL);
+    gci_pool_release(pool, context->buffer);
+}
@@ -0,0 +1,216 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const allocator = @import("../allocator/allocator.zig");
+const reader = @import("../reader/reader.zig");
+const writer = @import("../writer/writer.zig");
+const InterfaceAllocator = allocator.InterfaceAllocator;
+const InterfaceReader = reader.InterfaceReader;
+const InterfaceWriter = writer.InterfaceWriter;
+
+pub const Pages = enum { normal, huge };
+
+pub const Pool = struct {
+    inner: lib.GciPool,
+
+    // Holds a lock and a thread cache key shared by every thread using the
+    // pool, so it is initialized in place and must not move until `deinit`.
+    pub fn init(
+        self: *Pool,
+        a: InterfaceAllocator,
+        buffer_size: usize,
+        buffer_count: usize,
+        cache_size: usize,
+        pages: Pages,
+    ) !void {
+        const c_pages: c_uint = switch (pages) {
+            .normal => lib.GCI_POOL_PAGES_NORMAL,
+            .huge => lib.GCI_POOL_PAGES_HUGE,
+        };
+
+        const err = lib.gci_pool_init(&self.inner, a.allocator, buffer_size, buffer_count, cache_size, c_pages);
+        try internal.enumToError(err);
+    }
+
+    pub fn deinit(self: *Pool) void {
+        lib.gci_pool_deinit(&self.inner);
+    }
+
+    // Size of every buffer, the requested size rounded up to whole pages.
+    pub fn bufferSize(self: *const Pool) usize {
+        return self.inner.buffer_size;
+    }
+
+    pub fn acquire(self: *Pool) ?[]u8 {
+        const buffer = lib.gci_pool_acquire(&self.inner);
+        if (buffer == null) {
+            return null;
+        }
+        return buffer[0..self.inner.buffer_size];
+    }
+
+    pub fn release(self: *Pool, buffer: []u8) void {
+        lib.gci_pool_release(&self.inner, buffer.ptr);
+    }
+};
+
+pub const Reader = struct {
+    inner: lib.GciReaderBuffer,
+    pool: *Pool,
+
+    pub fn init(r: InterfaceReader, pool: *Pool) !Reader {
+        var self: Reader = undefined;
+        const err = lib.gci_reader_buffer_init_pooled(&self.inner, r.reader, &pool.inner);
+        try internal.enumToError(err);
+        self.pool = pool;
+        return self;
+    }
+
+    pub fn initDouble(r: InterfaceReader, pool: *Pool) !Reader {
+        var self: Reader = undefined;
+        const err = lib.gci_reader_double_buffer_init_pooled(&self.inner, r.reader, &pool.inner);
+        try internal.enumToError(err);
+        self.pool = pool;
+        return self;
+    }
+
+    pub fn deinit(self: *Reader) void {
+        lib.gci_reader_buffer_deinit_pooled(&self.inner, &self.pool.inner);
+    }
+
+    pub fn interface(self: *Reader) InterfaceReader {
+        return .{ .reader = lib.gci_reader_buffer_interface(&self.inner) };
+    }
+};
+
+pub const Writer = struct {
+    inner: lib.GciWriterBuffer,
+    pool: *Pool,
+
+    pub fn init(w: InterfaceWriter, pool: *Pool) !Writer {
+        var self: Writer = undefined;
+        const err = lib.gci_writer_buffer_init_pooled(&self.inner, w.writer, &pool.inner);
+        try internal.enumToError(err);
+        self.pool = pool;
+        return self;
+    }
+
+    // Does not flush, see `gci_writer_buffer_deinit_pooled`.
+    pub fn deinit(self: *Writer) void {
+        lib.gci_writer_buffer_deinit_pooled(&self.inner, &self.pool.inner);
+    }
+
+    pub fn interface(self: *Writer) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_buffer_interface(&self.inner) };
+    }
+
+    pub fn flush(self: *Writer) !void {
+        const result = lib.gci_writer_buffer_flush(&self.inner);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_pool.zig");
+}
+
+test "pool acquire release" {
+    var pool: Pool = undefined;
+    try pool.init(allocator.libc(), 100, 2, 1, .normal);
+    defer pool.deinit();
+
+    try testing.expect(pool.bufferSize() >= 100);
+    try testing.expect(pool.bufferSize() % std.mem.page_size == 0);
+
+    const a = pool.acquire().?;
+    const b = pool.acquire().?;
+    try testing.expect(a.ptr != b.ptr);
+    try testing.expect(std.mem.isAligned(@intFromPtr(a.ptr), std.mem.page_size));
+    try testing.expect(pool.acquire() == null);
+
+    pool.release(a);
+    try testing.expectEqual(a.ptr, pool.acquire().?.ptr);
+    pool.release(a);
+    pool.release(b);
+}
+
+test "pool huge pages" {
+    var pool: Pool = undefined;
+    try pool.init(allocator.libc(), 4096, 4, 0, .huge);
+    defer pool.deinit();
+
+    const buffer = pool.acquire().?;
+    @memset(buffer, 'a');
+    pool.release(buffer);
+}
+
+test "pool threads" {
+    const Worker = struct {
+        fn run(pool: *Pool) !void {
+            for (0..1000) |round| {
+                const buffer = pool.acquire() orelse return error.Empty;
+                const value: u8 = @truncate(round);
+                @memset(buffer[0..16], value);
+                for (buffer[0..16]) |byte| {
+                    try testing.expectEqual(value, byte);
+                }
+                pool.release(buffer);
+            }
+        }
+    };
+
+    var pool: Pool = undefined;
+    try pool.init(allocator.libc(), 1, 16, 2, .normal);
+    defer pool.deinit();
+
+    var threads: [4]std.Thread = undefined;
+    for (&threads) |*thread| {
+        thread.* = try std.Thread.spawn(.{}, Worker.run, .{&pool});
+    }
+    for (threads) |thread| {
+        thread.join();
+    }
+
+    var held: [16][]u8 = undefined;
+    for (&held) |*buffer| {
+        buffer.* = pool.acquire().?;
+    }
+    for (held) |buffer| {
+        pool.release(buffer);
+    }
+}
+
+test "pooled reader" {
+    var pool: Pool = undefined;
+    try pool.init(allocator.libc(), 1, 1, 0, .normal);
+    defer pool.deinit();
+
+    var s = try reader.String.init("data");
+    var r = try Reader.initDouble(s.interface(), &pool);
+    defer r.deinit();
+
+    try testing.expectError(error.Buffer, Reader.init(s.interface(), &pool));
+
+    var result: [4]u8 = undefined;
+    try testing.expectEqualStrings("data", try r.interface().read(&result));
+}
+
+test "pooled writer" {
+    var pool: Pool = undefined;
+    try pool.init(allocator.libc(), 1, 1, 0, .normal);
+    defer pool.deinit();
+
+    var b: [8]u8 = undefined;
+    var s = try writer.String.init(&b);
+    var w = try Writer.init(s.interface(), &pool);
+    defer w.deinit();
+
+    try w.interface().write("abc");
+    try testing.expectEqual(0, s.inner.current);
+    try w.flush();
+    try testing.expectEqualStrings("abc", b[0..s.inner.current]);
+}
@@ -0,0 +1,93 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "pool init" {
+    var context: lib.GciPool = undefined;
+    const init_err = lib.gci_pool_init(&context, lib.gci_allocator_libc_interface(), 10, 2, 1, lib.GCI_POOL_PAGES_NORMAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    lib.gci_pool_deinit(&context);
+}
+
+test "pool init null" {
+    const init_err = lib.gci_pool_init(null, lib.gci_allocator_libc_interface(), 10, 2, 1, lib.GCI_POOL_PAGES_NORMAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "pool init buffer" {
+    var context: lib.GciPool = undefined;
+
+    const init_err1 = lib.gci_pool_init(&context, lib.gci_allocator_libc_interface(), 0, 2, 1, lib.GCI_POOL_PAGES_NORMAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err1);
+
+    const init_err2 = lib.gci_pool_init(&context, lib.gci_allocator_libc_interface(), 10, 0, 1, lib.GCI_POOL_PAGES_NORMAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err2);
+}
+
+test "pool empty" {
+    var context: lib.GciPool = undefined;
+    const init_err = lib.gci_pool_init(&context, lib.gci_allocator_libc_interface(), 10, 2, 0, lib.GCI_POOL_PAGES_NORMAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_pool_deinit(&context);
+
+    const buffer1 = lib.gci_pool_acquire(&context);
+    const buffer2 = lib.gci_pool_acquire(&context);
+    try testing.expect(buffer1 != null);
+    try testing.expect(buffer2 != null);
+    try testing.expect(lib.gci_pool_acquire(&context) == null);
+
+    lib.gci_pool_release(&context, buffer2 + 5);
+    try testing.expectEqual(buffer2, lib.gci_pool_acquire(&context));
+
+    lib.gci_pool_release(&context, buffer1);
+    lib.gci_pool_release(&context, buffer2);
+}
+
+test "pooled reader init" {
+    var pool: lib.GciPool = undefined;
+    const pool_err = lib.gci_pool_init(&pool, lib.gci_allocator_libc_interface(), 10, 1, 0, lib.GCI_POOL_PAGES_NORMAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), pool_err);
+    defer lib.gci_pool_deinit(&pool);
+
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, "data", 4);
+
+    var context: lib.GciReaderBuffer = undefined;
+    const init_err1 = lib.gci_reader_buffer_init_pooled(&context, lib.gci_reader_string_interface(&c), null);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err1);
+
+    const init_err2 = lib.gci_reader_buffer_init_pooled(&context, lib.gci_reader_string_interface(&c), &pool);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err2);
+
+    var other: lib.GciReaderBuffer = undefined;
+    const init_err3 = lib.gci_reader_buffer_init_pooled(&other, lib.gci_reader_string_interface(&c), &pool);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err3);
+
+    lib.gci_reader_buffer_deinit_pooled(&context, &pool);
+
+    const init_err4 = lib.gci_reader_buffer_init_pooled(&other, lib.gci_reader_string_interface(&c), &pool);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err4);
+    lib.gci_reader_buffer_deinit_pooled(&other, &pool);
+}
+
+test "pooled writer write" {
+    var pool: lib.GciPool = undefined;
+    const pool_err = lib.gci_pool_init(&pool, lib.gci_allocator_libc_interface(), 10, 1, 1, lib.GCI_POOL_PAGES_NORMAL);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), pool_err);
+    defer lib.gci_pool_deinit(&pool);
+
+    var b: [4]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&c, &b, b.len);
+
+    var context: lib.GciWriterBuffer = undefined;
+    const init_err = lib.gci_writer_buffer_init_pooled(&context, lib.gci_writer_string_interface(&c), &pool);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_buffer_interface(&context);
+    try testing.expectEqual(4, lib.gci_writer_write(writer, "data", 4));
+    try testing.expect(lib.gci_writer_buffer_flush(&context));
+    try testing.expectEqualStrings("data", &b);
+
+    lib.gci_writer_buffer_deinit_pooled(&context, &pool);
+}
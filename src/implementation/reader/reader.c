@@ -1,8 +1,13 @@
-#include <limits.h>
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include <string.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <gci_reader.h>
+#include <gci_simd.h>
+
+#define GCI_READER_RANGE_SCAN 4096
 
 size_t gci_reader_fail_read(void const *context, char *buffer, size_t buffer_size);
 size_t gci_reader_file_read(void const *context, char *buffer, size_t buffer_size);
@@ -12,6 +17,16 @@ bool gci_reader_fail_eof(void const *context);
 bool gci_reader_file_eof(void const *context);
 bool gci_reader_string_eof(void const *context);
 bool gci_reader_buffer_eof(void const *context);
+size_t gci_reader_string_peek(void const *context, char const **data);
+size_t gci_reader_buffer_peek(void const *context, char const **data);
+void gci_reader_string_consume(void const *context, size_t amount);
+size_t gci_reader_string_read_at(void const *context, char *buffer, size_t buffer_size, uint64_t offset);
+size_t gci_reader_buffer_read_at(void const *context, char *buffer, size_t buffer_size, uint64_t offset);
+size_t gci_reader_range_read(void const *context, char *buffer, size_t buffer_size);
+bool gci_reader_range_eof(void const *context);
+size_t gci_reader_range_read_at(void const *context, char *buffer, size_t buffer_size, uint64_t offset);
+enum GciError gci_reader_range_align(struct GciInterfaceReader reader, uint64_t size, char delimiter, uint64_t *bound);
+void gci_reader_buffer_consume(void const *context, size_t amount);
 
 enum GciError gci_reader_fail_init(struct GciReaderFail *context, struct GciInterfaceReader reader, size_t reads_before_fail) {
     if (context == NULL) { return GCI_ERROR_NULL; }
@@ -110,6 +125,9 @@ struct GciInterfaceReader gci_reader_string_interface(struct GciReaderString *co
         .context = context,
         .read = gci_reader_string_read,
         .eof = gci_reader_string_eof,
+        .peek = gci_reader_string_peek,
+        .consume = gci_reader_string_consume,
+        .read_at = gci_reader_string_read_at,
     };
 }
 
@@ -146,6 +164,47 @@ bool gci_reader_string_eof(void const *void_context) {
     return context->current > context->buffer_size;
 }
 
+size_t gci_reader_string_peek(void const *void_context, char const **data) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciReaderString *context = (struct GciReaderString*) void_context;
+
+    assert(context->current <= context->buffer_size + 1);
+    if (context->current >= context->buffer_size) {
+        assert(context->buffer_size < SIZE_MAX);
+        context->current = context->buffer_size + 1;
+        return 0;
+    }
+
+    assert(context->buffer != NULL);
+    *data = context->buffer + context->current;
+    return context->buffer_size - context->current;
+}
+
+void gci_reader_string_consume(void const *void_context, size_t amount) {
+    assert(void_context != NULL);
+    struct GciReaderString *context = (struct GciReaderString*) void_context;
+
+    assert(context->current <= context->buffer_size);
+    assert(amount <= context->buffer_size - context->current);
+    context->current += amount;
+}
+
+size_t gci_reader_string_read_at(void const *void_context, char *buffer, size_t buffer_size, uint64_t offset) {
+    assert(void_context != NULL);
+    struct GciReaderString *context = (struct GciReaderString*) void_context;
+
+    if (offset >= context->buffer_size) { return 0; }
+
+    size_t read_length = context->buffer_size - (size_t) offset;
+    read_length = read_length > buffer_size ? buffer_size : read_length;
+
+    assert(buffer != NULL);
+    assert(context->buffer != NULL);
+    memcpy(buffer, context->buffer + offset, read_length);
+    return read_length;
+}
+
 enum GciError gci_reader_buffer_init(
     struct GciReaderBuffer *context,
     struct GciInterfaceReader reader,
@@ -194,6 +253,9 @@ struct GciInterfaceReader gci_reader_buffer_interface(struct GciReaderBuffer *co
         .context = context,
         .read = gci_reader_buffer_read,
         .eof = gci_reader_buffer_eof,
+        .peek = gci_reader_buffer_peek,
+        .consume = gci_reader_buffer_consume,
+        .read_at = context->reader.read_at != NULL ? gci_reader_buffer_read_at : NULL,
     };
 }
 
@@ -272,3 +334,256 @@ bool gci_reader_buffer_eof(void const *void_context) {
     struct GciReaderBuffer *context = (struct GciReaderBuffer*) void_context;
     return (context->current > context->length_read) && gci_reader_eof(context->reader);
 }
+
+size_t gci_reader_buffer_peek(void const *void_context, char const **data) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciReaderBuffer *context = (struct GciReaderBuffer*) void_context;
+    assert(context->current <= context->length_read + 1);
+
+    if (context->current < context->length_read) {
+        *data = context->buffer + context->current;
+        return context->length_read - context->current;
+    }
+
+    if (context->next_read == NULL || context->current > context->length_read) {
+        return 0;
+    }
+
+    size_t length = gci_reader_read(context->reader, context->next_read, context->buffer_size);
+    if (length == 0) {
+        if (context->buffer == context->next_read) {
+            context->next_read = NULL;
+        }
+
+        if (gci_reader_eof(context->reader)) {
+            assert(context->length_read < SIZE_MAX);
+            context->current = context->length_read + 1;
+        }
+        return 0;
+    }
+
+    char *temp = context->buffer;
+    context->buffer = context->next_read;
+    context->next_read = temp;
+
+    context->length_read = length;
+    context->current = 0;
+
+    *data = context->buffer;
+    return length;
+}
+
+void gci_reader_buffer_consume(void const *void_context, size_t amount) {
+    assert(void_context != NULL);
+    struct GciReaderBuffer *context = (struct GciReaderBuffer*) void_context;
+
+    assert(context->current <= context->length_read);
+    assert(amount <= context->length_read - context->current);
+    context->current += amount;
+}
+
+size_t gci_reader_buffer_read_at(void const *void_context, char *buffer, size_t buffer_size, uint64_t offset) {
+    assert(void_context != NULL);
+    struct GciReaderBuffer *context = (struct GciReaderBuffer*) void_context;
+
+    // Reads at an offset do not move the reader so the buffer is bypassed
+    return gci_reader_read_at(context->reader, buffer, buffer_size, offset);
+}
+
+enum GciError gci_reader_range_init(
+    struct GciReaderRange *context,
+    struct GciInterfaceReader reader,
+    uint64_t start,
+    uint64_t end
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (reader.read_at == NULL) { return GCI_ERROR_NULL; }
+    if (start > end) { return GCI_ERROR_BUFFER; }
+
+    context->reader = reader;
+    context->start = start;
+    context->end = end;
+    context->current = start;
+    context->eof = false;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceReader gci_reader_range_interface(struct GciReaderRange *context) {
+    return (struct GciInterfaceReader) {
+        .context = context,
+        .read = gci_reader_range_read,
+        .eof = gci_reader_range_eof,
+        .read_at = gci_reader_range_read_at,
+    };
+}
+
+size_t gci_reader_range_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    struct GciReaderRange *context = (struct GciReaderRange*) void_context;
+
+    assert(context->start <= context->current && context->current <= context->end);
+    uint64_t length_left = context->end - context->current;
+    size_t length = length_left < buffer_size ? (size_t) length_left : buffer_size;
+
+    size_t read_length = 0;
+    if (length > 0) {
+        read_length = gci_reader_read_at(context->reader, buffer, length, context->current);
+    }
+    context->current += read_length;
+
+    assert(read_length <= buffer_size);
+    if (read_length < buffer_size) {
+        context->eof = true;
+    }
+    return read_length;
+}
+
+bool gci_reader_range_eof(void const *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderRange *context = (struct GciReaderRange*) void_context;
+    return context->eof;
+}
+
+size_t gci_reader_range_read_at(void const *void_context, char *buffer, size_t buffer_size, uint64_t offset) {
+    assert(void_context != NULL);
+    struct GciReaderRange *context = (struct GciReaderRange*) void_context;
+
+    uint64_t range_size = context->end - context->start;
+    if (offset >= range_size) { return 0; }
+
+    uint64_t length_left = range_size - offset;
+    size_t length = length_left < buffer_size ? (size_t) length_left : buffer_size;
+    return gci_reader_read_at(context->reader, buffer, length, context->start + offset);
+}
+
+enum GciError gci_reader_range_split(
+    struct GciInterfaceReader reader,
+    uint64_t size,
+    size_t range_count,
+    bool delimited,
+    char delimiter,
+    uint64_t *bounds
+) {
+    if (bounds == NULL) { return GCI_ERROR_NULL; }
+    if (delimited && reader.read_at == NULL) { return GCI_ERROR_NULL; }
+    if (range_count == 0) { return GCI_ERROR_BUFFER; }
+
+    uint64_t count = (uint64_t) range_count;
+    bounds[0] = 0;
+    for (size_t i = 1; i < range_count; i++) {
+        // Split as `size * i / count` without overflowing
+        uint64_t bound = (size / count) * i + (size % count) * i / count;
+
+        if (bound <= bounds[i - 1]) {
+            // The previous bound is already past this one and aligned
+            bound = bounds[i - 1];
+        } else if (delimited) {
+            enum GciError err = gci_reader_range_align(reader, size, delimiter, &bound);
+            if (err != GCI_ERROR_OK) { return err; }
+        }
+
+        bounds[i] = bound;
+    }
+    bounds[range_count] = size;
+
+    return GCI_ERROR_OK;
+}
+
+// Moves `bound` forward to just after the first delimiter at or after
+// `bound - 1`, or to `size` if there is none.
+enum GciError gci_reader_range_align(struct GciInterfaceReader reader, uint64_t size, char delimiter, uint64_t *bound) {
+    assert(bound != NULL);
+    assert(0 < *bound && *bound <= size);
+
+    char scan[GCI_READER_RANGE_SCAN];
+    uint64_t offset = *bound - 1;
+    while (offset < size) {
+        uint64_t length_left = size - offset;
+        size_t length = length_left < sizeof(scan) ? (size_t) length_left : sizeof(scan);
+
+        size_t read_length = gci_reader_read_at(reader, scan, length, offset);
+        if (read_length < length) { return GCI_ERROR_IO; }
+
+        char const *found = gci_find_byte(scan, length, delimiter);
+        if (found != NULL) {
+            *bound = offset + (uint64_t) (found - scan) + 1;
+            return GCI_ERROR_OK;
+        }
+        offset += length;
+    }
+
+    *bound = size;
+    return GCI_ERROR_OK;
+}
+
+enum GciError gci_reader_read_until(
+    struct GciInterfaceReader reader,
+    char delimiter,
+    char *spill,
+    size_t spill_size,
+    char const **record,
+    size_t *length
+) {
+    assert(record != NULL);
+    assert(length != NULL);
+    assert(spill != NULL || spill_size == 0);
+
+    size_t spilled = 0;
+    if (reader.peek == NULL) {
+        while (spilled < spill_size) {
+            size_t result = gci_reader_read(reader, spill + spilled, 1);
+            if (result == 0) { break; }
+
+            spilled += 1;
+            if (spill[spilled - 1] == delimiter) {
+                *record = spill;
+                *length = spilled;
+                return GCI_ERROR_OK;
+            }
+        }
+
+        // Without a way to look ahead a full spill is taken to truncate the
+        // record unless the reader already knows it is at its end
+        *record = spill;
+        *length = spilled;
+        bool truncated = spilled == spill_size && !gci_reader_eof(reader);
+        return truncated ? GCI_ERROR_BUFFER : GCI_ERROR_OK;
+    }
+
+    while (true) {
+        char const *data;
+        size_t data_size = gci_reader_peek(reader, &data, NULL, 0);
+        if (data_size == 0) { break; }
+
+        char const *found = gci_find_byte(data, data_size, delimiter);
+        size_t take = found != NULL ? (size_t) (found - data) + 1 : data_size;
+
+        if (spilled == 0 && found != NULL) {
+            gci_reader_consume(reader, data_size, take);
+            *record = data;
+            *length = take;
+            return GCI_ERROR_OK;
+        }
+
+        bool truncated = take > spill_size - spilled;
+        take = truncated ? spill_size - spilled : take;
+        if (take > 0) {
+            memcpy(spill + spilled, data, take);
+            gci_reader_consume(reader, data_size, take);
+            spilled += take;
+        }
+
+        if (truncated) {
+            *record = spill;
+            *length = spilled;
+            return GCI_ERROR_BUFFER;
+        }
+        if (found != NULL) { break; }
+    }
+
+    *record = spill;
+    *length = spilled;
+    return GCI_ERROR_OK;
+}
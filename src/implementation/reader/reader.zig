@@ -17,6 +17,64 @@ pub const InterfaceReader = struct {
     pub fn eof(reader: InterfaceReader) bool {
         return lib.gci_reader_eof(reader.reader);
     }
+
+    pub fn peek(reader: InterfaceReader, scratch: []u8) ![]const u8 {
+        var data: [*c]const u8 = undefined;
+        const length = lib.gci_reader_peek(reader.reader, &data, scratch.ptr, scratch.len);
+        if (length == 0) {
+            return error.Reader;
+        } else {
+            return data[0..length];
+        }
+    }
+
+    // Marks `amount` bytes of `view`, the result of the last `peek`, as read.
+    pub fn consume(reader: InterfaceReader, view: []const u8, amount: usize) void {
+        lib.gci_reader_consume(reader.reader, view.len, amount);
+    }
+
+    // Reads from `offset` of the source without moving the reader, the
+    // reader must implement `read_at`. A short result means the source ended.
+    pub fn readAt(reader: InterfaceReader, buffer: []u8, offset: u64) ![]u8 {
+        const length = lib.gci_reader_read_at(reader.reader, buffer.ptr, buffer.len, offset);
+        if (length == 0 and buffer.len > 0) {
+            return error.Reader;
+        } else {
+            return buffer[0..length];
+        }
+    }
+
+    // Returns the next record including its delimiter or null once nothing
+    // is left, see `gci_reader_read_until`.
+    pub fn readUntil(reader: InterfaceReader, delimiter: u8, spill: []u8) !?[]const u8 {
+        var record: [*c]const u8 = undefined;
+        var length: usize = undefined;
+        const err = lib.gci_reader_read_until(reader.reader, delimiter, spill.ptr, spill.len, &record, &length);
+        try internal.enumToError(err);
+        if (length == 0) {
+            return null;
+        }
+        return record[0..length];
+    }
+};
+
+// Iterates the records of a reader with their delimiter removed.
+pub const Lines = struct {
+    reader: InterfaceReader,
+    delimiter: u8,
+    spill: []u8,
+
+    pub fn init(reader: InterfaceReader, delimiter: u8, spill: []u8) Lines {
+        return .{ .reader = reader, .delimiter = delimiter, .spill = spill };
+    }
+
+    pub fn next(self: *Lines) !?[]const u8 {
+        const record = try self.reader.readUntil(self.delimiter, self.spill) orelse return null;
+        if (record[record.len - 1] == self.delimiter) {
+            return record[0 .. record.len - 1];
+        }
+        return record;
+    }
 };
 
 pub const Fail = struct {
@@ -55,6 +113,9 @@ pub fn Reader(AnyReader: type) type {
                 .context = self,
                 .read = readCallback,
                 .eof = eofCallback,
+                .peek = null,
+                .consume = null,
+                .read_at = null,
             };
             return .{ .reader = reader };
         }
@@ -151,6 +212,39 @@ pub const Buffer = struct {
     }
 };
 
+pub const Range = struct {
+    inner: lib.GciReaderRange,
+
+    pub fn init(r: InterfaceReader, start: u64, end: u64) !Range {
+        var self: Range = undefined;
+        const err = lib.gci_reader_range_init(&self.inner, r.reader, start, end);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Range) InterfaceReader {
+        return .{ .reader = lib.gci_reader_range_interface(&self.inner) };
+    }
+};
+
+// Splits the first `size` bytes of `r` into `bounds.len - 1` ranges, range
+// `i` is [`bounds[i]`, `bounds[i + 1]`). With a delimiter no record
+// straddles two ranges, see `gci_reader_range_split`.
+pub fn splitRanges(r: InterfaceReader, size: u64, delimiter: ?u8, bounds: []u64) !void {
+    if (bounds.len == 0) {
+        return error.Buffer;
+    }
+    const err = lib.gci_reader_range_split(
+        r.reader,
+        size,
+        bounds.len - 1,
+        delimiter != null,
+        delimiter orelse 0,
+        bounds.ptr,
+    );
+    try internal.enumToError(err);
+}
+
 const testing = std.testing;
 const builtin = @import("builtin");
 const clib = @cImport({
@@ -342,6 +436,80 @@ test "string read overflow" {
     try testing.expect(reader.eof());
 }
 
+test "string peek" {
+    var context = try String.init("12");
+    const reader = context.interface();
+
+    var scratch: [0]u8 = undefined;
+    const result1 = try reader.peek(&scratch);
+    try testing.expectEqualStrings("12", result1);
+    reader.consume(result1, 1);
+
+    const result2 = try reader.peek(&scratch);
+    try testing.expectEqualStrings("2", result2);
+    reader.consume(result2, 1);
+    try testing.expect(!reader.eof());
+
+    const err = reader.peek(&scratch);
+    try testing.expectError(error.Reader, err);
+    try testing.expect(reader.eof());
+}
+
+test "string read at" {
+    var context = try String.init("12345");
+    const reader = context.interface();
+
+    var buffer: [3]u8 = undefined;
+    const result1 = try reader.readAt(&buffer, 1);
+    try testing.expectEqualStrings("234", result1);
+
+    const result2 = try reader.read(&buffer);
+    try testing.expectEqualStrings("123", result2);
+
+    const result3 = try reader.readAt(&buffer, 4);
+    try testing.expectEqualStrings("5", result3);
+}
+
+test "range read" {
+    var source = try String.init("0123456789");
+
+    var context = try Range.init(source.interface(), 2, 7);
+    const reader = context.interface();
+
+    var buffer: [4]u8 = undefined;
+    try testing.expectEqualStrings("2345", try reader.read(&buffer));
+    try testing.expect(!reader.eof());
+    try testing.expectEqualStrings("6", try reader.read(&buffer));
+    try testing.expect(reader.eof());
+
+    try testing.expectEqualStrings("456", try reader.readAt(&buffer, 2));
+}
+
+test "range init" {
+    var source = try String.init("0123456789");
+    const err = Range.init(source.interface(), 7, 2);
+    try testing.expectError(error.Buffer, err);
+}
+
+test "split ranges" {
+    const data = "aaa\nbb\ncccccc\nd\ne\n";
+    var source = try String.init(data);
+
+    var bounds: [4]u64 = undefined;
+    try splitRanges(source.interface(), data.len, null, &bounds);
+    try testing.expectEqualSlices(u64, &.{ 0, 6, 12, 18 }, &bounds);
+
+    try splitRanges(source.interface(), data.len, '\n', &bounds);
+    try testing.expectEqualSlices(u64, &.{ 0, 7, 14, 18 }, &bounds);
+
+    for (0..3) |i| {
+        var context = try Range.init(source.interface(), bounds[i], bounds[i + 1]);
+        var buffer: [32]u8 = undefined;
+        const result = try context.interface().read(&buffer);
+        try testing.expectEqual('\n', result[result.len - 1]);
+    }
+}
+
 test "buffer init" {
     const d = "data";
     var c = try String.init(d);
@@ -510,6 +678,82 @@ test "buffer clear error large" {
     try testing.expect(!reader.eof());
 }
 
+test "buffer peek" {
+    var c = try String.init("data");
+
+    var buffer: [3]u8 = undefined;
+    var context = try Buffer.init(c.interface(), &buffer);
+    const reader = context.interface();
+
+    var scratch: [0]u8 = undefined;
+    const result1 = try reader.peek(&scratch);
+    try testing.expectEqualStrings("dat", result1);
+    reader.consume(result1, result1.len);
+
+    const result2 = try reader.peek(&scratch);
+    try testing.expectEqualStrings("a", result2);
+    reader.consume(result2, result2.len);
+
+    const err = reader.peek(&scratch);
+    try testing.expectError(error.Reader, err);
+    try testing.expect(reader.eof());
+}
+
+test "buffer read until" {
+    var c = try String.init("ab\ncdef\n\ng");
+
+    var buffer: [4]u8 = undefined;
+    var context = try Buffer.init(c.interface(), &buffer);
+    const reader = context.interface();
+
+    var spill: [8]u8 = undefined;
+    try testing.expectEqualStrings("ab\n", (try reader.readUntil('\n', &spill)).?);
+    try testing.expectEqualStrings("cdef\n", (try reader.readUntil('\n', &spill)).?);
+    try testing.expectEqualStrings("\n", (try reader.readUntil('\n', &spill)).?);
+    try testing.expectEqualStrings("g", (try reader.readUntil('\n', &spill)).?);
+    try testing.expect(try reader.readUntil('\n', &spill) == null);
+}
+
+test "buffer read until small spill" {
+    var c = try String.init("abcdefgh\n");
+
+    var buffer: [4]u8 = undefined;
+    var context = try Buffer.init(c.interface(), &buffer);
+    const reader = context.interface();
+
+    var spill: [6]u8 = undefined;
+    const err = reader.readUntil('\n', &spill);
+    try testing.expectError(error.Buffer, err);
+    try testing.expectEqualStrings("abcdef", &spill);
+    try testing.expectEqualStrings("gh\n", (try reader.readUntil('\n', &spill)).?);
+}
+
+test "lines" {
+    var c = try String.init("one\ntwo\nthree");
+    var context = try Fail.init(c.interface(), 100);
+
+    var spill: [8]u8 = undefined;
+    var lines = Lines.init(context.interface(), '\n', &spill);
+    try testing.expectEqualStrings("one", (try lines.next()).?);
+    try testing.expectEqualStrings("two", (try lines.next()).?);
+    try testing.expectEqualStrings("three", (try lines.next()).?);
+    try testing.expect(try lines.next() == null);
+}
+
+test "fail peek fallback" {
+    var c = try String.init("12");
+    var context = try Fail.init(c.interface(), 1);
+    const reader = context.interface();
+
+    var scratch: [1]u8 = undefined;
+    const result = try reader.peek(&scratch);
+    try testing.expectEqualStrings("1", result);
+    reader.consume(result, result.len);
+
+    const err = reader.peek(&scratch);
+    try testing.expectError(error.Reader, err);
+}
+
 test "double buffer init" {
     const d = "";
     var c = try String.init(d);
@@ -188,6 +188,119 @@ test "string read overflow" {
     try testing.expect(lib.gci_reader_eof(reader));
 }
 
+test "string peek" {
+    const data = "zig";
+    var context: lib.GciReaderString = undefined;
+    const init_err = lib.gci_reader_string_init(&context, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_string_interface(&context);
+
+    var view: [*c]const u8 = undefined;
+    const length1 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(3, length1);
+    try testing.expectEqual(@as([*c]const u8, data), view);
+    lib.gci_reader_consume(reader, length1, 2);
+
+    const length2 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(1, length2);
+    try testing.expectEqualStrings("g", view[0..1]);
+    lib.gci_reader_consume(reader, length2, 1);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    const length3 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(0, length3);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "string read at" {
+    const data = "zig";
+    var context: lib.GciReaderString = undefined;
+    const init_err = lib.gci_reader_string_init(&context, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_string_interface(&context);
+
+    var buffer: [2]u8 = undefined;
+    const length1 = lib.gci_reader_read_at(reader, &buffer, buffer.len, 1);
+    try testing.expectEqual(2, length1);
+    try testing.expectEqualStrings("ig", &buffer);
+
+    const length2 = lib.gci_reader_read_at(reader, &buffer, buffer.len, 3);
+    try testing.expectEqual(0, length2);
+    try testing.expect(!lib.gci_reader_eof(reader));
+}
+
+test "range read" {
+    const data = "0123456789";
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, data, data.len);
+
+    var context: lib.GciReaderRange = undefined;
+    const init_err = lib.gci_reader_range_init(&context, lib.gci_reader_string_interface(&c), 3, 6);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_range_interface(&context);
+
+    var buffer: [4]u8 = undefined;
+    const length1 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(3, length1);
+    try testing.expectEqualStrings("345", buffer[0..3]);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "range init null" {
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, "data", 4);
+    var reader = lib.gci_reader_string_interface(&c);
+    reader.read_at = null;
+
+    var context: lib.GciReaderRange = undefined;
+    const init_err = lib.gci_reader_range_init(&context, reader, 0, 4);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "range split delimited" {
+    const data = "a\nbbbbbbbbbb\nc\n";
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, data, data.len);
+
+    var bounds: [4]u64 = undefined;
+    const err = lib.gci_reader_range_split(lib.gci_reader_string_interface(&c), data.len, 3, true, '\n', &bounds);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), err);
+    try testing.expectEqualSlices(u64, &.{ 0, 13, 13, 15 }, &bounds);
+}
+
+test "range split count zero" {
+    var c: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&c, "data", 4);
+
+    var bounds: [1]u64 = undefined;
+    const err = lib.gci_reader_range_split(lib.gci_reader_string_interface(&c), 4, 0, false, 0, &bounds);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), err);
+}
+
+test "fail peek fallback" {
+    const data = "12";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderFail = undefined;
+    const init_err = lib.gci_reader_fail_init(&context, lib.gci_reader_string_interface(&c), 5);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_fail_interface(&context);
+
+    var scratch: [1]u8 = undefined;
+    var view: [*c]const u8 = undefined;
+    const length1 = lib.gci_reader_peek(reader, &view, &scratch, scratch.len);
+    try testing.expectEqual(1, length1);
+    try testing.expectEqual(@as([*c]const u8, &scratch), view);
+    try testing.expectEqualStrings("1", view[0..1]);
+    lib.gci_reader_consume(reader, length1, 1);
+
+    const length2 = lib.gci_reader_peek(reader, &view, &scratch, scratch.len);
+    try testing.expectEqual(1, length2);
+    try testing.expectEqualStrings("2", view[0..1]);
+}
+
 test "buffer init" {
     const data = "data";
     var c: lib.GciReaderString = undefined;
@@ -463,6 +576,277 @@ test "buffer clear error large" {
     try testing.expect(!lib.gci_reader_eof(reader));
 }
 
+test "buffer peek" {
+    const data = "data";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [3]u8 = undefined;
+    var context: lib.GciReaderBuffer = undefined;
+    const init_err = lib.gci_reader_buffer_init(
+        &context,
+        lib.gci_reader_string_interface(&c),
+        &buffer,
+        buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_buffer_interface(&context);
+
+    var view: [*c]const u8 = undefined;
+    const length1 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(3, length1);
+    try testing.expectEqual(@as([*c]const u8, &buffer), view);
+    try testing.expectEqualStrings("dat", view[0..3]);
+    lib.gci_reader_consume(reader, length1, 1);
+
+    const length2 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(2, length2);
+    try testing.expectEqualStrings("at", view[0..2]);
+    lib.gci_reader_consume(reader, length2, 2);
+
+    const length3 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(1, length3);
+    try testing.expectEqualStrings("a", view[0..1]);
+    lib.gci_reader_consume(reader, length3, 1);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    const length4 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(0, length4);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "buffer read at" {
+    const data = "data";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [2]u8 = undefined;
+    var context: lib.GciReaderBuffer = undefined;
+    const init_err = lib.gci_reader_buffer_init(&context, lib.gci_reader_string_interface(&c), &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_buffer_interface(&context);
+    try testing.expect(reader.read_at != null);
+
+    var result: [3]u8 = undefined;
+    const length1 = lib.gci_reader_read(reader, &result, 1);
+    try testing.expectEqual(1, length1);
+    try testing.expectEqualStrings("d", result[0..1]);
+
+    const length2 = lib.gci_reader_read_at(reader, &result, result.len, 2);
+    try testing.expectEqual(2, length2);
+    try testing.expectEqualStrings("ta", result[0..2]);
+
+    const length3 = lib.gci_reader_read(reader, &result, result.len);
+    try testing.expectEqual(3, length3);
+    try testing.expectEqualStrings("ata", &result);
+}
+
+test "buffer without read at" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "data", 4);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+    var inner = lib.gci_reader_string_interface(&c);
+    inner.read_at = null;
+
+    var buffer: [2]u8 = undefined;
+    var context: lib.GciReaderBuffer = undefined;
+    const init_err = lib.gci_reader_buffer_init(&context, inner, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_buffer_interface(&context);
+    try testing.expect(reader.read_at == null);
+}
+
+test "double buffer peek" {
+    const data = "1234";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciReaderBuffer = undefined;
+    const init_err = lib.gci_reader_double_buffer_init(
+        &context,
+        lib.gci_reader_string_interface(&c),
+        &buffer,
+        buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_buffer_interface(&context);
+
+    var view: [*c]const u8 = undefined;
+    const length1 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(2, length1);
+    try testing.expectEqualStrings("12", view[0..2]);
+    lib.gci_reader_consume(reader, length1, 2);
+
+    const length2 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(2, length2);
+    try testing.expectEqualStrings("34", view[0..2]);
+    lib.gci_reader_consume(reader, length2, 2);
+
+    const length3 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(0, length3);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "buffer read until" {
+    const data = "ab\ncd";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciReaderBuffer = undefined;
+    const init_err = lib.gci_reader_buffer_init(
+        &context,
+        lib.gci_reader_string_interface(&c),
+        &buffer,
+        buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_buffer_interface(&context);
+
+    var spill: [4]u8 = undefined;
+    var record: [*c]const u8 = undefined;
+    var length: usize = undefined;
+
+    const err1 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), err1);
+    try testing.expectEqual(@as([*c]const u8, &buffer), record);
+    try testing.expectEqualStrings("ab\n", record[0..length]);
+
+    const err2 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), err2);
+    try testing.expectEqual(@as([*c]const u8, &spill), record);
+    try testing.expectEqualStrings("cd", record[0..length]);
+
+    const err3 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), err3);
+    try testing.expectEqual(0, length);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "read until small spill" {
+    const data = "abcde\n";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderFail = undefined;
+    const init_err = lib.gci_reader_fail_init(&context, lib.gci_reader_string_interface(&c), 100);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_fail_interface(&context);
+
+    var spill: [3]u8 = undefined;
+    var record: [*c]const u8 = undefined;
+    var length: usize = undefined;
+
+    const err1 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), err1);
+    try testing.expectEqualStrings("abc", record[0..length]);
+
+    const err2 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), err2);
+    try testing.expectEqualStrings("de\n", record[0..length]);
+}
+
+test "read until spill filled at eof" {
+    const data = "abc";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderFail = undefined;
+    const init_err = lib.gci_reader_fail_init(&context, lib.gci_reader_string_interface(&c), 100);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_fail_interface(&context);
+
+    var spill: [3]u8 = undefined;
+    var record: [*c]const u8 = undefined;
+    var length: usize = undefined;
+
+    const err1 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), err1);
+    try testing.expectEqualStrings("abc", record[0..length]);
+
+    const err2 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), err2);
+    try testing.expectEqual(0, length);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "file read until spill filled at eof" {
+    var file: [*c]clib.FILE = undefined;
+
+    switch (builtin.os.tag) {
+        .linux => {
+            file = clib.tmpfile();
+        },
+        .windows => {
+            @compileError("TODO: allow testing file reader, something to do with `GetTempFileNameA` and `GetTempPathA`");
+        },
+        else => {
+            std.debug.print("TODO: allow testing file reader on this os.\n", .{});
+            return;
+        },
+    }
+    defer _ = clib.fclose(file);
+
+    const written = clib.fputs("abc", file);
+    try testing.expect(written >= 0);
+
+    const seek_err = clib.fseek(file, 0, clib.SEEK_SET);
+    try testing.expectEqual(0, seek_err);
+
+    var context: lib.GciReaderFile = undefined;
+    const init_err = lib.gci_reader_file_init(&context, @ptrCast(file));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_file_interface(&context);
+
+    var spill: [3]u8 = undefined;
+    var record: [*c]const u8 = undefined;
+    var length: usize = undefined;
+
+    const err1 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), err1);
+    try testing.expectEqualStrings("abc", record[0..length]);
+
+    const err2 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), err2);
+    try testing.expectEqual(0, length);
+    try testing.expect(lib.gci_reader_eof(reader));
+}
+
+test "read until empty spill" {
+    const data = "a";
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderFail = undefined;
+    const init_err = lib.gci_reader_fail_init(&context, lib.gci_reader_string_interface(&c), 100);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const reader = lib.gci_reader_fail_interface(&context);
+
+    var spill: [2]u8 = undefined;
+    var record: [*c]const u8 = undefined;
+    var length: usize = undefined;
+
+    const err1 = lib.gci_reader_read_until(reader, '\n', &spill, 0, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), err1);
+    try testing.expectEqual(0, length);
+
+    const err2 = lib.gci_reader_read_until(reader, '\n', &spill, spill.len, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), err2);
+    try testing.expectEqualStrings("a", record[0..length]);
+
+    const err3 = lib.gci_reader_read_until(reader, '\n', &spill, 0, &record, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), err3);
+    try testing.expectEqual(0, length);
+}
+
 test "double buffer init" {
     const data = "";
     var c: lib.GciReaderString = undefined;
@@ -0,0 +1,148 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <string.h>
+#include <gci_shared.h>
+
+bool gci_writer_shared_append(struct GciWriterShared *context, struct GciIovec const *vectors, size_t vector_count);
+size_t gci_writer_shared_buffer_write(void const *void_context, char const *data, size_t data_size);
+size_t gci_writer_shared_buffer_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count);
+char *gci_writer_shared_buffer_reserve(void const *void_context, size_t size);
+size_t gci_writer_shared_buffer_commit(void const *void_context, size_t size);
+
+enum GciError gci_writer_shared_init(struct GciWriterShared *context, struct GciInterfaceWriter writer) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->writer = writer;
+    context->error = false;
+    if (pthread_mutex_init(&context->mutex, NULL) != 0) { return GCI_ERROR_IO; }
+
+    return GCI_ERROR_OK;
+}
+
+void gci_writer_shared_deinit(struct GciWriterShared *context) {
+    assert(context != NULL);
+    pthread_mutex_destroy(&context->mutex);
+}
+
+// Writes the pieces to the internal writer without any other thread
+// writing in between. Once a write has failed nothing more is written.
+bool gci_writer_shared_append(struct GciWriterShared *context, struct GciIovec const *vectors, size_t vector_count) {
+    assert(context != NULL);
+
+    size_t total = 0;
+    for (size_t index = 0; index < vector_count; index++) {
+        total += vectors[index].data_size;
+    }
+
+    pthread_mutex_lock(&context->mutex);
+    bool success = !context->error;
+    if (success) {
+        success = gci_writer_writev(context->writer, vectors, vector_count) == total;
+        // Also read without the lock by the buffers of other threads
+        __atomic_store_n(&context->error, !success, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&context->mutex);
+
+    return success;
+}
+
+enum GciError gci_writer_shared_buffer_init(
+    struct GciWriterSharedBuffer *context,
+    struct GciWriterShared *shared,
+    char *buffer,
+    size_t buffer_size
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (shared == NULL) { return GCI_ERROR_NULL; }
+    if (buffer == NULL) { return GCI_ERROR_NULL; }
+    if (buffer_size == 0) { return GCI_ERROR_BUFFER; }
+
+    context->shared = shared;
+    context->buffer = buffer;
+    context->buffer_size = buffer_size;
+    context->current = 0;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceWriter gci_writer_shared_buffer_interface(struct GciWriterSharedBuffer *context) {
+    return (struct GciInterfaceWriter) {
+        .context = context,
+        .write = gci_writer_shared_buffer_write,
+        .reserve = gci_writer_shared_buffer_reserve,
+        .commit = gci_writer_shared_buffer_commit,
+        .writev = gci_writer_shared_buffer_writev,
+    };
+}
+
+size_t gci_writer_shared_buffer_write(void const *void_context, char const *data, size_t data_size) {
+    assert(data != NULL);
+    struct GciIovec vector = { .data = data, .data_size = data_size };
+    return gci_writer_shared_buffer_writev(void_context, &vector, 1);
+}
+
+size_t gci_writer_shared_buffer_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count) {
+    assert(void_context != NULL);
+    assert(vectors != NULL || vector_count == 0);
+    struct GciWriterSharedBuffer *context = (struct GciWriterSharedBuffer*) void_context;
+
+    if (__atomic_load_n(&context->shared->error, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+
+    size_t total = 0;
+    for (size_t index = 0; index < vector_count; index++) {
+        total += vectors[index].data_size;
+    }
+
+    if (total > context->buffer_size - context->current) {
+        if (!gci_writer_shared_buffer_flush(context)) { return 0; }
+    }
+
+    // A record which can never fit is written as it is, still as a whole
+    if (total > context->buffer_size) {
+        return gci_writer_shared_append(context->shared, vectors, vector_count) ? total : 0;
+    }
+
+    for (size_t index = 0; index < vector_count; index++) {
+        memcpy(context->buffer + context->current, vectors[index].data, vectors[index].data_size);
+        context->current += vectors[index].data_size;
+    }
+    return total;
+}
+
+char *gci_writer_shared_buffer_reserve(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterSharedBuffer *context = (struct GciWriterSharedBuffer*) void_context;
+
+    if (__atomic_load_n(&context->shared->error, __ATOMIC_RELAXED)) { return NULL; }
+    if (size > context->buffer_size) { return NULL; }
+    if (size > context->buffer_size - context->current) {
+        if (!gci_writer_shared_buffer_flush(context)) { return NULL; }
+    }
+
+    return context->buffer + context->current;
+}
+
+size_t gci_writer_shared_buffer_commit(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterSharedBuffer *context = (struct GciWriterSharedBuffer*) void_context;
+
+    assert(size <= context->buffer_size - context->current);
+    context->current += size;
+    return size;
+}
+
+bool gci_writer_shared_buffer_flush(struct GciWriterSharedBuffer *context) {
+    assert(context != NULL);
+    if (context->current == 0) { return true; }
+
+    struct GciIovec vector = { .data = context->buffer, .data_size = context->current };
+    if (!gci_writer_shared_append(context->shared, &vector, 1)) {
+        return false;
+    }
+
+    context->current = 0;
+    return true;
+}
@@ -0,0 +1,116 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const writer = @import("../writer/writer.zig");
+const InterfaceWriter = writer.InterfaceWriter;
+
+pub const Writer = struct {
+    inner: lib.GciWriterShared,
+
+    // Holds the lock taken by every thread writing through it, so it is
+    // initialized in place and must not move until `deinit`.
+    pub fn init(self: *Writer, w: InterfaceWriter) !void {
+        const err = lib.gci_writer_shared_init(&self.inner, w.writer);
+        try internal.enumToError(err);
+    }
+
+    pub fn deinit(self: *Writer) void {
+        lib.gci_writer_shared_deinit(&self.inner);
+    }
+};
+
+pub const Buffer = struct {
+    inner: lib.GciWriterSharedBuffer,
+
+    pub fn init(shared: *Writer, buffer: []u8) !Buffer {
+        var self: Buffer = undefined;
+        const err = lib.gci_writer_shared_buffer_init(&self.inner, &shared.inner, buffer.ptr, buffer.len);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Buffer) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_shared_buffer_interface(&self.inner) };
+    }
+
+    pub fn flush(self: *Buffer) !void {
+        const result = lib.gci_writer_shared_buffer_flush(&self.inner);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_shared.zig");
+}
+
+test "records" {
+    var b: [16]u8 = undefined;
+    var c = try writer.String.init(&b);
+
+    var shared: Writer = undefined;
+    try shared.init(c.interface());
+    defer shared.deinit();
+
+    var buffer1: [4]u8 = undefined;
+    var context1 = try Buffer.init(&shared, &buffer1);
+    var buffer2: [4]u8 = undefined;
+    var context2 = try Buffer.init(&shared, &buffer2);
+
+    try context1.interface().write("ab");
+    try context2.interface().write("xy");
+    try context1.interface().write("cd");
+    try testing.expectEqual(0, c.inner.current);
+
+    // Does not fit behind "abcd", which is appended first
+    try context1.interface().write("ef");
+    try testing.expectEqualStrings("abcd", b[0..c.inner.current]);
+
+    try context2.interface().write("123456");
+    try testing.expectEqualStrings("abcdxy123456", b[0..c.inner.current]);
+
+    try context1.flush();
+    try testing.expectEqualStrings("abcdxy123456ef", b[0..c.inner.current]);
+}
+
+test "threads" {
+    var b: [4 * 1000 * 8]u8 = undefined;
+    var c = try writer.String.init(&b);
+
+    var shared: Writer = undefined;
+    try shared.init(c.interface());
+    defer shared.deinit();
+
+    const Worker = struct {
+        fn run(s: *Writer, id: u8) !void {
+            var buffer: [64]u8 = undefined;
+            var context = try Buffer.init(s, &buffer);
+            const w = context.interface();
+            for (0..1000) |_| {
+                try w.write(&[_]u8{ id, id, id, id, id, id, id, '\n' });
+            }
+            try context.flush();
+        }
+    };
+
+    var threads: [4]std.Thread = undefined;
+    for (&threads, 0..) |*thread, i| {
+        thread.* = try std.Thread.spawn(.{}, Worker.run, .{ &shared, @as(u8, @intCast('a' + i)) });
+    }
+    for (threads) |thread| {
+        thread.join();
+    }
+
+    try testing.expectEqual(b.len, c.inner.current);
+    var index: usize = 0;
+    while (index < b.len) : (index += 8) {
+        const record = b[index .. index + 8];
+        try testing.expectEqual('\n', record[7]);
+        for (record[1..7]) |byte| {
+            try testing.expectEqual(record[0], byte);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "init null" {
+    var b: [4]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&c, &b, b.len);
+
+    const init_err1 = lib.gci_writer_shared_init(null, lib.gci_writer_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err1);
+
+    var shared: lib.GciWriterShared = undefined;
+    const init_err2 = lib.gci_writer_shared_init(&shared, lib.gci_writer_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err2);
+    defer lib.gci_writer_shared_deinit(&shared);
+
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciWriterSharedBuffer = undefined;
+    const init_err3 = lib.gci_writer_shared_buffer_init(&context, null, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err3);
+
+    const init_err4 = lib.gci_writer_shared_buffer_init(&context, &shared, null, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err4);
+
+    const init_err5 = lib.gci_writer_shared_buffer_init(&context, &shared, &buffer, 0);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err5);
+}
+
+test "write" {
+    var b: [6]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&c, &b, b.len);
+
+    var shared: lib.GciWriterShared = undefined;
+    const init_err1 = lib.gci_writer_shared_init(&shared, lib.gci_writer_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err1);
+    defer lib.gci_writer_shared_deinit(&shared);
+
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciWriterSharedBuffer = undefined;
+    const init_err2 = lib.gci_writer_shared_buffer_init(&context, &shared, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err2);
+    const writer = lib.gci_writer_shared_buffer_interface(&context);
+
+    const res1 = lib.gci_writer_write(writer, "123", 3);
+    try testing.expectEqual(3, res1);
+    try testing.expectEqual(0, c.current);
+
+    const reserved = lib.gci_writer_reserve(writer, 2, null, 0);
+    try testing.expect(reserved != null);
+    try testing.expectEqual(3, c.current);
+    @memcpy(reserved[0..2], "45");
+    const res2 = lib.gci_writer_commit(writer, reserved, 2, null);
+    try testing.expectEqual(2, res2);
+
+    const flush_res1 = lib.gci_writer_shared_buffer_flush(&context);
+    try testing.expect(flush_res1);
+    try testing.expectEqualStrings("12345", b[0..5]);
+
+    // The internal writer only has room for one more byte
+    const res3 = lib.gci_writer_write(writer, "67", 2);
+    try testing.expectEqual(2, res3);
+
+    const flush_res2 = lib.gci_writer_shared_buffer_flush(&context);
+    try testing.expect(!flush_res2);
+
+    // The failed records are kept and nothing more is accepted
+    try testing.expectEqual(2, context.current);
+    const res4 = lib.gci_writer_write(writer, "89", 2);
+    try testing.expectEqual(0, res4);
+    try testing.expect(lib.gci_writer_reserve(writer, 1, null, 0) == null);
+    const flush_res3 = lib.gci_writer_shared_buffer_flush(&context);
+    try testing.expect(!flush_res3);
+}
+
+test "write threads" {
+    const thread_count = 6;
+    const record_count = 500;
+    const record_size = 8;
+
+    var b: [thread_count * record_count * record_size]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&c, &b, b.len);
+
+    var shared: lib.GciWriterShared = undefined;
+    const init_err = lib.gci_writer_shared_init(&shared, lib.gci_writer_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_writer_shared_deinit(&shared);
+
+    const Worker = struct {
+        fn run(s: *lib.GciWriterShared, id: u8) !void {
+            // Not a multiple of the record size so buffers hand over
+            // at different points in every thread
+            var buffer: [60]u8 = undefined;
+            var context: lib.GciWriterSharedBuffer = undefined;
+            const err = lib.gci_writer_shared_buffer_init(&context, s, &buffer, buffer.len);
+            try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), err);
+            const writer = lib.gci_writer_shared_buffer_interface(&context);
+
+            for (0..record_count) |sequence| {
+                var record: [record_size]u8 = undefined;
+                _ = try std.fmt.bufPrint(&record, "{c}{d:0>6}\n", .{ id, sequence });
+                const result = lib.gci_writer_write(writer, &record, record.len);
+                try testing.expectEqual(record.len, result);
+            }
+            try testing.expect(lib.gci_writer_shared_buffer_flush(&context));
+        }
+    };
+
+    var threads: [thread_count]std.Thread = undefined;
+    for (&threads, 0..) |*thread, i| {
+        thread.* = try std.Thread.spawn(.{}, Worker.run, .{ &shared, @as(u8, @intCast('a' + i)) });
+    }
+    for (threads) |thread| {
+        thread.join();
+    }
+
+    // Every record is whole and each thread's records keep their order
+    try testing.expectEqual(b.len, c.current);
+    var next = [_]usize{0} ** thread_count;
+    var index: usize = 0;
+    while (index < b.len) : (index += record_size) {
+        const record = b[index .. index + record_size];
+        try testing.expectEqual('\n', record[record_size - 1]);
+
+        const id = record[0] - 'a';
+        try testing.expect(id < thread_count);
+        const sequence = try std.fmt.parseInt(usize, record[1 .. record_size - 1], 10);
+        try testing.expectEqual(next[id], sequence);
+        next[id] += 1;
+    }
+    for (next) |count| {
+        try testing.expectEqual(record_count, count);
+    }
+}
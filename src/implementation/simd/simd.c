@@ -0,0 +1,133 @@
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <gci_simd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GCI_SIMD_X86
+#include <immintrin.h>
+#endif
+
+typedef char const *(GciFindByte)(char const *data, size_t data_size, char byte);
+
+char const *gci_find_byte_scalar(char const *data, size_t data_size, char byte);
+#ifdef GCI_SIMD_X86
+char const *gci_find_byte_sse2(char const *data, size_t data_size, char byte);
+char const *gci_find_byte_avx2(char const *data, size_t data_size, char byte);
+#endif
+GciFindByte *gci_find_byte_kernel(enum GciSimd simd);
+
+// Resolved on first use, racing threads resolve it to the same value
+GciFindByte *gci_find_byte_best = NULL;
+
+enum GciSimd gci_simd_supported(void) {
+#ifdef GCI_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        return __builtin_cpu_supports("avx2") ? GCI_SIMD_AVX2 : GCI_SIMD_SSE42;
+    }
+    if (__builtin_cpu_supports("sse2")) { return GCI_SIMD_SSE2; }
+#endif
+    return GCI_SIMD_SCALAR;
+}
+
+char const *gci_find_byte(char const *data, size_t data_size, char byte) {
+    GciFindByte *kernel = __atomic_load_n(&gci_find_byte_best, __ATOMIC_RELAXED);
+    if (kernel == NULL) {
+        kernel = gci_find_byte_kernel(gci_simd_supported());
+        __atomic_store_n(&gci_find_byte_best, kernel, __ATOMIC_RELAXED);
+    }
+    return kernel(data, data_size, byte);
+}
+
+char const *gci_find_byte_simd(enum GciSimd simd, char const *data, size_t data_size, char byte) {
+    enum GciSimd supported = gci_simd_supported();
+    return gci_find_byte_kernel(simd < supported ? simd : supported)(data, data_size, byte);
+}
+
+GciFindByte *gci_find_byte_kernel(enum GciSimd simd) {
+    switch (simd) {
+#ifdef GCI_SIMD_X86
+        case GCI_SIMD_AVX2:
+            return gci_find_byte_avx2;
+        case GCI_SIMD_SSE42:
+        case GCI_SIMD_SSE2:
+            return gci_find_byte_sse2;
+#endif
+        default:
+            return gci_find_byte_scalar;
+    }
+}
+
+// Checks a word at a time for a zero byte in `word ^ pattern`, the classic
+// has-zero-byte trick, and only then looks for the exact position.
+char const *gci_find_byte_scalar(char const *data, size_t data_size, char byte) {
+    assert(data != NULL || data_size == 0);
+
+    uint64_t const ones = UINT64_C(0x0101010101010101);
+    uint64_t const highs = UINT64_C(0x8080808080808080);
+    uint64_t const pattern = ones * (unsigned char) byte;
+
+    size_t index = 0;
+    for (; index + sizeof(uint64_t) <= data_size; index += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + index, sizeof(word));
+        word ^= pattern;
+        if (((word - ones) & ~word & highs) != 0) { break; }
+    }
+
+    for (; index < data_size; index++) {
+        if (data[index] == byte) { return data + index; }
+    }
+    return NULL;
+}
+
+#ifdef GCI_SIMD_X86
+__attribute__((target("sse2")))
+char const *gci_find_byte_sse2(char const *data, size_t data_size, char byte) {
+    assert(data != NULL || data_size == 0);
+    __m128i const needle = _mm_set1_epi8(byte);
+
+    size_t index = 0;
+    for (; index + 16 <= data_size; index += 16) {
+        __m128i chunk = _mm_loadu_si128((__m128i const*) (data + index));
+        unsigned mask = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+        if (mask != 0) { return data + index + __builtin_ctz(mask); }
+    }
+
+    for (; index < data_size; index++) {
+        if (data[index] == byte) { return data + index; }
+    }
+    return NULL;
+}
+
+__attribute__((target("avx2")))
+char const *gci_find_byte_avx2(char const *data, size_t data_size, char byte) {
+    assert(data != NULL || data_size == 0);
+    __m256i const needle = _mm256_set1_epi8(byte);
+
+    // Two vectors per iteration, the exact position is only computed once
+    // either of them matches
+    size_t index = 0;
+    for (; index + 64 <= data_size; index += 64) {
+        __m256i chunk1 = _mm256_loadu_si256((__m256i const*) (data + index));
+        __m256i chunk2 = _mm256_loadu_si256((__m256i const*) (data + index + 32));
+        __m256i equal1 = _mm256_cmpeq_epi8(chunk1, needle);
+        __m256i equal2 = _mm256_cmpeq_epi8(chunk2, needle);
+        if (_mm256_movemask_epi8(_mm256_or_si256(equal1, equal2)) != 0) {
+            unsigned mask1 = (unsigned) _mm256_movemask_epi8(equal1);
+            if (mask1 != 0) { return data + index + __builtin_ctz(mask1); }
+            unsigned mask2 = (unsigned) _mm256_movemask_epi8(equal2);
+            return data + index + 32 + __builtin_ctz(mask2);
+        }
+    }
+
+    for (; index + 32 <= data_size; index += 32) {
+        __m256i chunk = _mm256_loadu_si256((__m256i const*) (data + index));
+        unsigned mask = (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+        if (mask != 0) { return data + index + __builtin_ctz(mask); }
+    }
+
+    return gci_find_byte_sse2(data + index, data_size - index, byte);
+}
+#endif
@@ -0,0 +1,69 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+
+pub const Simd = enum(c_uint) {
+    scalar = lib.GCI_SIMD_SCALAR,
+    sse2 = lib.GCI_SIMD_SSE2,
+    sse42 = lib.GCI_SIMD_SSE42,
+    avx2 = lib.GCI_SIMD_AVX2,
+};
+
+pub fn supported() Simd {
+    return @enumFromInt(lib.gci_simd_supported());
+}
+
+// Returns the index of the first occurrence of `byte` in `data`.
+pub fn findByte(data: []const u8, byte: u8) ?usize {
+    const found = lib.gci_find_byte(data.ptr, data.len, byte);
+    if (found == null) {
+        return null;
+    }
+    return @intFromPtr(found) - @intFromPtr(data.ptr);
+}
+
+pub fn findByteSimd(simd: Simd, data: []const u8, byte: u8) ?usize {
+    const found = lib.gci_find_byte_simd(@intFromEnum(simd), data.ptr, data.len, byte);
+    if (found == null) {
+        return null;
+    }
+    return @intFromPtr(found) - @intFromPtr(data.ptr);
+}
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_simd.zig");
+}
+
+test "find byte empty" {
+    const data: []const u8 = "";
+    try testing.expectEqual(null, findByte(data, 'a'));
+}
+
+test "find byte" {
+    try testing.expectEqual(3, findByte("abcdef", 'd'));
+    try testing.expectEqual(null, findByte("abcdef", 'x'));
+}
+
+test "find byte every level" {
+    var data: [160]u8 = undefined;
+    for (&data, 0..) |*byte, index| {
+        byte.* = @truncate(index % 251 + 1);
+    }
+
+    inline for (std.meta.fields(Simd)) |field| {
+        const simd: Simd = @enumFromInt(field.value);
+        for (0..data.len) |position| {
+            const saved = data[position];
+            data[position] = 0;
+            for ([_]usize{ 0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100 }) |start| {
+                if (start > data.len) continue;
+                const slice = data[start..];
+                const expected = std.mem.indexOfScalar(u8, slice, 0);
+                try testing.expectEqual(expected, findByteSimd(simd, slice, 0));
+            }
+            data[position] = saved;
+        }
+    }
+}
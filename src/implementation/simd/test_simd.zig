@@ -0,0 +1,31 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "supported" {
+    const simd = lib.gci_simd_supported();
+    try testing.expect(simd <= lib.GCI_SIMD_AVX2);
+}
+
+test "find byte" {
+    const data = "0123456789abcdef0123456789abcdef0123456789";
+    const found = lib.gci_find_byte(data, data.len, 'f');
+    try testing.expectEqual(@as([*c]const u8, data[15..]), found);
+}
+
+test "find byte missing" {
+    const data = "0123456789abcdef0123456789abcdef0123456789";
+    const found = lib.gci_find_byte(data, data.len, 'x');
+    try testing.expectEqual(null, found);
+}
+
+test "find byte empty" {
+    const found = lib.gci_find_byte(null, 0, 'x');
+    try testing.expectEqual(null, found);
+}
+
+test "find byte unsupported level" {
+    const data = "abc";
+    const found = lib.gci_find_byte_simd(lib.GCI_SIMD_AVX2, data, data.len, 'c');
+    try testing.expectEqual(@as([*c]const u8, data[2..]), found);
+}
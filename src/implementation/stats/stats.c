@@ -0,0 +1,215 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <time.h>
+#include <gci_stats.h>
+
+size_t gci_reader_stats_read(void const *context, char *buffer, size_t buffer_size);
+bool gci_reader_stats_eof(void const *context);
+size_t gci_reader_stats_peek(void const *context, char const **data);
+void gci_reader_stats_consume(void const *context, size_t amount);
+size_t gci_reader_stats_read_at(void const *context, char *buffer, size_t buffer_size, uint64_t offset);
+size_t gci_writer_stats_write(void const *context, char const *data, size_t data_size);
+char *gci_writer_stats_reserve(void const *context, size_t size);
+size_t gci_writer_stats_commit(void const *context, size_t size);
+size_t gci_writer_stats_writev(void const *context, struct GciIovec const *vectors, size_t vector_count);
+uint64_t gci_stats_now(void);
+void gci_stats_record(struct GciStats *stats, uint64_t start, size_t bytes, bool short_call);
+void gci_stats_snapshot(struct GciStats const *stats, struct GciStats *snapshot);
+
+enum GciError gci_reader_stats_init(struct GciReaderStats *context, struct GciInterfaceReader reader) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->reader = reader;
+    context->stats = (struct GciStats) { 0 };
+    context->eof = false;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceReader gci_reader_stats_interface(struct GciReaderStats *context) {
+    assert(context != NULL);
+    bool peek = context->reader.peek != NULL;
+    return (struct GciInterfaceReader) {
+        .context = context,
+        .read = gci_reader_stats_read,
+        .eof = gci_reader_stats_eof,
+        .peek = peek ? gci_reader_stats_peek : NULL,
+        .consume = peek ? gci_reader_stats_consume : NULL,
+        .read_at = context->reader.read_at != NULL ? gci_reader_stats_read_at : NULL,
+    };
+}
+
+void gci_reader_stats_snapshot(struct GciReaderStats const *context, struct GciStats *snapshot) {
+    assert(context != NULL);
+    gci_stats_snapshot(&context->stats, snapshot);
+}
+
+size_t gci_reader_stats_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    struct GciReaderStats *context = (struct GciReaderStats*) void_context;
+
+    uint64_t start = gci_stats_now();
+    size_t length = gci_reader_read(context->reader, buffer, buffer_size);
+    gci_stats_record(&context->stats, start, length, length < buffer_size);
+
+    // A short read is the only way a reader reaches eof
+    if (length < buffer_size) {
+        gci_reader_stats_eof(context);
+    }
+    return length;
+}
+
+bool gci_reader_stats_eof(void const *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderStats *context = (struct GciReaderStats*) void_context;
+
+    bool eof = gci_reader_eof(context->reader);
+    if (eof && !context->eof) {
+        __atomic_fetch_add(&context->stats.eof_transitions, 1, __ATOMIC_RELAXED);
+    }
+    context->eof = eof;
+    return eof;
+}
+
+size_t gci_reader_stats_peek(void const *void_context, char const **data) {
+    assert(void_context != NULL);
+    struct GciReaderStats *context = (struct GciReaderStats*) void_context;
+
+    // Bytes are counted once consumed
+    uint64_t start = gci_stats_now();
+    size_t length = context->reader.peek(context->reader.context, data);
+    gci_stats_record(&context->stats, start, 0, length == 0);
+
+    if (length == 0) {
+        gci_reader_stats_eof(context);
+    }
+    return length;
+}
+
+void gci_reader_stats_consume(void const *void_context, size_t amount) {
+    assert(void_context != NULL);
+    struct GciReaderStats *context = (struct GciReaderStats*) void_context;
+
+    context->reader.consume(context->reader.context, amount);
+    __atomic_fetch_add(&context->stats.bytes, amount, __ATOMIC_RELAXED);
+}
+
+size_t gci_reader_stats_read_at(void const *void_context, char *buffer, size_t buffer_size, uint64_t offset) {
+    assert(void_context != NULL);
+    struct GciReaderStats *context = (struct GciReaderStats*) void_context;
+
+    // Counted like a read but a short result is not eof of the reader
+    uint64_t start = gci_stats_now();
+    size_t length = gci_reader_read_at(context->reader, buffer, buffer_size, offset);
+    gci_stats_record(&context->stats, start, length, length < buffer_size);
+    return length;
+}
+
+enum GciError gci_writer_stats_init(struct GciWriterStats *context, struct GciInterfaceWriter writer) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->writer = writer;
+    context->stats = (struct GciStats) { 0 };
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceWriter gci_writer_stats_interface(struct GciWriterStats *context) {
+    assert(context != NULL);
+    bool reserve = context->writer.reserve != NULL;
+    bool writev = context->writer.writev != NULL;
+    return (struct GciInterfaceWriter) {
+        .context = context,
+        .write = gci_writer_stats_write,
+        .reserve = reserve ? gci_writer_stats_reserve : NULL,
+        .commit = reserve ? gci_writer_stats_commit : NULL,
+        .writev = writev ? gci_writer_stats_writev : NULL,
+    };
+}
+
+void gci_writer_stats_snapshot(struct GciWriterStats const *context, struct GciStats *snapshot) {
+    assert(context != NULL);
+    gci_stats_snapshot(&context->stats, snapshot);
+}
+
+size_t gci_writer_stats_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    struct GciWriterStats *context = (struct GciWriterStats*) void_context;
+
+    uint64_t start = gci_stats_now();
+    size_t length = gci_writer_write(context->writer, data, data_size);
+    gci_stats_record(&context->stats, start, length, length < data_size);
+
+    return length;
+}
+
+char *gci_writer_stats_reserve(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterStats *context = (struct GciWriterStats*) void_context;
+    return context->writer.reserve(context->writer.context, size);
+}
+
+size_t gci_writer_stats_commit(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterStats *context = (struct GciWriterStats*) void_context;
+
+    uint64_t start = gci_stats_now();
+    size_t length = context->writer.commit(context->writer.context, size);
+    gci_stats_record(&context->stats, start, length, length < size);
+
+    return length;
+}
+
+size_t gci_writer_stats_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count) {
+    assert(void_context != NULL);
+    struct GciWriterStats *context = (struct GciWriterStats*) void_context;
+
+    size_t total = 0;
+    for (size_t index = 0; index < vector_count; index++) {
+        total += vectors[index].data_size;
+    }
+
+    uint64_t start = gci_stats_now();
+    size_t length = gci_writer_writev(context->writer, vectors, vector_count);
+    gci_stats_record(&context->stats, start, length, length < total);
+
+    return length;
+}
+
+uint64_t gci_stats_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+}
+
+void gci_stats_record(struct GciStats *stats, uint64_t start, size_t bytes, bool short_call) {
+    assert(stats != NULL);
+    uint64_t elapsed = gci_stats_now() - start;
+
+    size_t bucket = 0;
+    if (elapsed != 0) {
+        bucket = (size_t) (63 - __builtin_clzll(elapsed));
+        bucket = bucket < GCI_STATS_BUCKETS ? bucket : GCI_STATS_BUCKETS - 1;
+    }
+
+    __atomic_fetch_add(&stats->calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->bytes, bytes, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->latency[bucket], 1, __ATOMIC_RELAXED);
+    if (short_call) {
+        __atomic_fetch_add(&stats->short_calls, 1, __ATOMIC_RELAXED);
+    }
+}
+
+void gci_stats_snapshot(struct GciStats const *stats, struct GciStats *snapshot) {
+    assert(stats != NULL);
+    assert(snapshot != NULL);
+
+    snapshot->calls = __atomic_load_n(&stats->calls, __ATOMIC_RELAXED);
+    snapshot->bytes = __atomic_load_n(&stats->bytes, __ATOMIC_RELAXED);
+    snapshot->short_calls = __atomic_load_n(&stats->short_calls, __ATOMIC_RELAXED);
+    snapshot->eof_transitions = __atomic_load_n(&stats->eof_transitions, __ATOMIC_RELAXED);
+    for (size_t bucket = 0; bucket < GCI_STATS_BUCKETS; bucket++) {
+        snapshot->latency[bucket] = __atomic_load_n(&stats->latency[bucket], __ATOMIC_RELAXED);
+    }
+}
@@ -0,0 +1,96 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const reader = @import("../reader/reader.zig");
+const writer = @import("../writer/writer.zig");
+const InterfaceReader = reader.InterfaceReader;
+const InterfaceWriter = writer.InterfaceWriter;
+
+pub const Stats = lib.GciStats;
+
+pub const Reader = struct {
+    inner: lib.GciReaderStats,
+
+    pub fn init(r: InterfaceReader) !Reader {
+        var self: Reader = undefined;
+        const err = lib.gci_reader_stats_init(&self.inner, r.reader);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Reader) InterfaceReader {
+        return .{ .reader = lib.gci_reader_stats_interface(&self.inner) };
+    }
+
+    pub fn snapshot(self: *const Reader) Stats {
+        var result: Stats = undefined;
+        lib.gci_reader_stats_snapshot(&self.inner, &result);
+        return result;
+    }
+};
+
+pub const Writer = struct {
+    inner: lib.GciWriterStats,
+
+    pub fn init(w: InterfaceWriter) !Writer {
+        var self: Writer = undefined;
+        const err = lib.gci_writer_stats_init(&self.inner, w.writer);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Writer) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_stats_interface(&self.inner) };
+    }
+
+    pub fn snapshot(self: *const Writer) Stats {
+        var result: Stats = undefined;
+        lib.gci_writer_stats_snapshot(&self.inner, &result);
+        return result;
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_stats.zig");
+}
+
+test "reader stats" {
+    var s = try reader.String.init("12345");
+    var context = try Reader.init(s.interface());
+    const r = context.interface();
+
+    var buffer: [3]u8 = undefined;
+    _ = try r.read(&buffer);
+    _ = try r.read(&buffer);
+    try testing.expect(r.eof());
+
+    const result = context.snapshot();
+    try testing.expectEqual(2, result.calls);
+    try testing.expectEqual(5, result.bytes);
+    try testing.expectEqual(1, result.short_calls);
+    try testing.expectEqual(1, result.eof_transitions);
+
+    var calls: u64 = 0;
+    for (result.latency) |count| {
+        calls += count;
+    }
+    try testing.expectEqual(2, calls);
+}
+
+test "writer stats" {
+    var buffer: [3]u8 = undefined;
+    var s = try writer.String.init(&buffer);
+    var context = try Writer.init(s.interface());
+    const w = context.interface();
+
+    try w.write("12");
+    try testing.expectError(error.Writer, w.write("34"));
+
+    const result = context.snapshot();
+    try testing.expectEqual(2, result.calls);
+    try testing.expectEqual(3, result.bytes);
+    try testing.expectEqual(1, result.short_calls);
+    try testing.expectEqual(0, result.eof_transitions);
+}
@@ -0,0 +1,211 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+fn latencyCalls(stats: lib.GciStats) u64 {
+    var calls: u64 = 0;
+    for (stats.latency) |count| {
+        calls += count;
+    }
+    return calls;
+}
+
+test "reader init" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "1", 1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderStats = undefined;
+    const init_err = lib.gci_reader_stats_init(&context, lib.gci_reader_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    _ = lib.gci_reader_stats_interface(&context);
+}
+
+test "reader init null" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "1", 1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    const init_err = lib.gci_reader_stats_init(null, lib.gci_reader_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "reader read" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "12345", 5);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderStats = undefined;
+    const init_err = lib.gci_reader_stats_init(&context, lib.gci_reader_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const reader = lib.gci_reader_stats_interface(&context);
+
+    var buffer: [3]u8 = undefined;
+    const length1 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(3, length1);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    var stats: lib.GciStats = undefined;
+    lib.gci_reader_stats_snapshot(&context, &stats);
+    try testing.expectEqual(1, stats.calls);
+    try testing.expectEqual(3, stats.bytes);
+    try testing.expectEqual(0, stats.short_calls);
+    try testing.expectEqual(0, stats.eof_transitions);
+
+    const length2 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(2, length2);
+    try testing.expect(lib.gci_reader_eof(reader));
+
+    lib.gci_reader_stats_snapshot(&context, &stats);
+    try testing.expectEqual(2, stats.calls);
+    try testing.expectEqual(5, stats.bytes);
+    try testing.expectEqual(1, stats.short_calls);
+    try testing.expectEqual(1, stats.eof_transitions);
+    try testing.expectEqual(2, latencyCalls(stats));
+}
+
+test "reader peek" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "123", 3);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderStats = undefined;
+    const init_err = lib.gci_reader_stats_init(&context, lib.gci_reader_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const reader = lib.gci_reader_stats_interface(&context);
+    try testing.expect(reader.peek != null);
+
+    var data: [*c]const u8 = undefined;
+    const length = lib.gci_reader_peek(reader, &data, null, 0);
+    try testing.expectEqual(3, length);
+    lib.gci_reader_consume(reader, length, 2);
+
+    var stats: lib.GciStats = undefined;
+    lib.gci_reader_stats_snapshot(&context, &stats);
+    try testing.expectEqual(1, stats.calls);
+    try testing.expectEqual(2, stats.bytes);
+}
+
+test "reader read at" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "12345", 5);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciReaderStats = undefined;
+    const init_err = lib.gci_reader_stats_init(&context, lib.gci_reader_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const reader = lib.gci_reader_stats_interface(&context);
+    try testing.expect(reader.read_at != null);
+
+    var buffer: [2]u8 = undefined;
+    const length1 = lib.gci_reader_read_at(reader, &buffer, buffer.len, 1);
+    try testing.expectEqual(2, length1);
+    try testing.expectEqualStrings("23", &buffer);
+
+    const length2 = lib.gci_reader_read_at(reader, &buffer, buffer.len, 4);
+    try testing.expectEqual(1, length2);
+    try testing.expectEqualStrings("5", buffer[0..1]);
+
+    var stats: lib.GciStats = undefined;
+    lib.gci_reader_stats_snapshot(&context, &stats);
+    try testing.expectEqual(2, stats.calls);
+    try testing.expectEqual(3, stats.bytes);
+    try testing.expectEqual(1, stats.short_calls);
+    try testing.expectEqual(0, stats.eof_transitions);
+}
+
+test "reader without peek" {
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "123", 3);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var f: lib.GciReaderFail = undefined;
+    const f_err = lib.gci_reader_fail_init(&f, lib.gci_reader_string_interface(&c), 1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), f_err);
+
+    var context: lib.GciReaderStats = undefined;
+    const init_err = lib.gci_reader_stats_init(&context, lib.gci_reader_fail_interface(&f));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const reader = lib.gci_reader_stats_interface(&context);
+    try testing.expect(reader.peek == null);
+    try testing.expect(reader.consume == null);
+}
+
+test "writer init null" {
+    var buffer: [1]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    const init_err = lib.gci_writer_stats_init(null, lib.gci_writer_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "writer write" {
+    var buffer: [4]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciWriterStats = undefined;
+    const init_err = lib.gci_writer_stats_init(&context, lib.gci_writer_string_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_stats_interface(&context);
+    try testing.expect(writer.writev == null);
+
+    const res1 = lib.gci_writer_write(writer, "12", 2);
+    try testing.expectEqual(2, res1);
+
+    const reserved = lib.gci_writer_reserve(writer, 1, null, 0);
+    try testing.expect(reserved != null);
+    reserved[0] = '3';
+    const res2 = lib.gci_writer_commit(writer, reserved, 1, null);
+    try testing.expectEqual(1, res2);
+
+    const res3 = lib.gci_writer_write(writer, "45", 2);
+    try testing.expectEqual(1, res3);
+    try testing.expectEqualStrings("1234", &buffer);
+
+    var stats: lib.GciStats = undefined;
+    lib.gci_writer_stats_snapshot(&context, &stats);
+    try testing.expectEqual(3, stats.calls);
+    try testing.expectEqual(4, stats.bytes);
+    try testing.expectEqual(1, stats.short_calls);
+    try testing.expectEqual(3, latencyCalls(stats));
+}
+
+test "writer writev" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+    defer std.posix.close(fds[1]);
+
+    var c: lib.GciWriterFd = undefined;
+    const i_err = lib.gci_writer_fd_init(&c, fds[1]);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var context: lib.GciWriterStats = undefined;
+    const init_err = lib.gci_writer_stats_init(&context, lib.gci_writer_fd_interface(&c));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_stats_interface(&context);
+    try testing.expect(writer.writev != null);
+
+    const vectors = [_]lib.GciIovec{
+        .{ .data = "1", .data_size = 1 },
+        .{ .data = "23", .data_size = 2 },
+    };
+    const res = lib.gci_writer_writev(writer, &vectors, vectors.len);
+    try testing.expectEqual(3, res);
+
+    var stats: lib.GciStats = undefined;
+    lib.gci_writer_stats_snapshot(&context, &stats);
+    try testing.expectEqual(1, stats.calls);
+    try testing.expectEqual(3, stats.bytes);
+    try testing.expectEqual(0, stats.short_calls);
+}
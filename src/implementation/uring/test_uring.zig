@@ -0,0 +1,138 @@
+const std = @import("std");
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "reader init" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+
+    var buffer: [8]u8 = undefined;
+    var context: lib.GciReaderUring = undefined;
+    const init_err = lib.gci_reader_uring_init(&context, file.handle, &buffer, buffer.len, 2);
+    // io_uring may be disabled, e.g. by seccomp in containers
+    if (init_err == lib.GCI_ERROR_IO) return error.SkipZigTest;
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_reader_uring_deinit(&context);
+
+    _ = lib.gci_reader_uring_interface(&context);
+}
+
+test "reader init null" {
+    var buffer: [8]u8 = undefined;
+    const init_err = lib.gci_reader_uring_init(null, 0, &buffer, buffer.len, 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "reader init blocks" {
+    var buffer: [8]u8 = undefined;
+    var context: lib.GciReaderUring = undefined;
+
+    const init_err1 = lib.gci_reader_uring_init(&context, 0, &buffer, buffer.len, 0);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err1);
+
+    const init_err2 = lib.gci_reader_uring_init(&context, 0, &buffer, buffer.len, 3);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err2);
+
+    const init_err3 = lib.gci_reader_uring_init(&context, 0, &buffer, buffer.len, lib.GCI_URING_BLOCKS_MAX + 1);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err3);
+}
+
+test "reader read" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+    try file.writeAll("123456789");
+    try file.seekTo(0);
+
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciReaderUring = undefined;
+    const init_err = lib.gci_reader_uring_init(&context, file.handle, &buffer, buffer.len, 2);
+    if (init_err == lib.GCI_ERROR_IO) return error.SkipZigTest;
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const reader = lib.gci_reader_uring_interface(&context);
+    try testing.expect(!lib.gci_reader_eof(reader));
+
+    var buffer1: [3]u8 = undefined;
+    const length1 = lib.gci_reader_read(reader, &buffer1, buffer1.len);
+    try testing.expectEqual(3, length1);
+    try testing.expectEqualStrings("123", &buffer1);
+
+    var view: [*c]const u8 = undefined;
+    const length2 = lib.gci_reader_peek(reader, &view, null, 0);
+    try testing.expectEqual(1, length2);
+    try testing.expectEqualStrings("4", view[0..1]);
+    lib.gci_reader_consume(reader, length2, 1);
+
+    var buffer2: [6]u8 = undefined;
+    const length3 = lib.gci_reader_read(reader, &buffer2, buffer2.len);
+    try testing.expectEqual(5, length3);
+    try testing.expectEqualStrings("56789", buffer2[0..5]);
+    try testing.expect(lib.gci_reader_eof(reader));
+
+    lib.gci_reader_uring_deinit(&context);
+
+    // The file offset is left after what was consumed
+    try testing.expectEqual(9, try file.getPos());
+}
+
+test "writer init" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+
+    var buffer: [8]u8 = undefined;
+    var context: lib.GciWriterUring = undefined;
+    const init_err = lib.gci_writer_uring_init(&context, file.handle, &buffer, buffer.len, 2);
+    if (init_err == lib.GCI_ERROR_IO) return error.SkipZigTest;
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer _ = lib.gci_writer_uring_deinit(&context);
+
+    _ = lib.gci_writer_uring_interface(&context);
+}
+
+test "writer init null buffer" {
+    var context: lib.GciWriterUring = undefined;
+    const init_err = lib.gci_writer_uring_init(&context, 0, null, 8, 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "writer write" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciWriterUring = undefined;
+    const init_err = lib.gci_writer_uring_init(&context, file.handle, &buffer, buffer.len, 2);
+    if (init_err == lib.GCI_ERROR_IO) return error.SkipZigTest;
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_uring_interface(&context);
+
+    const res1 = lib.gci_writer_write(writer, "123", 3);
+    try testing.expectEqual(3, res1);
+
+    const res2 = lib.gci_writer_write(writer, "45678", 5);
+    try testing.expectEqual(5, res2);
+
+    const flush_res = lib.gci_writer_uring_flush(&context);
+    try testing.expect(flush_res);
+
+    const deinit_res = lib.gci_writer_uring_deinit(&context);
+    try testing.expect(deinit_res);
+    try testing.expectEqual(8, try file.getPos());
+
+    var result: [9]u8 = undefined;
+    const length = try file.preadAll(&result, 0);
+    try testing.expectEqualStrings("12345678", result[0..length]);
+}
@@ -0,0 +1,568 @@
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#include <gci_uring.h>
+
+enum GciError gci_uring_init(struct GciUring *ring, unsigned entries);
+void gci_uring_deinit(struct GciUring *ring);
+bool gci_uring_register(struct GciUring *ring, char *buffer, size_t buffer_size);
+void gci_uring_prepare(
+    struct GciUring *ring,
+    unsigned char opcode,
+    int fd,
+    char *data,
+    size_t data_size,
+    uint64_t offset,
+    uint64_t user_data
+);
+bool gci_uring_enter(struct GciUring *ring, unsigned wait_count);
+bool gci_uring_wait(struct GciUring *ring, uint64_t *user_data, int *result);
+
+size_t gci_reader_uring_read(void const *context, char *buffer, size_t buffer_size);
+bool gci_reader_uring_eof(void const *context);
+size_t gci_reader_uring_peek(void const *context, char const **data);
+void gci_reader_uring_consume(void const *context, size_t amount);
+void gci_reader_uring_submit(struct GciReaderUring *context, size_t block);
+bool gci_reader_uring_process(struct GciReaderUring *context);
+bool gci_reader_uring_ready(struct GciReaderUring *context);
+
+size_t gci_writer_uring_write(void const *context, char const *data, size_t data_size);
+void gci_writer_uring_submit(struct GciWriterUring *context, size_t block);
+bool gci_writer_uring_process(struct GciWriterUring *context);
+
+enum GciError gci_uring_init(struct GciUring *ring, unsigned entries) {
+    assert(ring != NULL);
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    long fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0) { return GCI_ERROR_IO; }
+
+    size_t sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    size_t cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        sq_ring_size = sq_ring_size > cq_ring_size ? sq_ring_size : cq_ring_size;
+        cq_ring_size = sq_ring_size;
+    }
+
+    void *sq_ring = mmap(
+        NULL, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, (int) fd, IORING_OFF_SQ_RING
+    );
+    if (sq_ring == MAP_FAILED) {
+        close((int) fd);
+        return GCI_ERROR_IO;
+    }
+
+    void *cq_ring = sq_ring;
+    if (!single_mmap) {
+        cq_ring = mmap(
+            NULL, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, (int) fd, IORING_OFF_CQ_RING
+        );
+        if (cq_ring == MAP_FAILED) {
+            munmap(sq_ring, sq_ring_size);
+            close((int) fd);
+            return GCI_ERROR_IO;
+        }
+    }
+
+    size_t sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = mmap(
+        NULL, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, (int) fd, IORING_OFF_SQES
+    );
+    if (sqes == MAP_FAILED) {
+        if (!single_mmap) { munmap(cq_ring, cq_ring_size); }
+        munmap(sq_ring, sq_ring_size);
+        close((int) fd);
+        return GCI_ERROR_IO;
+    }
+
+    ring->fd = (int) fd;
+    ring->sq_entries = params.sq_entries;
+    ring->pending = 0;
+    ring->sq_ring = sq_ring;
+    ring->sq_ring_size = sq_ring_size;
+    ring->cq_ring = cq_ring;
+    ring->cq_ring_size = cq_ring_size;
+    ring->sqes = sqes;
+    ring->sqes_size = sqes_size;
+    ring->sq_head = (unsigned*) ((char*) sq_ring + params.sq_off.head);
+    ring->sq_tail = (unsigned*) ((char*) sq_ring + params.sq_off.tail);
+    ring->sq_array = (unsigned*) ((char*) sq_ring + params.sq_off.array);
+    ring->sq_mask = *(unsigned*) ((char*) sq_ring + params.sq_off.ring_mask);
+    ring->cq_head = (unsigned*) ((char*) cq_ring + params.cq_off.head);
+    ring->cq_tail = (unsigned*) ((char*) cq_ring + params.cq_off.tail);
+    ring->cq_mask = *(unsigned*) ((char*) cq_ring + params.cq_off.ring_mask);
+    ring->cqes = (char*) cq_ring + params.cq_off.cqes;
+
+    return GCI_ERROR_OK;
+}
+
+void gci_uring_deinit(struct GciUring *ring) {
+    assert(ring != NULL);
+
+    munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+}
+
+// Registers `buffer` with the kernel so it does not have to be mapped for
+// every request, fails when for example the memlock limit is too low.
+bool gci_uring_register(struct GciUring *ring, char *buffer, size_t buffer_size) {
+    assert(ring != NULL);
+
+    struct iovec vector = { .iov_base = buffer, .iov_len = buffer_size };
+    long result = syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS, &vector, 1);
+    return result == 0;
+}
+
+void gci_uring_prepare(
+    struct GciUring *ring,
+    unsigned char opcode,
+    int fd,
+    char *data,
+    size_t data_size,
+    uint64_t offset,
+    uint64_t user_data
+) {
+    assert(ring != NULL);
+    assert(data_size <= UINT32_MAX);
+
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    unsigned tail = *ring->sq_tail;
+    assert(tail - head < ring->sq_entries);
+    (void) head;
+
+    unsigned index = tail & ring->sq_mask;
+    struct io_uring_sqe *sqe = &((struct io_uring_sqe*) ring->sqes)[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t) (uintptr_t) data;
+    sqe->len = (uint32_t) data_size;
+    sqe->off = offset;
+    sqe->user_data = user_data;
+
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->pending += 1;
+}
+
+// Submits everything prepared and waits for at least `wait_count` completions.
+bool gci_uring_enter(struct GciUring *ring, unsigned wait_count) {
+    assert(ring != NULL);
+
+    unsigned flags = wait_count > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (true) {
+        long result = syscall(__NR_io_uring_enter, ring->fd, ring->pending, wait_count, flags, NULL, 0);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (result < 0) {
+            return false;
+        }
+
+        assert((unsigned long) result <= ring->pending);
+        ring->pending -= (unsigned) result;
+        return true;
+    }
+}
+
+// Takes the next completion, waiting for one if none is ready.
+bool gci_uring_wait(struct GciUring *ring, uint64_t *user_data, int *result) {
+    assert(ring != NULL);
+    assert(user_data != NULL);
+    assert(result != NULL);
+
+    while (true) {
+        unsigned head = *ring->cq_head;
+        unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        if (head != tail) {
+            struct io_uring_cqe *cqe = &((struct io_uring_cqe*) ring->cqes)[head & ring->cq_mask];
+            *user_data = cqe->user_data;
+            *result = cqe->res;
+            __atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        if (!gci_uring_enter(ring, 1)) { return false; }
+    }
+}
+
+enum GciError gci_reader_uring_init(
+    struct GciReaderUring *context,
+    int fd,
+    char *buffer,
+    size_t buffer_size,
+    size_t block_count
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (buffer == NULL) { return GCI_ERROR_NULL; }
+    if (fd < 0) { return GCI_ERROR_NULL; }
+    if (block_count == 0 || block_count > GCI_URING_BLOCKS_MAX) { return GCI_ERROR_BUFFER; }
+    if (buffer_size < block_count || buffer_size % block_count != 0) { return GCI_ERROR_BUFFER; }
+    if (buffer_size / block_count > UINT32_MAX) { return GCI_ERROR_BUFFER; }
+
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+    if (offset < 0) { return GCI_ERROR_IO; }
+
+    enum GciError err = gci_uring_init(&context->ring, (unsigned) block_count);
+    if (err != GCI_ERROR_OK) { return err; }
+
+    context->fd = fd;
+    context->buffer = buffer;
+    context->block_size = buffer_size / block_count;
+    context->block_count = block_count;
+    context->next_offset = (uint64_t) offset;
+    context->head = 0;
+    context->current = 0;
+    context->fixed = gci_uring_register(&context->ring, buffer, buffer_size);
+    context->eof = false;
+
+    for (size_t block = 0; block < block_count; block++) {
+        context->lengths[block] = 0;
+        context->offsets[block] = context->next_offset;
+        context->next_offset += context->block_size;
+        gci_reader_uring_submit(context, block);
+    }
+    gci_uring_enter(&context->ring, 0);
+
+    return GCI_ERROR_OK;
+}
+
+void gci_reader_uring_deinit(struct GciReaderUring *context) {
+    assert(context != NULL);
+
+    // The kernel may still be writing into the buffer
+    for (size_t block = 0; block < context->block_count; block++) {
+        while (context->states[block] == GCI_URING_BUSY) {
+            if (!gci_reader_uring_process(context)) { break; }
+        }
+    }
+
+    uint64_t offset = context->offsets[context->head] + context->current;
+    lseek(context->fd, (off_t) offset, SEEK_SET);
+    gci_uring_deinit(&context->ring);
+}
+
+struct GciInterfaceReader gci_reader_uring_interface(struct GciReaderUring *context) {
+    return (struct GciInterfaceReader) {
+        .context = context,
+        .read = gci_reader_uring_read,
+        .eof = gci_reader_uring_eof,
+        .peek = gci_reader_uring_peek,
+        .consume = gci_reader_uring_consume,
+    };
+}
+
+// Queues a read of the unfilled part of `block`.
+void gci_reader_uring_submit(struct GciReaderUring *context, size_t block) {
+    assert(context != NULL);
+    assert(context->lengths[block] < context->block_size);
+
+    size_t length = context->lengths[block];
+    unsigned char opcode = context->fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    gci_uring_prepare(
+        &context->ring,
+        opcode,
+        context->fd,
+        context->buffer + block * context->block_size + length,
+        context->block_size - length,
+        context->offsets[block] + length,
+        block
+    );
+    context->states[block] = GCI_URING_BUSY;
+}
+
+// Handles one completion, short reads are resubmitted until the block is
+// full or the end of the file is reached.
+bool gci_reader_uring_process(struct GciReaderUring *context) {
+    assert(context != NULL);
+
+    uint64_t block;
+    int result;
+    if (!gci_uring_wait(&context->ring, &block, &result)) { return false; }
+    assert(block < context->block_count);
+
+    if (result == -EINTR || result == -EAGAIN) {
+        gci_reader_uring_submit(context, block);
+    } else if (result < 0) {
+        context->states[block] = GCI_URING_FAILED;
+    } else if (result == 0) {
+        context->states[block] = GCI_URING_DONE;
+    } else {
+        context->lengths[block] += (size_t) result;
+        if (context->lengths[block] < context->block_size) {
+            gci_reader_uring_submit(context, block);
+        } else {
+            context->states[block] = GCI_URING_DONE;
+        }
+    }
+
+    return gci_uring_enter(&context->ring, 0);
+}
+
+// Makes sure the head block has unconsumed bytes, recycling consumed blocks
+// as reads of the next part of the file. Returns false on eof or error.
+bool gci_reader_uring_ready(struct GciReaderUring *context) {
+    assert(context != NULL);
+
+    while (!context->eof) {
+        size_t head = context->head;
+        while (context->states[head] == GCI_URING_BUSY) {
+            if (!gci_reader_uring_process(context)) { return false; }
+        }
+
+        if (context->states[head] == GCI_URING_FAILED) {
+            // Retried by the next call
+            gci_reader_uring_submit(context, head);
+            gci_uring_enter(&context->ring, 0);
+            return false;
+        }
+
+        assert(context->states[head] == GCI_URING_DONE);
+        if (context->current < context->lengths[head]) {
+            return true;
+        }
+        if (context->lengths[head] < context->block_size) {
+            context->eof = true;
+            return false;
+        }
+
+        context->lengths[head] = 0;
+        context->offsets[head] = context->next_offset;
+        context->next_offset += context->block_size;
+        gci_reader_uring_submit(context, head);
+        gci_uring_enter(&context->ring, 0);
+
+        context->head = (head + 1) % context->block_count;
+        context->current = 0;
+    }
+
+    return false;
+}
+
+size_t gci_reader_uring_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    struct GciReaderUring *context = (struct GciReaderUring*) void_context;
+
+    assert(buffer != NULL);
+    size_t read_length = 0;
+    while (read_length < buffer_size) {
+        if (!gci_reader_uring_ready(context)) { break; }
+
+        char *block = context->buffer + context->head * context->block_size;
+        size_t length = context->lengths[context->head] - context->current;
+        length = length > buffer_size - read_length ? buffer_size - read_length : length;
+
+        memcpy(buffer + read_length, block + context->current, length);
+        context->current += length;
+        read_length += length;
+    }
+
+    assert(read_length <= buffer_size);
+    return read_length;
+}
+
+bool gci_reader_uring_eof(void const *void_context) {
+    assert(void_context != NULL);
+    struct GciReaderUring *context = (struct GciReaderUring*) void_context;
+    return context->eof;
+}
+
+size_t gci_reader_uring_peek(void const *void_context, char const **data) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciReaderUring *context = (struct GciReaderUring*) void_context;
+
+    if (!gci_reader_uring_ready(context)) { return 0; }
+
+    *data = context->buffer + context->head * context->block_size + context->current;
+    return context->lengths[context->head] - context->current;
+}
+
+void gci_reader_uring_consume(void const *void_context, size_t amount) {
+    assert(void_context != NULL);
+    struct GciReaderUring *context = (struct GciReaderUring*) void_context;
+
+    assert(context->current <= context->lengths[context->head]);
+    assert(amount <= context->lengths[context->head] - context->current);
+    context->current += amount;
+}
+
+enum GciError gci_writer_uring_init(
+    struct GciWriterUring *context,
+    int fd,
+    char *buffer,
+    size_t buffer_size,
+    size_t block_count
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (buffer == NULL) { return GCI_ERROR_NULL; }
+    if (fd < 0) { return GCI_ERROR_NULL; }
+    if (block_count == 0 || block_count > GCI_URING_BLOCKS_MAX) { return GCI_ERROR_BUFFER; }
+    if (buffer_size < block_count || buffer_size % block_count != 0) { return GCI_ERROR_BUFFER; }
+    if (buffer_size / block_count > UINT32_MAX) { return GCI_ERROR_BUFFER; }
+
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+    if (offset < 0) { return GCI_ERROR_IO; }
+
+    enum GciError err = gci_uring_init(&context->ring, (unsigned) block_count);
+    if (err != GCI_ERROR_OK) { return err; }
+
+    context->fd = fd;
+    context->buffer = buffer;
+    context->block_size = buffer_size / block_count;
+    context->block_count = block_count;
+    context->next_offset = (uint64_t) offset;
+    context->head = 0;
+    context->fixed = gci_uring_register(&context->ring, buffer, buffer_size);
+    context->error = false;
+
+    for (size_t block = 0; block < block_count; block++) {
+        context->lengths[block] = 0;
+        context->written[block] = 0;
+        context->offsets[block] = 0;
+        context->states[block] = GCI_URING_IDLE;
+    }
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceWriter gci_writer_uring_interface(struct GciWriterUring *context) {
+    return (struct GciInterfaceWriter) { .context = context, .write = gci_writer_uring_write };
+}
+
+// Queues a write of the unwritten part of `block`.
+void gci_writer_uring_submit(struct GciWriterUring *context, size_t block) {
+    assert(context != NULL);
+    assert(context->written[block] < context->lengths[block]);
+
+    size_t written = context->written[block];
+    unsigned char opcode = context->fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    gci_uring_prepare(
+        &context->ring,
+        opcode,
+        context->fd,
+        context->buffer + block * context->block_size + written,
+        context->lengths[block] - written,
+        context->offsets[block] + written,
+        block
+    );
+    context->states[block] = GCI_URING_BUSY;
+}
+
+// Handles one completion, short writes are resubmitted until the block is
+// written or fails.
+bool gci_writer_uring_process(struct GciWriterUring *context) {
+    assert(context != NULL);
+
+    uint64_t block;
+    int result;
+    if (!gci_uring_wait(&context->ring, &block, &result)) {
+        context->error = true;
+        return false;
+    }
+    assert(block < context->block_count);
+
+    if (result == -EINTR || result == -EAGAIN) {
+        gci_writer_uring_submit(context, block);
+    } else if (result <= 0) {
+        context->error = true;
+        context->lengths[block] = 0;
+        context->states[block] = GCI_URING_IDLE;
+    } else {
+        context->written[block] += (size_t) result;
+        if (context->written[block] < context->lengths[block]) {
+            gci_writer_uring_submit(context, block);
+        } else {
+            context->lengths[block] = 0;
+            context->states[block] = GCI_URING_IDLE;
+        }
+    }
+
+    return gci_uring_enter(&context->ring, 0);
+}
+
+size_t gci_writer_uring_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciWriterUring *context = (struct GciWriterUring*) void_context;
+
+    if (context->error) {
+        return 0;
+    }
+
+    size_t write_length = 0;
+    while (write_length < data_size) {
+        size_t head = context->head;
+        while (context->states[head] == GCI_URING_BUSY) {
+            if (!gci_writer_uring_process(context)) { return write_length; }
+        }
+
+        char *block = context->buffer + head * context->block_size;
+        size_t length = context->block_size - context->lengths[head];
+        length = length > data_size - write_length ? data_size - write_length : length;
+
+        memcpy(block + context->lengths[head], data + write_length, length);
+        context->lengths[head] += length;
+        write_length += length;
+
+        if (context->lengths[head] >= context->block_size) {
+            context->written[head] = 0;
+            context->offsets[head] = context->next_offset;
+            context->next_offset += context->lengths[head];
+            gci_writer_uring_submit(context, head);
+            gci_uring_enter(&context->ring, 0);
+
+            context->head = (head + 1) % context->block_count;
+        }
+    }
+
+    return write_length;
+}
+
+bool gci_writer_uring_flush(struct GciWriterUring *context) {
+    assert(context != NULL);
+
+    size_t head = context->head;
+    if (context->states[head] == GCI_URING_IDLE && context->lengths[head] > 0) {
+        context->written[head] = 0;
+        context->offsets[head] = context->next_offset;
+        context->next_offset += context->lengths[head];
+        gci_writer_uring_submit(context, head);
+        gci_uring_enter(&context->ring, 0);
+
+        context->head = (head + 1) % context->block_count;
+    }
+
+    for (size_t block = 0; block < context->block_count; block++) {
+        while (context->states[block] == GCI_URING_BUSY) {
+            if (!gci_writer_uring_process(context)) { return false; }
+        }
+    }
+
+    return !context->error;
+}
+
+bool gci_writer_uring_deinit(struct GciWriterUring *context) {
+    assert(context != NULL);
+
+    bool result = gci_writer_uring_flush(context);
+    lseek(context->fd, (off_t) context->next_offset, SEEK_SET);
+    gci_uring_deinit(&context->ring);
+    return result;
+}
+
+#endif
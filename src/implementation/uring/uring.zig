@@ -0,0 +1,111 @@
+const std = @import("std");
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
+const InterfaceReader = @import("../reader/reader.zig").InterfaceReader;
+const InterfaceWriter = @import("../writer/writer.zig").InterfaceWriter;
+
+pub const Reader = struct {
+    inner: lib.GciReaderUring,
+
+    pub fn init(fd: c_int, buffer: []u8, block_count: usize) !Reader {
+        var self: Reader = undefined;
+        const err = lib.gci_reader_uring_init(
+            &self.inner,
+            fd,
+            buffer.ptr,
+            buffer.len,
+            block_count,
+        );
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn deinit(self: *Reader) void {
+        lib.gci_reader_uring_deinit(&self.inner);
+    }
+
+    pub fn interface(self: *Reader) InterfaceReader {
+        return .{ .reader = lib.gci_reader_uring_interface(&self.inner) };
+    }
+};
+
+pub const Writer = struct {
+    inner: lib.GciWriterUring,
+
+    pub fn init(fd: c_int, buffer: []u8, block_count: usize) !Writer {
+        var self: Writer = undefined;
+        const err = lib.gci_writer_uring_init(
+            &self.inner,
+            fd,
+            buffer.ptr,
+            buffer.len,
+            block_count,
+        );
+        try internal.enumToError(err);
+        return self;
+    }
+
+    // Any failure to write is reported by `flush`, call it before `deinit`
+    // to observe errors.
+    pub fn deinit(self: *Writer) void {
+        _ = lib.gci_writer_uring_deinit(&self.inner);
+    }
+
+    pub fn interface(self: *Writer) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_uring_interface(&self.inner) };
+    }
+
+    pub fn flush(self: *Writer) !void {
+        const result = lib.gci_writer_uring_flush(&self.inner);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+};
+
+const testing = std.testing;
+
+test "c tests" {
+    _ = @import("test_uring.zig");
+}
+
+test "reader init pipe" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+    defer std.posix.close(fds[1]);
+
+    var buffer: [8]u8 = undefined;
+    const err = Reader.init(fds[0], &buffer, 2);
+    try testing.expectError(error.Io, err);
+}
+
+test "write and read" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const file = try tmp.dir.createFile("data", .{ .read = true });
+    defer file.close();
+
+    var buffer: [8]u8 = undefined;
+
+    // io_uring may be disabled, e.g. by seccomp in containers
+    var writer_context = Writer.init(file.handle, &buffer, 2) catch |err| switch (err) {
+        error.Io => return error.SkipZigTest,
+        else => return err,
+    };
+    const writer = writer_context.interface();
+    try writer.write("123456789");
+    try writer_context.flush();
+    writer_context.deinit();
+
+    try file.seekTo(0);
+
+    var reader_context = try Reader.init(file.handle, &buffer, 2);
+    defer reader_context.deinit();
+    const reader = reader_context.interface();
+
+    var result_buffer: [10]u8 = undefined;
+    const result = try reader.read(&result_buffer);
+    try testing.expectEqualStrings("123456789", result);
+    try testing.expect(reader.eof());
+}
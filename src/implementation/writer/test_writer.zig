@@ -163,6 +163,363 @@ test "string end" {
     try testing.expectEqualStrings("45", r3);
 }
 
+test "string reserve" {
+    var buffer: [3]u8 = undefined;
+    var context: lib.GciWriterString = undefined;
+
+    const init_err = lib.gci_writer_string_init(&context, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_string_interface(&context);
+
+    const reserved1 = lib.gci_writer_reserve(writer, 2, null, 0);
+    try testing.expectEqual(@as([*c]u8, &buffer), reserved1);
+    reserved1[0] = '1';
+    reserved1[1] = '2';
+
+    const res1 = lib.gci_writer_commit(writer, reserved1, 2, null);
+    try testing.expectEqual(2, res1);
+    try testing.expectEqual(2, context.current);
+
+    const reserved2 = lib.gci_writer_reserve(writer, 2, null, 0);
+    try testing.expect(reserved2 == null);
+
+    const reserved3 = lib.gci_writer_reserve(writer, 1, null, 0);
+    try testing.expectEqual(@as([*c]u8, &buffer[2]), reserved3);
+    reserved3[0] = '3';
+
+    const res2 = lib.gci_writer_commit(writer, reserved3, 1, null);
+    try testing.expectEqual(1, res2);
+    try testing.expectEqualStrings("123", &buffer);
+}
+
+test "file reserve fallback" {
+    var file: [*c]clib.FILE = undefined;
+
+    switch (builtin.os.tag) {
+        .linux => {
+            file = clib.tmpfile();
+        },
+        .windows => {
+            @compileError("TODO: allow testing file writer, something to do with `GetTempFileNameA` and `GetTempPathA`");
+        },
+        else => {
+            std.debug.print("TODO: allow testing file writer on this os.\n", .{});
+            return;
+        },
+    }
+    defer _ = clib.fclose(file);
+
+    var context: lib.GciWriterFile = undefined;
+    const init_err = lib.gci_writer_file_init(&context, @as([*c]lib.FILE, @ptrCast(file)));
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_file_interface(&context);
+
+    var scratch: [2]u8 = undefined;
+    const reserved = lib.gci_writer_reserve(writer, 2, &scratch, scratch.len);
+    try testing.expectEqual(@as([*c]u8, &scratch), reserved);
+    reserved[0] = '1';
+
+    const res = lib.gci_writer_commit(writer, reserved, 1, &scratch);
+    try testing.expectEqual(1, res);
+
+    const too_large = lib.gci_writer_reserve(writer, 3, &scratch, scratch.len);
+    try testing.expect(too_large == null);
+
+    const seek_err = clib.fseek(file, 0, lib.SEEK_SET);
+    try testing.expectEqual(seek_err, 0);
+
+    var buffer: [2]u8 = undefined;
+    const result = clib.fread(&buffer, 1, 2, file);
+    try testing.expectEqual(1, result);
+    try testing.expectEqualStrings("1", buffer[0..1]);
+}
+
+test "string writev fallback" {
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciWriterString = undefined;
+    const init_err = lib.gci_writer_string_init(&context, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_string_interface(&context);
+
+    const vectors = [_]lib.GciIovec{
+        .{ .data = "12", .data_size = 2 },
+        .{ .data = "345", .data_size = 3 },
+        .{ .data = "6", .data_size = 1 },
+    };
+    const res = lib.gci_writer_writev(writer, &vectors, vectors.len);
+    try testing.expectEqual(4, res);
+    try testing.expectEqualStrings("1234", &buffer);
+}
+
+test "growable init" {
+    var context: lib.GciWriterGrowable = undefined;
+    const init_err = lib.gci_writer_growable_init(&context, lib.gci_allocator_libc_interface(), 4);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_writer_growable_deinit(&context);
+
+    try testing.expectEqual(4, context.buffer_size);
+    _ = lib.gci_writer_growable_interface(&context);
+}
+
+test "growable init null" {
+    const init_err = lib.gci_writer_growable_init(null, lib.gci_allocator_libc_interface(), 4);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "growable init allocation fail" {
+    var buffer: [4]u8 = undefined;
+    var arena: lib.GciAllocatorArena = undefined;
+    const a_err = lib.gci_allocator_arena_init(&arena, &buffer, 0);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), a_err);
+
+    var context: lib.GciWriterGrowable = undefined;
+    const init_err = lib.gci_writer_growable_init(&context, lib.gci_allocator_arena_interface(&arena), 4);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err);
+}
+
+test "growable write" {
+    var context: lib.GciWriterGrowable = undefined;
+    const init_err = lib.gci_writer_growable_init(&context, lib.gci_allocator_libc_interface(), 0);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_writer_growable_deinit(&context);
+
+    const writer = lib.gci_writer_growable_interface(&context);
+
+    const res1 = lib.gci_writer_write(writer, "12", 2);
+    try testing.expectEqual(2, res1);
+
+    const start = lib.gci_writer_growable_start(&context);
+    try testing.expectEqual(2, start);
+
+    var large: [1000]u8 = undefined;
+    @memset(&large, 'a');
+    const res2 = lib.gci_writer_write(writer, &large, large.len);
+    try testing.expectEqual(1000, res2);
+    try testing.expect(context.buffer_size >= 1002);
+
+    var string: [*c]u8 = undefined;
+    var length: usize = undefined;
+    const end_err = lib.gci_writer_growable_end(&context, start, &string, &length);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), end_err);
+    try testing.expectEqual(1000, length);
+    try testing.expectEqualSlices(u8, &large, string[0..length]);
+    try testing.expectEqualStrings("12", context.buffer[0..2]);
+}
+
+test "growable reserve" {
+    var context: lib.GciWriterGrowable = undefined;
+    const init_err = lib.gci_writer_growable_init(&context, lib.gci_allocator_libc_interface(), 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_writer_growable_deinit(&context);
+
+    const writer = lib.gci_writer_growable_interface(&context);
+
+    // Reserving more than is left grows the buffer
+    const reserved = lib.gci_writer_reserve(writer, 100, null, 0);
+    try testing.expect(reserved != null);
+    try testing.expect(context.buffer_size >= 100);
+
+    reserved[0] = '1';
+    const res = lib.gci_writer_commit(writer, reserved, 1, null);
+    try testing.expectEqual(1, res);
+    try testing.expectEqual(1, context.current);
+}
+
+test "growable allocation fail" {
+    var buffer: [64]u8 align(16) = undefined;
+    var arena: lib.GciAllocatorArena = undefined;
+    const a_err = lib.gci_allocator_arena_init(&arena, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), a_err);
+
+    var context: lib.GciWriterGrowable = undefined;
+    const init_err = lib.gci_writer_growable_init(&context, lib.gci_allocator_arena_interface(&arena), 0);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_growable_interface(&context);
+
+    var large: [100]u8 = undefined;
+    @memset(&large, 'a');
+    const res1 = lib.gci_writer_write(writer, &large, 60);
+    try testing.expectEqual(60, res1);
+
+    // The arena cannot grow the buffer, only what fits is written
+    const res2 = lib.gci_writer_write(writer, &large, 10);
+    try testing.expectEqual(4, res2);
+
+    const reserved = lib.gci_writer_reserve(writer, 1, null, 0);
+    try testing.expect(reserved == null);
+}
+
+test "rope init" {
+    var context: lib.GciWriterRope = undefined;
+    const init_err1 = lib.gci_writer_rope_init(&context, lib.gci_allocator_libc_interface(), 0);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_BUFFER), init_err1);
+
+    const init_err2 = lib.gci_writer_rope_init(null, lib.gci_allocator_libc_interface(), 4);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err2);
+
+    const init_err3 = lib.gci_writer_rope_init(&context, lib.gci_allocator_libc_interface(), 4);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err3);
+    defer lib.gci_writer_rope_deinit(&context);
+
+    _ = lib.gci_writer_rope_interface(&context);
+}
+
+test "rope write" {
+    var context: lib.GciWriterRope = undefined;
+    const init_err = lib.gci_writer_rope_init(&context, lib.gci_allocator_libc_interface(), 4);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_writer_rope_deinit(&context);
+
+    const writer = lib.gci_writer_rope_interface(&context);
+
+    const res1 = lib.gci_writer_write(writer, "123456", 6);
+    try testing.expectEqual(6, res1);
+
+    // A reservation does not span chunks
+    const reserved = lib.gci_writer_reserve(writer, 3, null, 0);
+    try testing.expect(reserved != null);
+    @memcpy(reserved[0..3], "789");
+    const res2 = lib.gci_writer_commit(writer, reserved, 3, null);
+    try testing.expectEqual(3, res2);
+    try testing.expectEqual(9, lib.gci_writer_rope_length(&context));
+
+    var vectors: [4]lib.GciIovec = undefined;
+    const count = lib.gci_writer_rope_segments(&context, &vectors, vectors.len);
+    try testing.expectEqual(3, count);
+    try testing.expectEqualStrings("1234", vectors[0].data[0..vectors[0].data_size]);
+    try testing.expectEqualStrings("56", vectors[1].data[0..vectors[1].data_size]);
+    try testing.expectEqualStrings("789", vectors[2].data[0..vectors[2].data_size]);
+
+    const too_large = lib.gci_writer_reserve(writer, 5, null, 0);
+    try testing.expect(too_large == null);
+}
+
+test "rope drain" {
+    const fds = try std.posix.pipe();
+    defer std.posix.close(fds[0]);
+
+    var out: lib.GciWriterFd = undefined;
+    const out_err = lib.gci_writer_fd_init(&out, fds[1]);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), out_err);
+
+    var context: lib.GciWriterRope = undefined;
+    const init_err = lib.gci_writer_rope_init(&context, lib.gci_allocator_libc_interface(), 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_writer_rope_deinit(&context);
+
+    const writer = lib.gci_writer_rope_interface(&context);
+
+    const res = lib.gci_writer_write(writer, "12345", 5);
+    try testing.expectEqual(5, res);
+
+    const drain_res = lib.gci_writer_rope_drain(&context, lib.gci_writer_fd_interface(&out));
+    try testing.expect(drain_res);
+    try testing.expectEqual(0, lib.gci_writer_rope_length(&context));
+    std.posix.close(fds[1]);
+
+    var buffer: [6]u8 = undefined;
+    const length = try std.posix.read(fds[0], &buffer);
+    try testing.expectEqualStrings("12345", buffer[0..length]);
+}
+
+test "rope drain writer fail" {
+    var b: [3]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const c_err = lib.gci_writer_string_init(&c, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), c_err);
+
+    var context: lib.GciWriterRope = undefined;
+    const init_err = lib.gci_writer_rope_init(&context, lib.gci_allocator_libc_interface(), 2);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    defer lib.gci_writer_rope_deinit(&context);
+
+    const writer = lib.gci_writer_rope_interface(&context);
+
+    const res = lib.gci_writer_write(writer, "12345", 5);
+    try testing.expectEqual(5, res);
+
+    // What was written is removed from the rope
+    const drain_res = lib.gci_writer_rope_drain(&context, lib.gci_writer_string_interface(&c));
+    try testing.expect(!drain_res);
+    try testing.expectEqual(2, lib.gci_writer_rope_length(&context));
+
+    var vectors: [2]lib.GciIovec = undefined;
+    const count = lib.gci_writer_rope_segments(&context, &vectors, vectors.len);
+    try testing.expectEqual(2, count);
+    try testing.expectEqualStrings("4", vectors[0].data[0..vectors[0].data_size]);
+    try testing.expectEqualStrings("5", vectors[1].data[0..vectors[1].data_size]);
+}
+
+test "tee init null" {
+    var c: lib.GciWriterString = undefined;
+    const writer = lib.gci_writer_string_interface(&c);
+
+    const init_err = lib.gci_writer_tee_init(null, writer, writer);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_NULL), init_err);
+}
+
+test "tee write short" {
+    var b1: [5]u8 = undefined;
+    var c1: lib.GciWriterString = undefined;
+    const c1_err = lib.gci_writer_string_init(&c1, &b1, b1.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), c1_err);
+
+    var b2: [8]u8 = undefined;
+    var c2: lib.GciWriterString = undefined;
+    const c2_err = lib.gci_writer_string_init(&c2, &b2, b2.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), c2_err);
+
+    var context: lib.GciWriterTee = undefined;
+    const init_err = lib.gci_writer_tee_init(
+        &context,
+        lib.gci_writer_string_interface(&c1),
+        lib.gci_writer_string_interface(&c2),
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const writer = lib.gci_writer_tee_interface(&context);
+
+    // The second writer only gets what the first one wrote
+    const res1 = lib.gci_writer_write(writer, "123", 3);
+    try testing.expectEqual(3, res1);
+    const res2 = lib.gci_writer_write(writer, "456", 3);
+    try testing.expectEqual(2, res2);
+    try testing.expectEqualStrings("12345", &b1);
+    try testing.expectEqualStrings("12345", b2[0..c2.current]);
+}
+
+test "tee writev short" {
+    var b1: [4]u8 = undefined;
+    var c1: lib.GciWriterString = undefined;
+    const c1_err = lib.gci_writer_string_init(&c1, &b1, b1.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), c1_err);
+
+    var b2: [8]u8 = undefined;
+    var c2: lib.GciWriterString = undefined;
+    const c2_err = lib.gci_writer_string_init(&c2, &b2, b2.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), c2_err);
+
+    var context: lib.GciWriterTee = undefined;
+    const init_err = lib.gci_writer_tee_init(
+        &context,
+        lib.gci_writer_string_interface(&c1),
+        lib.gci_writer_string_interface(&c2),
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+    const writer = lib.gci_writer_tee_interface(&context);
+
+    const vectors = [_]lib.GciIovec{
+        .{ .data = "12", .data_size = 2 },
+        .{ .data = "345", .data_size = 3 },
+    };
+    const res = lib.gci_writer_writev(writer, &vectors, vectors.len);
+    try testing.expectEqual(4, res);
+    try testing.expectEqualStrings("1234", b2[0..c2.current]);
+}
+
 test "buffer init" {
     var c: lib.GciWriterString = undefined;
 
@@ -296,6 +653,136 @@ test "buffer write large" {
     try testing.expectEqualStrings("1234567", &b);
 }
 
+test "buffer write small remainder" {
+    var b: [5]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [3]u8 = undefined;
+    var context: lib.GciWriterBuffer = undefined;
+    const init_err = lib.gci_writer_buffer_init(
+        &context,
+        lib.gci_writer_string_interface(&c),
+        &buffer,
+        buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_buffer_interface(&context);
+
+    // Buffer is filled and flushed, the remaining "45" is kept in the buffer
+    const res = lib.gci_writer_write(writer, "12345", 5);
+    try testing.expectEqual(5, res);
+    try testing.expectEqual(3, c.current);
+    try testing.expectEqual(2, context.current);
+
+    const flush_res = lib.gci_writer_buffer_flush(&context);
+    try testing.expect(flush_res);
+    try testing.expectEqualStrings("12345", &b);
+}
+
+test "buffer reserve" {
+    var b: [4]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [3]u8 = undefined;
+    var context: lib.GciWriterBuffer = undefined;
+    const init_err = lib.gci_writer_buffer_init(
+        &context,
+        lib.gci_writer_string_interface(&c),
+        &buffer,
+        buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_buffer_interface(&context);
+
+    const res1 = lib.gci_writer_write(writer, "1", 1);
+    try testing.expectEqual(1, res1);
+
+    // Not enough room left, the buffer is flushed before reserving
+    const reserved = lib.gci_writer_reserve(writer, 3, null, 0);
+    try testing.expectEqual(@as([*c]u8, &buffer), reserved);
+    try testing.expectEqual(1, c.current);
+
+    reserved[0] = '2';
+    reserved[1] = '3';
+    reserved[2] = '4';
+
+    // Committing a full buffer flushes it
+    const res2 = lib.gci_writer_commit(writer, reserved, 3, null);
+    try testing.expectEqual(3, res2);
+    try testing.expectEqualStrings("1234", &b);
+
+    const too_large = lib.gci_writer_reserve(writer, 4, null, 0);
+    try testing.expect(too_large == null);
+}
+
+test "buffer writev" {
+    var b: [16]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [4]u8 = undefined;
+    var context: lib.GciWriterBuffer = undefined;
+    const init_err = lib.gci_writer_buffer_init(
+        &context,
+        lib.gci_writer_string_interface(&c),
+        &buffer,
+        buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_buffer_interface(&context);
+
+    // Small pieces are copied, large pieces are written together with
+    // whatever is already buffered
+    const vectors = [_]lib.GciIovec{
+        .{ .data = "12", .data_size = 2 },
+        .{ .data = "34567", .data_size = 5 },
+        .{ .data = "8", .data_size = 1 },
+    };
+    const res = lib.gci_writer_writev(writer, &vectors, vectors.len);
+    try testing.expectEqual(8, res);
+    try testing.expectEqual(7, c.current);
+    try testing.expectEqualStrings("1234567", b[0..7]);
+    try testing.expectEqual(1, context.current);
+
+    const flush_res = lib.gci_writer_buffer_flush(&context);
+    try testing.expect(flush_res);
+    try testing.expectEqualStrings("12345678", b[0..8]);
+}
+
+test "buffer writev writer fail" {
+    var b: [3]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &b, b.len);
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), i_err);
+
+    var buffer: [2]u8 = undefined;
+    var context: lib.GciWriterBuffer = undefined;
+    const init_err = lib.gci_writer_buffer_init(
+        &context,
+        lib.gci_writer_string_interface(&c),
+        &buffer,
+        buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.GCI_ERROR_OK), init_err);
+
+    const writer = lib.gci_writer_buffer_interface(&context);
+
+    const vectors = [_]lib.GciIovec{
+        .{ .data = "1", .data_size = 1 },
+        .{ .data = "2345", .data_size = 4 },
+    };
+    const res = lib.gci_writer_writev(writer, &vectors, vectors.len);
+    try testing.expectEqual(3, res);
+}
+
 test "buffer flush" {
     var b: [1]u8 = undefined;
     var c: lib.GciWriterString = undefined;
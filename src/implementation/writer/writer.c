@@ -1,11 +1,45 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include <stdint.h>
-#include <limits.h>
 #include <string.h>
 #include <gci_writer.h>
 
+// Files with a descriptor are written with `writev(2)` where it exists
+#if defined(__unix__) || defined(__APPLE__)
+#define GCI_WRITER_POSIX
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+#define GCI_WRITER_IOVEC_BATCH 64
+
 size_t gci_writer_file_write(void const *void_context, char const *data, size_t data_size);
+size_t gci_writer_file_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count);
+size_t gci_writer_buffer_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count);
+size_t gci_writer_growable_write(void const *void_context, char const *data, size_t data_size);
+char *gci_writer_growable_reserve(void const *void_context, size_t size);
+size_t gci_writer_growable_commit(void const *void_context, size_t size);
+bool gci_writer_growable_grow(struct GciWriterGrowable *context, size_t size);
+size_t gci_writer_rope_write(void const *void_context, char const *data, size_t data_size);
+char *gci_writer_rope_reserve(void const *void_context, size_t size);
+size_t gci_writer_rope_commit(void const *void_context, size_t size);
+struct GciWriterRopeChunk *gci_writer_rope_append(struct GciWriterRope *context);
+void gci_writer_rope_consume(struct GciWriterRope *context, size_t amount);
+void gci_writer_rope_free(struct GciWriterRope *context, struct GciWriterRopeChunk *chunk);
+size_t gci_writer_tee_write(void const *void_context, char const *data, size_t data_size);
+size_t gci_writer_tee_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count);
+#ifdef GCI_WRITER_POSIX
+size_t gci_writer_writev_fd(int fd, struct GciIovec const *vectors, size_t vector_count);
+#endif
 size_t gci_writer_string_write(void const *void_context, char const *data, size_t data_size);
 size_t gci_writer_buffer_write(void const *void_context, char const *data, size_t data_size);
+char *gci_writer_string_reserve(void const *void_context, size_t size);
+char *gci_writer_buffer_reserve(void const *void_context, size_t size);
+size_t gci_writer_string_commit(void const *void_context, size_t size);
+size_t gci_writer_buffer_commit(void const *void_context, size_t size);
 
 enum GciError gci_writer_file_init(struct GciWriterFile *context, FILE *file) {
     if (context == NULL) { return GCI_ERROR_NULL; }
@@ -18,7 +52,11 @@ enum GciError gci_writer_file_init(struct GciWriterFile *context, FILE *file) {
 
 struct GciInterfaceWriter gci_writer_file_interface(struct GciWriterFile *writer) {
     assert(writer != NULL);
-    return (struct GciInterfaceWriter) { .context = writer, .write = gci_writer_file_write };
+    return (struct GciInterfaceWriter) {
+        .context = writer,
+        .write = gci_writer_file_write,
+        .writev = gci_writer_file_writev,
+    };
 }
 
 size_t gci_writer_file_write(void const *context, char const *data, size_t data_size) {
@@ -28,6 +66,77 @@ size_t gci_writer_file_write(void const *context, char const *data, size_t data_
     return fwrite(data, sizeof(char), data_size, writer->file);
 }
 
+size_t gci_writer_file_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count) {
+    assert(void_context != NULL);
+    struct GciWriterFile *context = (struct GciWriterFile*) void_context;
+
+#ifdef GCI_WRITER_POSIX
+    int fd = fileno(context->file);
+    if (fd >= 0) {
+        if (fflush(context->file) != 0) { return 0; }
+        return gci_writer_writev_fd(fd, vectors, vector_count);
+    }
+#endif
+
+    // Streams without a file descriptor, e.g. memory streams, go through stdio
+    struct GciInterfaceWriter writer = { .context = context, .write = gci_writer_file_write };
+    return gci_writer_writev(writer, vectors, vector_count);
+}
+
+#ifdef GCI_WRITER_POSIX
+size_t gci_writer_writev_fd(int fd, struct GciIovec const *vectors, size_t vector_count) {
+    assert(vectors != NULL || vector_count == 0);
+
+    struct iovec batch[GCI_WRITER_IOVEC_BATCH];
+    size_t total = 0;
+    size_t index = 0;
+    size_t offset = 0;
+
+    while (index < vector_count) {
+        size_t batch_count = 0;
+        size_t batch_size = 0;
+        for (size_t i = index; i < vector_count && batch_count < GCI_WRITER_IOVEC_BATCH; i++) {
+            size_t skip = i == index ? offset : 0;
+            size_t size = vectors[i].data_size - skip;
+            size = size > SSIZE_MAX - batch_size ? SSIZE_MAX - batch_size : size;
+            if (size == 0) { continue; }
+
+            batch[batch_count].iov_base = (char*) vectors[i].data + skip;
+            batch[batch_count].iov_len = size;
+            batch_count += 1;
+            batch_size += size;
+            if (batch_size >= SSIZE_MAX) { break; }
+        }
+        if (batch_count == 0) { break; }
+
+        ssize_t length = writev(fd, batch, (int) batch_count);
+        if (length < 0 && errno == EINTR) {
+            continue;
+        } else if (length <= 0) {
+            break;
+        }
+        total += (size_t) length;
+
+        // Skip past everything written, a short write resumes mid piece
+        size_t advance = (size_t) length;
+        while (advance > 0) {
+            assert(index < vector_count);
+            size_t length_left = vectors[index].data_size - offset;
+            if (advance < length_left) {
+                offset += advance;
+                advance = 0;
+            } else {
+                advance -= length_left;
+                index += 1;
+                offset = 0;
+            }
+        }
+    }
+
+    return total;
+}
+#endif
+
 enum GciError gci_writer_string_init(
     struct GciWriterString *context,
     char *buffer,
@@ -44,7 +153,12 @@ enum GciError gci_writer_string_init(
 }
 
 struct GciInterfaceWriter gci_writer_string_interface(struct GciWriterString *context) {
-    return (struct GciInterfaceWriter) { .context = context, .write = gci_writer_string_write };
+    return (struct GciInterfaceWriter) {
+        .context = context,
+        .write = gci_writer_string_write,
+        .reserve = gci_writer_string_reserve,
+        .commit = gci_writer_string_commit,
+    };
 }
 
 size_t gci_writer_string_write(void const *void_context, char const *data, size_t data_size) {
@@ -68,6 +182,28 @@ size_t gci_writer_string_write(void const *void_context, char const *data, size_
     return write_length;
 }
 
+char *gci_writer_string_reserve(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterString *context = (struct GciWriterString*) void_context;
+    assert(context->buffer != NULL);
+    assert(context->current <= context->buffer_size);
+
+    if (context->buffer_size - context->current < size) {
+        return NULL;
+    }
+    return context->buffer + context->current;
+}
+
+size_t gci_writer_string_commit(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterString *context = (struct GciWriterString*) void_context;
+    assert(context->current <= context->buffer_size);
+    assert(size <= context->buffer_size - context->current);
+
+    context->current += size;
+    return size;
+}
+
 size_t gci_writer_string_start(struct GciWriterString *context) {
     assert(context != NULL);
     return context->current;
@@ -91,6 +227,406 @@ enum GciError gci_writer_string_end(struct GciWriterString *context, size_t star
     return GCI_ERROR_OK;
 }
 
+enum GciError gci_writer_growable_init(
+    struct GciWriterGrowable *context,
+    struct GciInterfaceAllocator allocator,
+    size_t initial_size
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->allocator = allocator;
+    context->buffer = NULL;
+    context->buffer_size = 0;
+    context->current = 0;
+
+    if (initial_size > 0) {
+        context->buffer = gci_allocator_alloc(allocator, initial_size);
+        if (context->buffer == NULL) { return GCI_ERROR_BUFFER; }
+        context->buffer_size = initial_size;
+    }
+
+    return GCI_ERROR_OK;
+}
+
+void gci_writer_growable_deinit(struct GciWriterGrowable *context) {
+    assert(context != NULL);
+    gci_allocator_free(context->allocator, context->buffer, context->buffer_size);
+    context->buffer = NULL;
+    context->buffer_size = 0;
+    context->current = 0;
+}
+
+struct GciInterfaceWriter gci_writer_growable_interface(struct GciWriterGrowable *context) {
+    return (struct GciInterfaceWriter) {
+        .context = context,
+        .write = gci_writer_growable_write,
+        .reserve = gci_writer_growable_reserve,
+        .commit = gci_writer_growable_commit,
+    };
+}
+
+void gci_writer_growable_reset(struct GciWriterGrowable *context) {
+    assert(context != NULL);
+    context->current = 0;
+}
+
+size_t gci_writer_growable_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciWriterGrowable *context = (struct GciWriterGrowable*) void_context;
+    assert(context->current <= context->buffer_size);
+
+    if (context->buffer_size - context->current < data_size) {
+        gci_writer_growable_grow(context, data_size);
+    }
+
+    size_t write_length = context->buffer_size - context->current;
+    write_length = write_length > data_size ? data_size : write_length;
+
+    if (write_length > 0) {
+        memcpy(context->buffer + context->current, data, write_length);
+        context->current += write_length;
+    }
+    return write_length;
+}
+
+char *gci_writer_growable_reserve(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterGrowable *context = (struct GciWriterGrowable*) void_context;
+    assert(context->current <= context->buffer_size);
+
+    if (context->buffer_size - context->current < size) {
+        bool grow_success = gci_writer_growable_grow(context, size);
+        if (!grow_success) { return NULL; }
+    }
+    return context->buffer + context->current;
+}
+
+size_t gci_writer_growable_commit(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterGrowable *context = (struct GciWriterGrowable*) void_context;
+    assert(size <= context->buffer_size - context->current);
+
+    context->current += size;
+    return size;
+}
+
+// Grows the buffer to make room for at least `size` more bytes, at least
+// doubling it so that appending stays amortized constant time.
+bool gci_writer_growable_grow(struct GciWriterGrowable *context, size_t size) {
+    assert(context != NULL);
+    if (size > SIZE_MAX - context->current) { return false; }
+
+    size_t needed = context->current + size;
+    size_t new_size = context->buffer_size < 64 ? 64 : context->buffer_size;
+    while (new_size < needed) {
+        new_size = new_size > SIZE_MAX / 2 ? needed : new_size * 2;
+    }
+
+    char *buffer = gci_allocator_resize(context->allocator, context->buffer, context->buffer_size, new_size);
+    if (buffer == NULL) { return false; }
+
+    context->buffer = buffer;
+    context->buffer_size = new_size;
+    return true;
+}
+
+size_t gci_writer_growable_start(struct GciWriterGrowable *context) {
+    assert(context != NULL);
+    return context->current;
+}
+
+enum GciError gci_writer_growable_end(struct GciWriterGrowable *context, size_t start, char **string, size_t *length) {
+    assert(context != NULL);
+    assert(string != NULL);
+    assert(length != NULL);
+    assert(start <= context->current);
+
+    if (context->buffer == NULL) {
+        *string = NULL;
+        *length = 0;
+    } else {
+        *string = context->buffer + start;
+        *length = context->current - start;
+    }
+
+    return GCI_ERROR_OK;
+}
+
+enum GciError gci_writer_rope_init(
+    struct GciWriterRope *context,
+    struct GciInterfaceAllocator allocator,
+    size_t chunk_size
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+    if (chunk_size == 0) { return GCI_ERROR_BUFFER; }
+    if (chunk_size > SIZE_MAX - sizeof(struct GciWriterRopeChunk)) { return GCI_ERROR_BUFFER; }
+
+    context->allocator = allocator;
+    context->chunk_size = chunk_size;
+    context->head = NULL;
+    context->tail = NULL;
+    context->spare = NULL;
+    context->head_offset = 0;
+    context->length = 0;
+
+    return GCI_ERROR_OK;
+}
+
+void gci_writer_rope_deinit(struct GciWriterRope *context) {
+    assert(context != NULL);
+    gci_writer_rope_free(context, context->head);
+    gci_writer_rope_free(context, context->spare);
+
+    context->head = NULL;
+    context->tail = NULL;
+    context->spare = NULL;
+    context->head_offset = 0;
+    context->length = 0;
+}
+
+struct GciInterfaceWriter gci_writer_rope_interface(struct GciWriterRope *context) {
+    return (struct GciInterfaceWriter) {
+        .context = context,
+        .write = gci_writer_rope_write,
+        .reserve = gci_writer_rope_reserve,
+        .commit = gci_writer_rope_commit,
+    };
+}
+
+size_t gci_writer_rope_length(struct GciWriterRope const *context) {
+    assert(context != NULL);
+    return context->length;
+}
+
+size_t gci_writer_rope_segments(struct GciWriterRope const *context, struct GciIovec *vectors, size_t vector_count) {
+    assert(context != NULL);
+    assert(vectors != NULL || vector_count == 0);
+
+    size_t count = 0;
+    size_t offset = context->head_offset;
+    for (struct GciWriterRopeChunk *chunk = context->head; chunk != NULL && count < vector_count; chunk = chunk->next) {
+        assert(offset <= chunk->length);
+        if (chunk->length > offset) {
+            vectors[count].data = chunk->data + offset;
+            vectors[count].data_size = chunk->length - offset;
+            count += 1;
+        }
+        offset = 0;
+    }
+    return count;
+}
+
+bool gci_writer_rope_drain(struct GciWriterRope *context, struct GciInterfaceWriter writer) {
+    assert(context != NULL);
+
+    while (context->length > 0) {
+        struct GciIovec vectors[GCI_WRITER_IOVEC_BATCH];
+        size_t count = gci_writer_rope_segments(context, vectors, GCI_WRITER_IOVEC_BATCH);
+        assert(count > 0);
+
+        size_t total = 0;
+        for (size_t index = 0; index < count; index++) {
+            total += vectors[index].data_size;
+        }
+
+        size_t result = gci_writer_writev(writer, vectors, count);
+        gci_writer_rope_consume(context, result);
+        if (result < total) { return false; }
+    }
+
+    gci_writer_rope_reset(context);
+    return true;
+}
+
+void gci_writer_rope_reset(struct GciWriterRope *context) {
+    assert(context != NULL);
+    if (context->tail != NULL) {
+        context->tail->next = context->spare;
+        context->spare = context->head;
+    }
+
+    context->head = NULL;
+    context->tail = NULL;
+    context->head_offset = 0;
+    context->length = 0;
+}
+
+size_t gci_writer_rope_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+    struct GciWriterRope *context = (struct GciWriterRope*) void_context;
+
+    size_t write_length = 0;
+    while (write_length < data_size) {
+        struct GciWriterRopeChunk *tail = context->tail;
+        if (tail == NULL || tail->length >= context->chunk_size) {
+            tail = gci_writer_rope_append(context);
+            if (tail == NULL) { break; }
+        }
+
+        size_t length = context->chunk_size - tail->length;
+        length = length > data_size - write_length ? data_size - write_length : length;
+
+        memcpy(tail->data + tail->length, data + write_length, length);
+        tail->length += length;
+        write_length += length;
+    }
+
+    context->length += write_length;
+    return write_length;
+}
+
+char *gci_writer_rope_reserve(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterRope *context = (struct GciWriterRope*) void_context;
+
+    if (size > context->chunk_size) { return NULL; }
+
+    // Reservations never span chunks, a reservation which does not fit
+    // leaves the rest of the current chunk unused
+    struct GciWriterRopeChunk *tail = context->tail;
+    if (tail == NULL || context->chunk_size - tail->length < size) {
+        tail = gci_writer_rope_append(context);
+        if (tail == NULL) { return NULL; }
+    }
+    return tail->data + tail->length;
+}
+
+size_t gci_writer_rope_commit(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterRope *context = (struct GciWriterRope*) void_context;
+    assert(context->tail != NULL || size == 0);
+    if (size == 0) { return 0; }
+    assert(size <= context->chunk_size - context->tail->length);
+
+    context->tail->length += size;
+    context->length += size;
+    return size;
+}
+
+struct GciWriterRopeChunk *gci_writer_rope_append(struct GciWriterRope *context) {
+    assert(context != NULL);
+
+    struct GciWriterRopeChunk *chunk = context->spare;
+    if (chunk != NULL) {
+        context->spare = chunk->next;
+    } else {
+        size_t size = sizeof(struct GciWriterRopeChunk) + context->chunk_size;
+        chunk = gci_allocator_alloc(context->allocator, size);
+        if (chunk == NULL) { return NULL; }
+    }
+
+    chunk->next = NULL;
+    chunk->length = 0;
+
+    if (context->tail == NULL) {
+        context->head = chunk;
+        context->head_offset = 0;
+    } else {
+        context->tail->next = chunk;
+    }
+    context->tail = chunk;
+    return chunk;
+}
+
+void gci_writer_rope_consume(struct GciWriterRope *context, size_t amount) {
+    assert(context != NULL);
+    assert(amount <= context->length);
+    context->length -= amount;
+
+    while (context->head != NULL) {
+        struct GciWriterRopeChunk *head = context->head;
+        size_t length_left = head->length - context->head_offset;
+        if (amount < length_left) {
+            context->head_offset += amount;
+            break;
+        }
+
+        // Fully written chunks go to the spare list, unless it is the tail
+        // which may still be written to
+        amount -= length_left;
+        if (head == context->tail) {
+            head->length = 0;
+            context->head_offset = 0;
+            break;
+        }
+
+        context->head = head->next;
+        context->head_offset = 0;
+        head->next = context->spare;
+        context->spare = head;
+    }
+}
+
+void gci_writer_rope_free(struct GciWriterRope *context, struct GciWriterRopeChunk *chunk) {
+    assert(context != NULL);
+    size_t size = sizeof(struct GciWriterRopeChunk) + context->chunk_size;
+    while (chunk != NULL) {
+        struct GciWriterRopeChunk *next = chunk->next;
+        gci_allocator_free(context->allocator, chunk, size);
+        chunk = next;
+    }
+}
+
+enum GciError gci_writer_tee_init(
+        struct GciWriterTee *context,
+        struct GciInterfaceWriter first,
+        struct GciInterfaceWriter second
+) {
+    if (context == NULL) { return GCI_ERROR_NULL; }
+
+    context->first = first;
+    context->second = second;
+
+    return GCI_ERROR_OK;
+}
+
+struct GciInterfaceWriter gci_writer_tee_interface(struct GciWriterTee *context) {
+    assert(context != NULL);
+    return (struct GciInterfaceWriter) {
+        .context = context,
+        .write = gci_writer_tee_write,
+        .writev = gci_writer_tee_writev,
+    };
+}
+
+size_t gci_writer_tee_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    struct GciWriterTee *context = (struct GciWriterTee*) void_context;
+
+    size_t length = gci_writer_write(context->first, data, data_size);
+    return gci_writer_write(context->second, data, length);
+}
+
+size_t gci_writer_tee_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count) {
+    assert(void_context != NULL);
+    struct GciWriterTee *context = (struct GciWriterTee*) void_context;
+
+    size_t total = 0;
+    for (size_t index = 0; index < vector_count; index++) {
+        total += vectors[index].data_size;
+    }
+
+    size_t length = gci_writer_writev(context->first, vectors, vector_count);
+    if (length == total) {
+        return gci_writer_writev(context->second, vectors, vector_count);
+    }
+
+    // Only what the first writer wrote is given to the second one, the last
+    // piece of it may have been written partially
+    size_t pieces = 0;
+    size_t remaining = length;
+    while (remaining >= vectors[pieces].data_size) {
+        remaining -= vectors[pieces].data_size;
+        pieces += 1;
+    }
+
+    size_t written = gci_writer_writev(context->second, vectors, pieces);
+    if (written < length - remaining) { return written; }
+    return written + gci_writer_write(context->second, vectors[pieces].data, remaining);
+}
+
 enum GciError gci_writer_buffer_init(
         struct GciWriterBuffer *context,
         struct GciInterfaceWriter writer,
@@ -110,7 +646,13 @@ enum GciError gci_writer_buffer_init(
 }
 
 struct GciInterfaceWriter gci_writer_buffer_interface(struct GciWriterBuffer *context) {
-    return (struct GciInterfaceWriter) { .context = context, .write = gci_writer_buffer_write };
+    return (struct GciInterfaceWriter) {
+        .context = context,
+        .write = gci_writer_buffer_write,
+        .reserve = gci_writer_buffer_reserve,
+        .commit = gci_writer_buffer_commit,
+        .writev = gci_writer_buffer_writev,
+    };
 }
 
 size_t gci_writer_buffer_write(void const *void_context, char const *data, size_t data_size) {
@@ -135,12 +677,81 @@ size_t gci_writer_buffer_write(void const *void_context, char const *data, size_
             size_t result = gci_writer_write(context->writer, data + write_length, data_size - write_length);
             if (result < data_size - write_length) { return write_length + result; }
         } else {
-            memcpy(context->buffer, data + write_length, data_size + write_length);
+            memcpy(context->buffer, data + write_length, data_size - write_length);
+            context->current = data_size - write_length;
         }
     }
     return data_size;
 }
 
+size_t gci_writer_buffer_writev(void const *void_context, struct GciIovec const *vectors, size_t vector_count) {
+    assert(void_context != NULL);
+    assert(vectors != NULL || vector_count == 0);
+    struct GciWriterBuffer *context = (struct GciWriterBuffer*) void_context;
+    assert(context->buffer != NULL);
+
+    size_t total = 0;
+    for (size_t index = 0; index < vector_count; index++) {
+        char const *data = vectors[index].data;
+        size_t data_size = vectors[index].data_size;
+        if (data_size == 0) { continue; }
+
+        if (data_size < context->buffer_size) {
+            size_t result = gci_writer_buffer_write(context, data, data_size);
+            total += result;
+            if (result < data_size) { return total; }
+            continue;
+        }
+
+        // Pieces which would not fit in the buffer anyway are passed through
+        // together with what is already buffered instead of being copied
+        size_t buffered = context->current;
+        struct GciIovec pieces[2] = {
+            { .data = context->buffer, .data_size = buffered },
+            { .data = data, .data_size = data_size },
+        };
+        size_t result = gci_writer_writev(context->writer, pieces, 2);
+        context->current = 0;
+
+        if (result < buffered + data_size) {
+            return total + (result > buffered ? result - buffered : 0);
+        }
+        total += data_size;
+    }
+    return total;
+}
+
+char *gci_writer_buffer_reserve(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterBuffer *context = (struct GciWriterBuffer*) void_context;
+    assert(context->buffer != NULL);
+    assert(context->current < context->buffer_size);
+
+    if (size > context->buffer_size) {
+        return NULL;
+    }
+
+    if (context->buffer_size - context->current < size) {
+        bool flush_success = gci_writer_buffer_flush(context);
+        if (!flush_success) { return NULL; }
+    }
+    return context->buffer + context->current;
+}
+
+size_t gci_writer_buffer_commit(void const *void_context, size_t size) {
+    assert(void_context != NULL);
+    struct GciWriterBuffer *context = (struct GciWriterBuffer*) void_context;
+    assert(context->current <= context->buffer_size);
+    assert(size <= context->buffer_size - context->current);
+
+    context->current += size;
+    if (context->current >= context->buffer_size) {
+        bool flush_success = gci_writer_buffer_flush(context);
+        if (!flush_success) { return 0; }
+    }
+    return size;
+}
+
 bool gci_writer_buffer_flush(struct GciWriterBuffer *context) {
     assert(context != NULL);
     assert(context->buffer != NULL);
@@ -1,6 +1,9 @@
 const std = @import("std");
 const internal = @import("../../internal.zig");
 const lib = internal.lib;
+const InterfaceAllocator = @import("../allocator/allocator.zig").InterfaceAllocator;
+
+pub const Iovec = lib.GciIovec;
 
 pub const InterfaceWriter = struct {
     writer: lib.GciInterfaceWriter,
@@ -11,6 +14,33 @@ pub const InterfaceWriter = struct {
             return error.Writer;
         }
     }
+
+    pub fn writev(writer: InterfaceWriter, vectors: []const Iovec) !void {
+        var total: usize = 0;
+        for (vectors) |vector| {
+            total += vector.data_size;
+        }
+
+        const result = lib.gci_writer_writev(writer.writer, vectors.ptr, vectors.len);
+        if (result != total) {
+            return error.Writer;
+        }
+    }
+
+    pub fn reserve(writer: InterfaceWriter, size: usize, scratch: []u8) ![]u8 {
+        const reserved = lib.gci_writer_reserve(writer.writer, size, scratch.ptr, scratch.len);
+        if (reserved == null) {
+            return error.Writer;
+        }
+        return reserved[0..size];
+    }
+
+    pub fn commit(writer: InterfaceWriter, reserved: []u8, size: usize, scratch: []u8) !void {
+        const result = lib.gci_writer_commit(writer.writer, reserved.ptr, size, scratch.ptr);
+        if (result != size) {
+            return error.Writer;
+        }
+    }
 };
 
 inline fn writeData(writer: *const anyopaque, data: []const u8) !void {
@@ -32,7 +62,13 @@ pub fn Writer(AnyWriter: type) type {
         }
 
         pub fn interface(self: *Self) InterfaceWriter {
-            const writer = lib.GciInterfaceWriter{ .context = self, .write = writeCallback };
+            const writer = lib.GciInterfaceWriter{
+                .context = self,
+                .write = writeCallback,
+                .reserve = null,
+                .commit = null,
+                .writev = null,
+            };
             return .{ .writer = writer };
         }
 
@@ -102,6 +138,96 @@ pub const String = struct {
     }
 };
 
+var empty_string: [0]u8 = .{};
+
+pub const Growable = struct {
+    inner: lib.GciWriterGrowable,
+
+    pub fn init(allocator: InterfaceAllocator, initial_size: usize) !Growable {
+        var self: Growable = undefined;
+        const err = lib.gci_writer_growable_init(&self.inner, allocator.allocator, initial_size);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn deinit(self: *Growable) void {
+        lib.gci_writer_growable_deinit(&self.inner);
+    }
+
+    pub fn interface(self: *Growable) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_growable_interface(&self.inner) };
+    }
+
+    pub fn reset(self: *Growable) void {
+        lib.gci_writer_growable_reset(&self.inner);
+    }
+
+    pub fn start(self: *Growable) usize {
+        return lib.gci_writer_growable_start(&self.inner);
+    }
+
+    // The returned slice is invalidated by the next write.
+    pub fn end(self: *Growable, start_result: usize) ![]u8 {
+        var string: [*c]u8 = undefined;
+        var length: usize = undefined;
+        const err = lib.gci_writer_growable_end(&self.inner, start_result, &string, &length);
+        try internal.enumToError(err);
+        if (string == null) {
+            return &empty_string;
+        }
+        return string[0..length];
+    }
+};
+
+pub const Rope = struct {
+    inner: lib.GciWriterRope,
+
+    pub fn init(allocator: InterfaceAllocator, chunk_size: usize) !Rope {
+        var self: Rope = undefined;
+        const err = lib.gci_writer_rope_init(&self.inner, allocator.allocator, chunk_size);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn deinit(self: *Rope) void {
+        lib.gci_writer_rope_deinit(&self.inner);
+    }
+
+    pub fn interface(self: *Rope) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_rope_interface(&self.inner) };
+    }
+
+    pub fn length(self: *const Rope) usize {
+        return lib.gci_writer_rope_length(&self.inner);
+    }
+
+    pub fn drain(self: *Rope, writer: InterfaceWriter) !void {
+        const result = lib.gci_writer_rope_drain(&self.inner, writer.writer);
+        if (!result) {
+            return error.Writer;
+        }
+    }
+
+    pub fn reset(self: *Rope) void {
+        lib.gci_writer_rope_reset(&self.inner);
+    }
+};
+
+pub const Tee = struct {
+    inner: lib.GciWriterTee,
+
+    pub fn init(first: InterfaceWriter, second: InterfaceWriter) !Tee {
+        var self: Tee = undefined;
+        const err = lib.gci_writer_tee_init(&self.inner, first.writer, second.writer);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn interface(self: *Tee) InterfaceWriter {
+        return .{ .writer = lib.gci_writer_tee_interface(&self.inner) };
+    }
+};
+
 pub const Buffer = struct {
     inner: lib.GciWriterBuffer,
 
@@ -134,6 +260,8 @@ pub const Buffer = struct {
 };
 
 const testing = std.testing;
+const Allocator = @import("../allocator/allocator.zig").Allocator;
+const Arena = @import("../allocator/allocator.zig").Arena;
 const builtin = @import("builtin");
 const clib = @cImport({
     @cInclude("stdio.h");
@@ -157,6 +285,43 @@ test "zig writer" {
     try testing.expectEqualStrings("1", &buffer);
 }
 
+test "zig writer reserve fallback" {
+    const Fifo = std.fifo.LinearFifo(u8, .Slice);
+    const FifoWriter = Writer(Fifo.Writer);
+
+    var buffer: [2]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+
+    var context = FifoWriter.init(&fifo.writer());
+    const writer = context.interface();
+
+    var scratch: [2]u8 = undefined;
+    const reserved = try writer.reserve(2, &scratch);
+    try testing.expectEqual(@as([*]u8, &scratch), reserved.ptr);
+
+    @memcpy(reserved, "12");
+    try writer.commit(reserved, 2, &scratch);
+    try testing.expectEqualStrings("12", &buffer);
+}
+
+test "zig writer writev fallback" {
+    const Fifo = std.fifo.LinearFifo(u8, .Slice);
+    const FifoWriter = Writer(Fifo.Writer);
+
+    var buffer: [5]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+
+    var context = FifoWriter.init(&fifo.writer());
+    const writer = context.interface();
+
+    const vectors = [_]Iovec{
+        .{ .data = "12", .data_size = 2 },
+        .{ .data = "345", .data_size = 3 },
+    };
+    try writer.writev(&vectors);
+    try testing.expectEqualStrings("12345", &buffer);
+}
+
 test "file init" {
     var context = try File.init(@ptrFromInt(256));
     _ = context.interface();
@@ -271,6 +436,106 @@ test "string end" {
     try testing.expectEqualStrings("45", r3);
 }
 
+test "string reserve" {
+    var buffer: [3]u8 = undefined;
+    var context = try String.init(&buffer);
+    const writer = context.interface();
+
+    var scratch: [0]u8 = undefined;
+    const reserved = try writer.reserve(3, &scratch);
+    try testing.expectEqual(@as([*]u8, &buffer), reserved.ptr);
+
+    @memcpy(reserved[0..2], "12");
+    try writer.commit(reserved, 2, &scratch);
+    try testing.expectEqualStrings("12", try context.end(0));
+
+    const err = writer.reserve(2, &scratch);
+    try testing.expectError(error.Writer, err);
+}
+
+test "growable write" {
+    var allocator = Allocator.init(testing.allocator);
+    var context = try Growable.init(allocator.interface(), 0);
+    defer context.deinit();
+    const writer = context.interface();
+
+    try writer.write("12");
+    const start = context.start();
+    for (0..100) |_| {
+        try writer.write("3456789");
+    }
+
+    const result = try context.end(start);
+    try testing.expectEqual(700, result.len);
+    try testing.expectEqualStrings("3456789", result[693..]);
+    try testing.expectEqualStrings("12", (try context.end(0))[0..2]);
+
+    context.reset();
+    try testing.expectEqualStrings("", try context.end(0));
+}
+
+test "growable arena" {
+    var buffer: [128]u8 align(16) = undefined;
+    var arena = try Arena.init(&buffer);
+    var context = try Growable.init(arena.interface(), 8);
+    const writer = context.interface();
+
+    try writer.write("1234567890");
+    try testing.expectEqualStrings("1234567890", try context.end(0));
+
+    var large: [128]u8 = undefined;
+    try testing.expectError(error.Writer, writer.write(&large));
+}
+
+test "rope drain" {
+    var allocator = Allocator.init(testing.allocator);
+    var context = try Rope.init(allocator.interface(), 4);
+    defer context.deinit();
+    const writer = context.interface();
+
+    try writer.write("123456789");
+    try testing.expectEqual(9, context.length());
+
+    var buffer: [9]u8 = undefined;
+    var string = try String.init(&buffer);
+    try context.drain(string.interface());
+    try testing.expectEqualStrings("123456789", &buffer);
+    try testing.expectEqual(0, context.length());
+}
+
+test "rope drain fail" {
+    var allocator = Allocator.init(testing.allocator);
+    var context = try Rope.init(allocator.interface(), 4);
+    defer context.deinit();
+    const writer = context.interface();
+
+    try writer.write("123456789");
+
+    var buffer: [5]u8 = undefined;
+    var string = try String.init(&buffer);
+    try testing.expectError(error.Writer, context.drain(string.interface()));
+    try testing.expectEqual(4, context.length());
+}
+
+test "tee write" {
+    var buffer1: [9]u8 = undefined;
+    var string1 = try String.init(&buffer1);
+    var buffer2: [9]u8 = undefined;
+    var string2 = try String.init(&buffer2);
+
+    var context = try Tee.init(string1.interface(), string2.interface());
+    const writer = context.interface();
+
+    const vectors = [_]Iovec{
+        .{ .data = "567", .data_size = 3 },
+        .{ .data = "89", .data_size = 2 },
+    };
+    try writer.write("1234");
+    try writer.writev(&vectors);
+    try testing.expectEqualStrings("123456789", &buffer1);
+    try testing.expectEqualStrings("123456789", &buffer2);
+}
+
 test "buffer init" {
     var b: [3]u8 = undefined;
     var c = try String.init(&b);
@@ -355,3 +620,43 @@ test "buffer flush writer fail" {
     const err = context.flush();
     try testing.expectError(error.Writer, err);
 }
+
+test "buffer reserve" {
+    var b: [4]u8 = undefined;
+    var c = try String.init(&b);
+
+    var buffer: [3]u8 = undefined;
+    var context = try Buffer.init(c.interface(), &buffer);
+    const writer = context.interface();
+
+    var scratch: [0]u8 = undefined;
+    try writer.write("1");
+
+    const reserved = try writer.reserve(3, &scratch);
+    try testing.expectEqual(@as([*]u8, &buffer), reserved.ptr);
+    try testing.expectEqualStrings("1", try c.end(0));
+
+    @memcpy(reserved, "234");
+    try writer.commit(reserved, 3, &scratch);
+    try testing.expectEqualStrings("1234", try c.end(0));
+}
+
+test "buffer writev" {
+    var b: [8]u8 = undefined;
+    var c = try String.init(&b);
+
+    var buffer: [3]u8 = undefined;
+    var context = try Buffer.init(c.interface(), &buffer);
+    const writer = context.interface();
+
+    const vectors = [_]Iovec{
+        .{ .data = "1", .data_size = 1 },
+        .{ .data = "2345", .data_size = 4 },
+        .{ .data = "6", .data_size = 1 },
+    };
+    try writer.writev(&vectors);
+    try testing.expectEqualStrings("12345", try c.end(0));
+
+    try context.flush();
+    try testing.expectEqualStrings("123456", try c.end(0));
+}
@@ -0,0 +1,58 @@
+#ifndef GCI_INTERFACE_ALLOCATOR_H
+#define GCI_INTERFACE_ALLOCATOR_H
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+typedef void *(GciAlloc)(void const *context, size_t size);
+typedef void *(GciResize)(void const *context, void *memory, size_t old_size, size_t new_size);
+typedef void (GciFree)(void const *context, void *memory, size_t size);
+
+// An allocator interface, a valid allocator will have some optional context
+// (in `context`) and non-null `alloc` and `free` functions.
+//
+// The alloc function returns `size` bytes aligned for any object type or
+// null if the memory cannot be provided. The free function releases memory
+// returned by the allocator, `size` is the size it was allocated with.
+//
+// The resize function is optional, it returns memory of `new_size` bytes
+// which starts with the first `old_size` bytes of `memory`, possibly at a
+// new address. On success `memory` must no longer be used, on failure it
+// returns null and `memory` is left untouched.
+struct GciInterfaceAllocator {
+    void const *context;
+    GciAlloc *alloc;
+    GciResize *resize;
+    GciFree *free;
+};
+
+static inline void *gci_allocator_alloc(struct GciInterfaceAllocator allocator, size_t size) {
+    assert(allocator.alloc != NULL);
+    return allocator.alloc(allocator.context, size);
+}
+
+static inline void gci_allocator_free(struct GciInterfaceAllocator allocator, void *memory, size_t size) {
+    assert(allocator.free != NULL);
+    if (memory == NULL) { return; }
+    allocator.free(allocator.context, memory, size);
+}
+
+// Resizes memory with the `resize` function of the allocator, if it has none
+// new memory is allocated and the old contents copied over.
+static inline void *gci_allocator_resize(struct GciInterfaceAllocator allocator, void *memory, size_t old_size, size_t new_size) {
+    if (memory == NULL) {
+        return gci_allocator_alloc(allocator, new_size);
+    }
+    if (allocator.resize != NULL) {
+        return allocator.resize(allocator.context, memory, old_size, new_size);
+    }
+
+    void *new_memory = gci_allocator_alloc(allocator, new_size);
+    if (new_memory == NULL) { return NULL; }
+
+    memcpy(new_memory, memory, old_size < new_size ? old_size : new_size);
+    gci_allocator_free(allocator, memory, old_size);
+    return new_memory;
+}
+
+#endif
@@ -3,14 +3,46 @@
 #include <assert.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 typedef size_t (GciRead)(void const *context, char *buffer, size_t buffer_size);
 typedef bool (GciEof)(void const *context);
+typedef size_t (GciPeek)(void const *context, char const **data);
+typedef void (GciConsume)(void const *context, size_t amount);
+typedef size_t (GciReadAt)(void const *context, char *buffer, size_t buffer_size, uint64_t offset);
 
+// A reader interface, a valid reader will have some optional context
+// (in `context`) and non-null `read` and `eof` functions.
+//
+// The `peek` and `consume` functions are optional and either both or neither
+// are set. A reader which implements them lets callers borrow the bytes
+// it has available instead of copying them into a caller buffer.
+//
+// The peek function must satisfy the following contract:
+//
+// Params:
+//  context:    The `context` in this struct.
+//  data:       Set to point at the available bytes, valid until the next
+//              call to `read` or `peek` of the reader.
+//
+// Returns:
+//  The amount of bytes available in `data`, zero on eof or if an error occured.
+//
+// The consume function marks `amount` bytes of the last peek as read,
+// `amount` may not exceed what the last peek returned.
+//
+// The `read_at` function is optional, a reader which implements it can read
+// from any offset of its source without seeking. It reads up to `buffer_size`
+// bytes starting at `offset` and returns how many were read, a short read
+// means the source ended or an error occured. It neither uses nor changes
+// the position of `read` and may be called from several threads at once.
 struct GciInterfaceReader {
     void const *context;
     GciRead *read;
     GciEof *eof;
+    GciPeek *peek;
+    GciConsume *consume;
+    GciReadAt *read_at;
 };
 
 static inline size_t gci_reader_read(struct GciInterfaceReader reader, char *buffer, size_t buffer_size) {
@@ -23,4 +55,52 @@ static inline bool gci_reader_eof(struct GciInterfaceReader reader) {
     return reader.eof(reader.context);
 }
 
+// Borrows the bytes a reader has available without copying them. If the
+// reader does not implement `peek` the bytes are read into `scratch` instead,
+// such a view has already been taken from the reader and must be consumed
+// whole, so `scratch_size` should be no more than the caller will use.
+//
+// Params:
+//  reader:         A reader interface.
+//  data:           Set to point at the available bytes.
+//  scratch:        Fallback buffer, may be null if the reader implements `peek`.
+//  scratch_size:   The length of `scratch` in bytes.
+//
+// Returns:
+//  The amount of bytes available in `data`, zero on eof or if an error occured.
+static inline size_t gci_reader_peek(struct GciInterfaceReader reader, char const **data, char *scratch, size_t scratch_size) {
+    assert(data != NULL);
+    if (reader.peek == NULL) {
+        assert(scratch != NULL);
+        *data = scratch;
+        return gci_reader_read(reader, scratch, scratch_size);
+    }
+    return reader.peek(reader.context, data);
+}
+
+// Marks bytes of a view returned by `gci_reader_peek` as read.
+//
+// Params:
+//  reader:     A reader interface.
+//  peeked:     The amount of bytes the last `gci_reader_peek` returned.
+//  amount:     The amount of bytes to mark as read, at most `peeked`. If the
+//              reader does not implement `consume` it must equal `peeked`.
+static inline void gci_reader_consume(struct GciInterfaceReader reader, size_t peeked, size_t amount) {
+    (void) peeked;
+    assert(amount <= peeked);
+    if (reader.consume == NULL) {
+        assert(amount == peeked);
+        return;
+    }
+    reader.consume(reader.context, amount);
+}
+
+// Reads `buffer_size` bytes starting at `offset` of the source, the reader
+// must implement `read_at`. Returns the amount of bytes read, a short read
+// means the source ended or an error occured.
+static inline size_t gci_reader_read_at(struct GciInterfaceReader reader, char *buffer, size_t buffer_size, uint64_t offset) {
+    assert(reader.read_at != NULL);
+    return reader.read_at(reader.context, buffer, buffer_size, offset);
+}
+
 #endif
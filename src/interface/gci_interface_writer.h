@@ -4,6 +4,16 @@
 #include <stddef.h>
 
 typedef size_t (GciWrite)(void const *context, char const *data, size_t data_size);
+typedef char *(GciReserve)(void const *context, size_t size);
+typedef size_t (GciCommit)(void const *context, size_t size);
+
+// A single piece of data in a vectored write.
+struct GciIovec {
+    char const *data;
+    size_t data_size;
+};
+
+typedef size_t (GciWritev)(void const *context, struct GciIovec const *vectors, size_t vector_count);
 
 // A writer interface, a valid writer will have some optional context
 // (in `context`) and a non-null `write` function.
@@ -17,9 +27,33 @@ typedef size_t (GciWrite)(void const *context, char const *data, size_t data_siz
 //
 // Returns:
 //  The amount of characters written, less than `data_size` if an error occured.
+//
+// The `reserve` and `commit` functions are optional and either both or neither
+// are set. They let a producer format bytes directly into memory owned by
+// the writer instead of copying them from a buffer of its own.
+//
+// The reserve function must satisfy the following contract:
+//
+// Params:
+//  context:    The `context` in this struct.
+//  size:       The amount of bytes needed.
+//
+// Returns:
+//  Pointer to at least `size` writable bytes, null if they cannot be provided.
+//
+// The commit function writes the first `size` bytes of the last reservation
+// and returns the amount of characters written, less than `size` if an
+// error occured.
+//
+// The writev function is optional, it writes the pieces in `vectors` in order
+// as if they were concatenated and returns the total amount of characters
+// written, less than the summed `data_size` of all pieces if an error occured.
 struct GciInterfaceWriter {
     void const *context;
     GciWrite *write;
+    GciReserve *reserve;
+    GciCommit *commit;
+    GciWritev *writev;
 };
 
 // Calls the associated write function of a writer.
@@ -36,4 +70,74 @@ static inline size_t gci_writer_write(struct GciInterfaceWriter writer, char con
     return writer.write(writer.context, data, data_size);
 }
 
+// Writes several pieces of data as if they were concatenated. If the writer
+// does not implement `writev` each piece is written with `gci_writer_write`.
+//
+// Params:
+//  writer:         A writer interface.
+//  vectors:        The pieces to write, in order.
+//  vector_count:   The amount of items in `vectors`.
+//
+// Returns:
+//  The amount of characters written, less than the sum of the sizes of all
+//  pieces if an error occured.
+static inline size_t gci_writer_writev(struct GciInterfaceWriter writer, struct GciIovec const *vectors, size_t vector_count) {
+    assert(vectors != NULL || vector_count == 0);
+    if (writer.writev != NULL) {
+        return writer.writev(writer.context, vectors, vector_count);
+    }
+
+    size_t total = 0;
+    for (size_t index = 0; index < vector_count; index++) {
+        size_t result = gci_writer_write(writer, vectors[index].data, vectors[index].data_size);
+        total += result;
+        if (result < vectors[index].data_size) { break; }
+    }
+    return total;
+}
+
+// Reserves memory to format bytes into before writing them with
+// `gci_writer_commit`. If the writer does not implement `reserve`, or cannot
+// provide `size` bytes, `scratch` is returned instead and the bytes will be
+// written on commit.
+//
+// Params:
+//  writer:         A writer interface.
+//  size:           The amount of bytes needed.
+//  scratch:        Fallback buffer, may be null.
+//  scratch_size:   The length of `scratch` in bytes.
+//
+// Returns:
+//  Pointer to at least `size` writable bytes, null if neither the writer nor
+//  `scratch` can hold `size` bytes.
+static inline char *gci_writer_reserve(struct GciInterfaceWriter writer, size_t size, char *scratch, size_t scratch_size) {
+    char *reserved = NULL;
+    if (writer.reserve != NULL) {
+        reserved = writer.reserve(writer.context, size);
+    }
+    if (reserved == NULL && scratch != NULL && size <= scratch_size) {
+        reserved = scratch;
+    }
+    return reserved;
+}
+
+// Writes the first `size` bytes of a reservation made by `gci_writer_reserve`.
+//
+// Params:
+//  writer:     A writer interface.
+//  reserved:   The pointer returned by `gci_writer_reserve`.
+//  size:       The amount of bytes to write, at most the reserved amount.
+//  scratch:    The same `scratch` passed to `gci_writer_reserve`.
+//
+// Returns:
+//  The amount of characters written, less than `size` if an error occured.
+static inline size_t gci_writer_commit(struct GciInterfaceWriter writer, char const *reserved, size_t size, char const *scratch) {
+    assert(reserved != NULL);
+    if (reserved == scratch) {
+        return gci_writer_write(writer, scratch, size);
+    }
+    assert(writer.commit != NULL);
+    return writer.commit(writer.context, size);
+}
+
 #endif
@@ -1,9 +1,29 @@
+const builtin = @import("builtin");
+
 pub const lib = @cImport({
     @cInclude("gci_common.h");
+    @cInclude("gci_interface_allocator.h");
+    @cInclude("gci_allocator.h");
     @cInclude("gci_interface_reader.h");
     @cInclude("gci_reader.h");
     @cInclude("gci_interface_writer.h");
     @cInclude("gci_writer.h");
+    @cInclude("gci_fd.h");
+    @cInclude("gci_async.h");
+    @cInclude("gci_shared.h");
+    if (builtin.os.tag == .linux) {
+        @cInclude("gci_uring.h");
+    }
+    @cInclude("gci_copy.h");
+    @cInclude("gci_stats.h");
+    @cInclude("gci_simd.h");
+    @cInclude("gci_checksum.h");
+    @cInclude("gci_compress.h");
+    @cInclude("gci_cache.h");
+    @cInclude("gci_format.h");
+    @cInclude("gci_pool.h");
+    @cInclude("gci_direct.h");
+    @cInclude("gci_encode.h");
 });
 
 pub fn enumToError(err: lib.GciError) !void {
@@ -11,6 +31,7 @@ pub fn enumToError(err: lib.GciError) !void {
         lib.GCI_ERROR_OK => return,
         lib.GCI_ERROR_NULL => return error.Null,
         lib.GCI_ERROR_BUFFER => return error.Buffer,
+        lib.GCI_ERROR_IO => return error.Io,
         else => return error.Unknown,
     }
 }